@@ -0,0 +1,204 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <unordered_map>
+#include <nstl/flat_map.hpp>
+#include <nstl/hash_map.hpp>
+#include <nstl/vector.hpp>
+
+// Lookup tables keyed by 64-bit ids, from 16 entries up to 100k. Lookups probe
+// present keys in a random order, so the node-based maps pay a cache miss per
+// level while flat_map searches one contiguous key array.
+
+namespace {
+
+struct Table {
+    nstl::vector<uint64_t> keys;
+    nstl::vector<uint64_t> probes;
+};
+
+Table make_table(size_t n) {
+    std::mt19937_64 rng(n);
+    Table t;
+    for (size_t i = 0; i < n; ++i) t.keys.push_back(rng());
+    constexpr size_t probe_count = 4096;
+    for (size_t i = 0; i < probe_count; ++i) t.probes.push_back(t.keys[rng() % n]);
+    return t;
+}
+
+void table_sizes(benchmark::internal::Benchmark* b) {
+    for (int64_t n : {16, 64, 256, 1024, 8192, 100000}) b->Arg(n);
+}
+
+template<typename Map>
+Map fill(const Table& t) {
+    Map map;
+    for (uint64_t key : t.keys) map.emplace(key, key ^ 0x5555);
+    return map;
+}
+
+template<>
+nstl::flat_map<uint64_t, uint64_t> fill(const Table& t) {
+    nstl::vector<uint64_t> keys = t.keys;
+    nstl::vector<uint64_t> values;
+    for (uint64_t key : t.keys) values.push_back(key ^ 0x5555);
+    return nstl::flat_map<uint64_t, uint64_t>(std::move(keys), std::move(values));
+}
+
+template<typename Map>
+void lookup(benchmark::State& state) {
+    Table t = make_table(static_cast<size_t>(state.range(0)));
+    Map map = fill<Map>(t);
+    for (auto _ : state) {
+        uint64_t sum = 0;
+        for (uint64_t key : t.probes) sum += map.find(key)->second;
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(t.probes.size()));
+}
+
+template<typename Map>
+void iterate(benchmark::State& state) {
+    Table t = make_table(static_cast<size_t>(state.range(0)));
+    Map map = fill<Map>(t);
+    for (auto _ : state) {
+        uint64_t sum = 0;
+        for (const auto& [key, value] : map) sum += value;
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+}
+
+static void BM_StdMap_Lookup(benchmark::State& state) { lookup<std::map<uint64_t, uint64_t>>(state); }
+BENCHMARK(BM_StdMap_Lookup)->Apply(table_sizes);
+
+static void BM_StdUnorderedMap_Lookup(benchmark::State& state) { lookup<std::unordered_map<uint64_t, uint64_t>>(state); }
+BENCHMARK(BM_StdUnorderedMap_Lookup)->Apply(table_sizes);
+
+static void BM_FlatMap_Lookup(benchmark::State& state) { lookup<nstl::flat_map<uint64_t, uint64_t>>(state); }
+BENCHMARK(BM_FlatMap_Lookup)->Apply(table_sizes);
+
+static void BM_StdMap_Iterate(benchmark::State& state) { iterate<std::map<uint64_t, uint64_t>>(state); }
+BENCHMARK(BM_StdMap_Iterate)->Apply(table_sizes);
+
+static void BM_StdUnorderedMap_Iterate(benchmark::State& state) { iterate<std::unordered_map<uint64_t, uint64_t>>(state); }
+BENCHMARK(BM_StdUnorderedMap_Iterate)->Apply(table_sizes);
+
+static void BM_FlatMap_Iterate(benchmark::State& state) { iterate<nstl::flat_map<uint64_t, uint64_t>>(state); }
+BENCHMARK(BM_FlatMap_Iterate)->Apply(table_sizes);
+
+// Building from unsorted input: one sort of the whole batch versus a node per insert.
+static void BM_StdMap_Build(benchmark::State& state) {
+    Table t = make_table(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        auto map = fill<std::map<uint64_t, uint64_t>>(t);
+        benchmark::DoNotOptimize(map.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_StdMap_Build)->Apply(table_sizes);
+
+static void BM_FlatMap_Build(benchmark::State& state) {
+    Table t = make_table(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        auto map = fill<nstl::flat_map<uint64_t, uint64_t>>(t);
+        benchmark::DoNotOptimize(map.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_FlatMap_Build)->Apply(table_sizes);
+
+// Order-id index: std::unordered_map against nstl::hash_map at 1k, 64k and 1M ids.
+// Misses probe ids that were never inserted; churn erases one id and inserts a new
+// one per step at a constant size.
+
+namespace {
+
+using StdIndex = std::unordered_map<uint64_t, uint64_t>;
+using NstlIndex = nstl::hash_map<uint64_t, uint64_t>;
+
+void index_sizes(benchmark::internal::Benchmark* b) {
+    for (int64_t n : {1 << 10, 1 << 16, 1 << 20}) b->Arg(n);
+}
+
+nstl::vector<uint64_t> random_ids(size_t n, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    nstl::vector<uint64_t> ids;
+    for (size_t i = 0; i < n; ++i) ids.push_back(rng());
+    return ids;
+}
+
+template<typename Map>
+void index_insert(benchmark::State& state) {
+    nstl::vector<uint64_t> ids = random_ids(static_cast<size_t>(state.range(0)), 1);
+    for (auto _ : state) {
+        Map map;
+        map.reserve(ids.size());
+        for (uint64_t id : ids) map.emplace(id, id);
+        benchmark::DoNotOptimize(map.size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template<typename Map>
+void index_find(benchmark::State& state, bool hit) {
+    nstl::vector<uint64_t> ids = random_ids(static_cast<size_t>(state.range(0)), 1);
+    nstl::vector<uint64_t> probes = hit ? ids : random_ids(ids.size(), 2);
+    std::shuffle(probes.begin(), probes.end(), std::mt19937_64(3));
+    Map map;
+    for (uint64_t id : ids) map.emplace(id, id);
+    for (auto _ : state) {
+        uint64_t found = 0;
+        for (uint64_t id : probes) found += map.find(id) != map.end();
+        benchmark::DoNotOptimize(found);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template<typename Map>
+void index_churn(benchmark::State& state) {
+    size_t n = static_cast<size_t>(state.range(0));
+    nstl::vector<uint64_t> ids = random_ids(n * 9, 1);
+    Map map;
+    for (size_t i = 0; i < n; ++i) map.emplace(ids[i], ids[i]);
+    size_t oldest = 0, next = n;
+    for (auto _ : state) {
+        for (size_t k = 0; k < 1024; ++k) {
+            map.erase(ids[oldest]);
+            map.emplace(ids[next], ids[next]);
+            oldest = oldest + 1 == ids.size() ? 0 : oldest + 1;
+            next = next + 1 == ids.size() ? 0 : next + 1;
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * 1024);
+}
+
+}
+
+static void BM_StdUnorderedMap_Insert(benchmark::State& state) { index_insert<StdIndex>(state); }
+BENCHMARK(BM_StdUnorderedMap_Insert)->Apply(index_sizes);
+
+static void BM_HashMap_Insert(benchmark::State& state) { index_insert<NstlIndex>(state); }
+BENCHMARK(BM_HashMap_Insert)->Apply(index_sizes);
+
+static void BM_StdUnorderedMap_FindHit(benchmark::State& state) { index_find<StdIndex>(state, true); }
+BENCHMARK(BM_StdUnorderedMap_FindHit)->Apply(index_sizes);
+
+static void BM_HashMap_FindHit(benchmark::State& state) { index_find<NstlIndex>(state, true); }
+BENCHMARK(BM_HashMap_FindHit)->Apply(index_sizes);
+
+static void BM_StdUnorderedMap_FindMiss(benchmark::State& state) { index_find<StdIndex>(state, false); }
+BENCHMARK(BM_StdUnorderedMap_FindMiss)->Apply(index_sizes);
+
+static void BM_HashMap_FindMiss(benchmark::State& state) { index_find<NstlIndex>(state, false); }
+BENCHMARK(BM_HashMap_FindMiss)->Apply(index_sizes);
+
+static void BM_StdUnorderedMap_EraseChurn(benchmark::State& state) { index_churn<StdIndex>(state); }
+BENCHMARK(BM_StdUnorderedMap_EraseChurn)->Apply(index_sizes);
+
+static void BM_HashMap_EraseChurn(benchmark::State& state) { index_churn<NstlIndex>(state); }
+BENCHMARK(BM_HashMap_EraseChurn)->Apply(index_sizes);
@@ -0,0 +1,169 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <nstl/vector.hpp>
+#include <nstl/concurrent_vector.hpp>
+#include <nstl/spsc_ring.hpp>
+#include <nstl/mpmc_queue.hpp>
+#include <vector>
+
+// Multi-producer capture: every thread appends one event per iteration into a
+// shared buffer. Baseline is nstl::vector behind a mutex.
+
+namespace {
+
+struct Event {
+    uint64_t timestamp;
+    uint32_t producer;
+    uint32_t kind;
+};
+
+constexpr int events_per_thread = 1 << 16;
+
+struct LockedLog {
+    std::mutex mutex;
+    nstl::vector<Event> events;
+};
+
+std::unique_ptr<LockedLog> locked_log;
+std::unique_ptr<nstl::concurrent_vector<Event>> concurrent_log;
+
+}
+
+static void BM_MutexVector_Append(benchmark::State& state) {
+    if (state.thread_index() == 0) locked_log = std::make_unique<LockedLog>();
+    uint64_t t = 0;
+    for (auto _ : state) {
+        std::lock_guard<std::mutex> lock(locked_log->mutex);
+        locked_log->events.push_back({t++, uint32_t(state.thread_index()), 0});
+    }
+    if (state.thread_index() == 0) {
+        state.SetItemsProcessed(locked_log->events.size());
+        locked_log.reset();
+    }
+}
+BENCHMARK(BM_MutexVector_Append)->Iterations(events_per_thread)->ThreadRange(1, 16)->UseRealTime();
+
+static void BM_ConcurrentVector_Append(benchmark::State& state) {
+    if (state.thread_index() == 0) concurrent_log = std::make_unique<nstl::concurrent_vector<Event>>();
+    uint64_t t = 0;
+    for (auto _ : state) {
+        concurrent_log->push_back({t++, uint32_t(state.thread_index()), 0});
+    }
+    if (state.thread_index() == 0) {
+        state.SetItemsProcessed(concurrent_log->size());
+        concurrent_log.reset();
+    }
+}
+BENCHMARK(BM_ConcurrentVector_Append)->Iterations(events_per_thread)->ThreadRange(1, 16)->UseRealTime();
+
+// spsc_ring round trip: the benchmark thread sends a value to an echo thread on
+// one ring and waits for it to come back on another. Time per iteration is one
+// cross-thread round trip. Waiting sides yield so that the benchmark also makes
+// progress when both threads share a core.
+static void BM_SpscRing_PingPong(benchmark::State& state) {
+    auto ping = std::make_unique<nstl::spsc_ring<uint64_t, 1024>>();
+    auto pong = std::make_unique<nstl::spsc_ring<uint64_t, 1024>>();
+    std::atomic<bool> stop{false};
+
+    std::thread echo([&] {
+        uint64_t v;
+        while (!stop.load(std::memory_order_relaxed)) {
+            if (ping->try_pop(v)) {
+                while (!pong->try_push(v)) std::this_thread::yield();
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    uint64_t sent = 0, received;
+    for (auto _ : state) {
+        while (!ping->try_push(sent)) std::this_thread::yield();
+        while (!pong->try_pop(received)) std::this_thread::yield();
+        benchmark::DoNotOptimize(received);
+        sent++;
+    }
+    stop = true;
+    echo.join();
+}
+BENCHMARK(BM_SpscRing_PingPong)->UseRealTime();
+
+// Streaming throughput: a producer thread pushes events in batches of
+// state.range(0) (1 = the single-element path) while the benchmark thread drains.
+static void BM_SpscRing_Stream(benchmark::State& state) {
+    constexpr size_t items = 1 << 20;
+    const size_t batch = state.range(0);
+    auto ring = std::make_unique<nstl::spsc_ring<Event, 4096>>();
+
+    for (auto _ : state) {
+        std::thread producer([&] {
+            Event out[256];
+            for (size_t next = 0; next < items;) {
+                size_t n = std::min(batch, items - next);
+                for (size_t i = 0; i < n; ++i) out[i] = {next + i, 0, 0};
+                size_t pushed = batch == 1 ? size_t(ring->try_push(out[0]))
+                                           : ring->try_push(nstl::span<const Event>(out, n));
+                next += pushed;
+                if (pushed == 0) std::this_thread::yield();
+            }
+        });
+
+        Event in[256];
+        uint64_t sum = 0;
+        for (size_t received = 0; received < items;) {
+            size_t popped = batch == 1 ? size_t(ring->try_pop(in[0]))
+                                       : ring->try_pop(nstl::span<Event>(in, batch));
+            for (size_t i = 0; i < popped; ++i) sum += in[i].timestamp;
+            received += popped;
+            if (popped == 0) std::this_thread::yield();
+        }
+        producer.join();
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * items);
+}
+BENCHMARK(BM_SpscRing_Stream)->Arg(1)->Arg(16)->Arg(256)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// mpmc_queue fan-out with state.range(0) producers and state.range(1) consumers,
+// scaled independently to find where contention on the two position counters
+// starts to dominate. Producers and consumers use the blocking push/pop.
+static void BM_MpmcQueue_FanOut(benchmark::State& state) {
+    constexpr size_t items = 1 << 18;
+    const int producers = state.range(0);
+    const int consumers = state.range(1);
+    auto queue = std::make_unique<nstl::mpmc_queue<Event, 1024>>();
+
+    for (auto _ : state) {
+        std::atomic<size_t> claimed{0};
+        std::vector<std::thread> threads;
+        for (int p = 0; p < producers; ++p) {
+            threads.emplace_back([&, p] {
+                size_t share = items / producers + (size_t(p) < items % producers);
+                for (size_t i = 0; i < share; ++i) queue->push(Event{i, uint32_t(p), 0});
+            });
+        }
+        for (int c = 0; c < consumers; ++c) {
+            threads.emplace_back([&] {
+                Event e;
+                uint64_t sum = 0;
+                while (claimed.fetch_add(1, std::memory_order_relaxed) < items) {
+                    queue->pop(e);
+                    sum += e.timestamp;
+                }
+                benchmark::DoNotOptimize(sum);
+            });
+        }
+        for (auto& t : threads) t.join();
+    }
+    state.SetItemsProcessed(state.iterations() * items);
+}
+BENCHMARK(BM_MpmcQueue_FanOut)
+    ->ArgsProduct({{1, 2, 4, 8, 16}, {1, 2, 4, 8, 16}})
+    ->ArgNames({"producers", "consumers"})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
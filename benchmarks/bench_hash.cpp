@@ -0,0 +1,87 @@
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <nstl/hash.hpp>
+#include <nstl/span.hpp>
+
+// Hash throughput against key length: nstl::hash_bytes next to
+// std::hash<std::string_view> on the same bytes. Short keys hash 256 distinct
+// keys per iteration so the result depends on the data, not just the length.
+
+namespace {
+
+const std::string& key_bytes() {
+    static const std::string bytes = [] {
+        std::string s(size_t(1) << 20, '\0');
+        uint64_t x = 88172645463325252ull;
+        for (char& c : s) {
+            x ^= x << 13;
+            x ^= x >> 7;
+            x ^= x << 17;
+            c = static_cast<char>(x);
+        }
+        return s;
+    }();
+    return bytes;
+}
+
+constexpr size_t keys_per_iteration = 256;
+
+void key_lengths(benchmark::internal::Benchmark* b) {
+    for (int64_t len : {4, 8, 16, 24, 32, 64, 128, 256, 1024, 4096, 65536}) b->Arg(len);
+}
+
+void report(benchmark::State& state, size_t len) {
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(keys_per_iteration * len));
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(keys_per_iteration));
+}
+
+}
+
+static void BM_StdHash_StringView(benchmark::State& state) {
+    size_t len = static_cast<size_t>(state.range(0));
+    const std::string& bytes = key_bytes();
+    std::hash<std::string_view> hasher;
+    for (auto _ : state) {
+        uint64_t acc = 0;
+        for (size_t k = 0; k < keys_per_iteration; ++k) acc ^= hasher(std::string_view(bytes.data() + k * 3, len));
+        benchmark::DoNotOptimize(acc);
+    }
+    report(state, len);
+}
+BENCHMARK(BM_StdHash_StringView)->Apply(key_lengths);
+
+static void BM_HashBytes(benchmark::State& state) {
+    size_t len = static_cast<size_t>(state.range(0));
+    const std::string& bytes = key_bytes();
+    const auto* base = reinterpret_cast<const std::byte*>(bytes.data());
+    for (auto _ : state) {
+        uint64_t acc = 0;
+        for (size_t k = 0; k < keys_per_iteration; ++k) acc ^= nstl::hash_bytes(nstl::span<const std::byte>(base + k * 3, len));
+        benchmark::DoNotOptimize(acc);
+    }
+    report(state, len);
+}
+BENCHMARK(BM_HashBytes)->Apply(key_lengths);
+
+// Fixed-extent spans, e.g. an order id or a message header of known size.
+template<size_t Len>
+static void BM_HashBytes_Fixed(benchmark::State& state) {
+    const std::string& bytes = key_bytes();
+    const auto* base = reinterpret_cast<const std::byte*>(bytes.data());
+    for (auto _ : state) {
+        uint64_t acc = 0;
+        for (size_t k = 0; k < keys_per_iteration; ++k) acc ^= nstl::hash_bytes(nstl::span<const std::byte, Len>(base + k * 3));
+        benchmark::DoNotOptimize(acc);
+    }
+    report(state, Len);
+}
+BENCHMARK(BM_HashBytes_Fixed<4>);
+BENCHMARK(BM_HashBytes_Fixed<8>);
+BENCHMARK(BM_HashBytes_Fixed<16>);
+BENCHMARK(BM_HashBytes_Fixed<24>);
+BENCHMARK(BM_HashBytes_Fixed<32>);
+BENCHMARK(BM_HashBytes_Fixed<64>);
@@ -0,0 +1,172 @@
+#include <benchmark/benchmark.h>
+
+#if defined(__linux__)
+
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <nstl/vector.hpp>
+#include <nstl/mmap_vector.hpp>
+#include <nstl/snapshot.hpp>
+
+// Loading a stored market-data series: parse it back from text into a vector,
+// or reopen an mmap_vector and read it in place. Both sum every price so the
+// mapped pages are really touched.
+
+namespace {
+
+struct Tick {
+    uint64_t time;
+    double price;
+};
+
+std::string bench_path(const char* name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+Tick make_tick(uint64_t i) {
+    return {i, 100.0 + static_cast<double>(i % 1000) / 8};
+}
+
+}
+
+static void BM_TextFile_Load(benchmark::State& state) {
+    std::string path = bench_path("nstl_bench_ticks.txt");
+    {
+        std::ofstream out(path);
+        for (int64_t i = 0; i < state.range(0); ++i) {
+            Tick t = make_tick(static_cast<uint64_t>(i));
+            out << t.time << ' ' << t.price << '\n';
+        }
+    }
+    for (auto _ : state) {
+        std::ifstream in(path);
+        nstl::vector<Tick> ticks;
+        Tick t;
+        while (in >> t.time >> t.price) ticks.push_back(t);
+        double sum = 0;
+        for (const Tick& tick : ticks) sum += tick.price;
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    std::filesystem::remove(path);
+}
+BENCHMARK(BM_TextFile_Load)->Arg(1 << 16)->Arg(1 << 20);
+
+static void BM_MmapVector_Reopen(benchmark::State& state) {
+    std::string path = bench_path("nstl_bench_ticks.bin");
+    std::filesystem::remove(path);
+    {
+        nstl::mmap_vector<Tick> out(path);
+        out.reserve(static_cast<size_t>(state.range(0)));
+        for (int64_t i = 0; i < state.range(0); ++i) out.push_back(make_tick(static_cast<uint64_t>(i)));
+    }
+    for (auto _ : state) {
+        nstl::mmap_vector<Tick> in(path, nstl::open_mode::read_only);
+        double sum = 0;
+        for (const Tick& tick : in.view()) sum += tick.price;
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    std::filesystem::remove(path);
+}
+BENCHMARK(BM_MmapVector_Reopen)->Arg(1 << 16)->Arg(1 << 20);
+
+static void BM_MmapVector_PushBack(benchmark::State& state) {
+    std::string path = bench_path("nstl_bench_append.bin");
+    for (auto _ : state) {
+        std::filesystem::remove(path);
+        nstl::mmap_vector<Tick> out(path);
+        for (int64_t i = 0; i < state.range(0); ++i) out.push_back(make_tick(static_cast<uint64_t>(i)));
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    std::filesystem::remove(path);
+}
+BENCHMARK(BM_MmapVector_PushBack)->Arg(1 << 16)->Arg(1 << 20);
+
+// Checkpointing: snapshot save/load against the per-element fwrite/fread loop it
+// replaces. Throughput is reported in bytes so the rows compare across sizes.
+
+namespace {
+
+nstl::vector<Tick> make_ticks(int64_t n) {
+    nstl::vector<Tick> ticks;
+    ticks.reserve(static_cast<size_t>(n));
+    for (int64_t i = 0; i < n; ++i) ticks.push_back(make_tick(static_cast<uint64_t>(i)));
+    return ticks;
+}
+
+}
+
+static void BM_PerElement_Save(benchmark::State& state) {
+    std::string path = bench_path("nstl_bench_fwrite.bin");
+    nstl::vector<Tick> ticks = make_ticks(state.range(0));
+    for (auto _ : state) {
+        std::FILE* f = std::fopen(path.c_str(), "wb");
+        uint64_t count = ticks.size();
+        std::fwrite(&count, sizeof count, 1, f);
+        for (const Tick& t : ticks) std::fwrite(&t, sizeof t, 1, f);
+        std::fclose(f);
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<int64_t>(sizeof(Tick)));
+    std::filesystem::remove(path);
+}
+BENCHMARK(BM_PerElement_Save)->Arg(1 << 14)->Arg(1 << 18)->Arg(1 << 22);
+
+static void BM_Snapshot_Save(benchmark::State& state) {
+    std::string path = bench_path("nstl_bench_snapshot.snap");
+    nstl::vector<Tick> ticks = make_ticks(state.range(0));
+    for (auto _ : state) {
+        nstl::save_snapshot<Tick>(path, ticks);
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<int64_t>(sizeof(Tick)));
+    std::filesystem::remove(path);
+}
+BENCHMARK(BM_Snapshot_Save)->Arg(1 << 14)->Arg(1 << 18)->Arg(1 << 22);
+
+static void BM_PerElement_Load(benchmark::State& state) {
+    std::string path = bench_path("nstl_bench_fread.bin");
+    {
+        nstl::vector<Tick> ticks = make_ticks(state.range(0));
+        std::FILE* f = std::fopen(path.c_str(), "wb");
+        uint64_t count = ticks.size();
+        std::fwrite(&count, sizeof count, 1, f);
+        for (const Tick& t : ticks) std::fwrite(&t, sizeof t, 1, f);
+        std::fclose(f);
+    }
+    for (auto _ : state) {
+        std::FILE* f = std::fopen(path.c_str(), "rb");
+        uint64_t count = 0;
+        if (std::fread(&count, sizeof count, 1, f) != 1) state.SkipWithError("short read");
+        nstl::vector<Tick> ticks;
+        ticks.reserve(count);
+        Tick t;
+        while (std::fread(&t, sizeof t, 1, f) == 1) ticks.push_back(t);
+        std::fclose(f);
+        benchmark::DoNotOptimize(ticks.data());
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<int64_t>(sizeof(Tick)));
+    std::filesystem::remove(path);
+}
+BENCHMARK(BM_PerElement_Load)->Arg(1 << 14)->Arg(1 << 18)->Arg(1 << 22);
+
+// Arg 1 selects the loader: 0 = mmap, 1 = read into an aligned buffer. Both verify
+// the checksum, which touches every byte.
+static void BM_Snapshot_Load(benchmark::State& state) {
+    std::string path = bench_path("nstl_bench_load.snap");
+    nstl::vector<Tick> ticks = make_ticks(state.range(0));
+    nstl::save_snapshot<Tick>(path, ticks);
+    auto mode = state.range(1) == 0 ? nstl::snapshot_load::map : nstl::snapshot_load::read;
+    for (auto _ : state) {
+        nstl::snapshot<Tick> loaded = nstl::load_snapshot<Tick>(path, mode);
+        benchmark::DoNotOptimize(loaded.data());
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<int64_t>(sizeof(Tick)));
+    std::filesystem::remove(path);
+}
+BENCHMARK(BM_Snapshot_Load)->ArgsProduct({{1 << 14, 1 << 18, 1 << 22}, {0, 1}});
+
+#endif
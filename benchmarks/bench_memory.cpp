@@ -0,0 +1,156 @@
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <nstl/memory_resource.hpp>
+#include <nstl/unique_ptr.hpp>
+#include <nstl/vector.hpp>
+
+// One "event" allocates 64 blocks of 16 to 256 bytes, touches them and then
+// frees all of them. The arena frees by rewinding; the others free block by block.
+
+namespace {
+
+constexpr size_t blocks_per_event = 64;
+
+size_t block_size(size_t i) { return size_t(16) << (i % 5); }
+
+// Frees each block through the resource, or rewinds the arena at the end.
+template<typename Free>
+void run_events(benchmark::State& state, std::pmr::memory_resource* r, Free free_event) {
+    void* blocks[blocks_per_event];
+    for (auto _ : state) {
+        for (size_t i = 0; i < blocks_per_event; ++i) {
+            blocks[i] = r->allocate(block_size(i), 8);
+            static_cast<std::byte*>(blocks[i])[0] = std::byte{1};
+        }
+        benchmark::DoNotOptimize(blocks);
+        free_event(blocks);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(blocks_per_event));
+}
+
+void free_each(std::pmr::memory_resource* r, void** blocks) {
+    for (size_t i = 0; i < blocks_per_event; ++i) r->deallocate(blocks[i], block_size(i), 8);
+}
+
+struct Order {
+    uint64_t id;
+    uint64_t price;
+    uint32_t quantity;
+    uint32_t side;
+};
+
+}
+
+static void BM_NewDelete_Event(benchmark::State& state) {
+    auto* r = std::pmr::new_delete_resource();
+    run_events(state, r, [r](void** blocks) { free_each(r, blocks); });
+}
+BENCHMARK(BM_NewDelete_Event);
+
+static void BM_StdMonotonic_Event(benchmark::State& state) {
+    std::pmr::monotonic_buffer_resource r;
+    run_events(state, &r, [&r](void**) { r.release(); });
+}
+BENCHMARK(BM_StdMonotonic_Event);
+
+static void BM_Arena_Event(benchmark::State& state) {
+    nstl::monotonic_arena arena;
+    auto start = arena.mark();
+    run_events(state, &arena, [&](void**) { arena.rewind(start); });
+}
+BENCHMARK(BM_Arena_Event);
+
+static void BM_StdUnsyncPool_Event(benchmark::State& state) {
+    std::pmr::unsynchronized_pool_resource r;
+    run_events(state, &r, [&r](void** blocks) { free_each(&r, blocks); });
+}
+BENCHMARK(BM_StdUnsyncPool_Event);
+
+static void BM_Pool_Event(benchmark::State& state) {
+    nstl::pool_resource pool;
+    run_events(state, &pool, [&pool](void** blocks) { free_each(&pool, blocks); });
+}
+BENCHMARK(BM_Pool_Event);
+
+static void BM_StdSyncPool_Event(benchmark::State& state) {
+    std::pmr::synchronized_pool_resource r;
+    run_events(state, &r, [&r](void** blocks) { free_each(&r, blocks); });
+}
+BENCHMARK(BM_StdSyncPool_Event)->Threads(1)->Threads(2);
+
+static void BM_ThreadCache_Event(benchmark::State& state) {
+    static nstl::thread_cache_resource cache;
+    run_events(state, &cache, [](void** blocks) { free_each(&cache, blocks); });
+}
+BENCHMARK(BM_ThreadCache_Event)->Threads(1)->Threads(2);
+
+// Growing a vector of 1000 ids per event.
+template<typename Reset>
+static void grow_vector(benchmark::State& state, std::pmr::memory_resource* r, Reset reset) {
+    for (auto _ : state) {
+        {
+            nstl::pmr::vector<uint64_t> ids{std::pmr::polymorphic_allocator<uint64_t>(r)};
+            for (uint64_t i = 0; i < 1000; ++i) ids.push_back(i);
+            benchmark::DoNotOptimize(ids.data());
+        }
+        reset();
+    }
+    state.SetItemsProcessed(state.iterations() * 1000);
+}
+
+static void BM_PmrVector_NewDelete(benchmark::State& state) {
+    grow_vector(state, std::pmr::new_delete_resource(), [] {});
+}
+BENCHMARK(BM_PmrVector_NewDelete);
+
+static void BM_PmrVector_Arena(benchmark::State& state) {
+    nstl::monotonic_arena arena;
+    grow_vector(state, &arena, [&] { arena.release(); });
+}
+BENCHMARK(BM_PmrVector_Arena);
+
+// A single small object: make_unique against allocate_unique on each resource.
+static void BM_MakeUnique(benchmark::State& state) {
+    for (auto _ : state) {
+        auto order = nstl::make_unique<Order>(Order{1, 2, 3, 4});
+        benchmark::DoNotOptimize(order.get());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MakeUnique);
+
+static void BM_AllocateUnique(benchmark::State& state, nstl::memory_resource* r) {
+    for (auto _ : state) {
+        auto order = nstl::allocate_unique<Order>(r, Order{1, 2, 3, 4});
+        benchmark::DoNotOptimize(order.get());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_AllocateUnique_Pool(benchmark::State& state) {
+    nstl::pool_resource pool;
+    BM_AllocateUnique(state, &pool);
+}
+BENCHMARK(BM_AllocateUnique_Pool);
+
+static void BM_AllocateUnique_ThreadCache(benchmark::State& state) {
+    nstl::thread_cache_resource cache;
+    BM_AllocateUnique(state, &cache);
+}
+BENCHMARK(BM_AllocateUnique_ThreadCache);
+
+static void BM_AllocateUnique_Arena(benchmark::State& state) {
+    nstl::monotonic_arena arena;
+    auto start = arena.mark();
+    for (auto _ : state) {
+        {
+            auto order = nstl::allocate_unique<Order>(&arena, Order{1, 2, 3, 4});
+            benchmark::DoNotOptimize(order.get());
+        }
+        arena.rewind(start);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_AllocateUnique_Arena);
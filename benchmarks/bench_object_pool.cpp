@@ -0,0 +1,128 @@
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <nstl/object_pool.hpp>
+#include <nstl/unique_ptr.hpp>
+#include <nstl/vector.hpp>
+
+// Order objects through make_unique against object_pool::make_pooled. Churn keeps
+// a window of live orders and replaces the oldest each step. Cross-thread free times
+// only the freeing of a batch that was allocated on a different, long-lived thread.
+
+namespace {
+
+struct Order {
+    uint64_t id;
+    uint64_t price;
+    uint32_t quantity;
+    uint32_t side;
+};
+
+constexpr size_t window = 4096;
+constexpr size_t batch_size = 4096;
+
+nstl::object_pool<Order>& order_pool() {
+    static nstl::object_pool<Order> pool;
+    return pool;
+}
+
+struct MakeUnique {
+    using handle = nstl::unique_ptr<Order>;
+    handle operator()(uint64_t i) const { return nstl::make_unique<Order>(Order{i, i, 1, 0}); }
+};
+
+struct MakePooled {
+    using handle = nstl::pooled_ptr<Order>;
+    handle operator()(uint64_t i) const { return order_pool().make_pooled(Order{i, i, 1, 0}); }
+};
+
+template<typename Make>
+void churn(benchmark::State& state) {
+    Make make;
+    nstl::vector<typename Make::handle> live;
+    for (uint64_t i = 0; i < window; ++i) live.push_back(make(i));
+    uint64_t next = window;
+    for (auto _ : state) {
+        for (size_t k = 0; k < 1024; ++k, ++next) live[next % window] = make(next);
+        benchmark::DoNotOptimize(live.data());
+    }
+    state.SetItemsProcessed(state.iterations() * 1024);
+}
+
+// Fills a batch on its own thread whenever asked.
+template<typename Make>
+class producer {
+public:
+    producer() : _thread([this] { run(); }) {}
+    ~producer() {
+        _state.store(stop);
+        _thread.join();
+    }
+
+    nstl::vector<typename Make::handle>& fill() {
+        _state.store(requested);
+        while (_state.load() != ready) std::this_thread::yield();
+        return _batch;
+    }
+
+private:
+    enum : int { idle, requested, ready, stop };
+
+    void run() {
+        Make make;
+        for (;;) {
+            int s = _state.load();
+            if (s == stop) return;
+            if (s != requested) {
+                std::this_thread::yield();
+                continue;
+            }
+            for (uint64_t i = 0; i < batch_size; ++i) _batch.push_back(make(i));
+            _state.store(ready);
+        }
+    }
+
+    nstl::vector<typename Make::handle> _batch;
+    std::atomic<int> _state{idle};
+    std::thread _thread;
+};
+
+template<typename Make>
+void free_batch(benchmark::State& state, bool cross_thread) {
+    producer<Make> other;
+    Make make;
+    nstl::vector<typename Make::handle> local;
+    for (auto _ : state) {
+        state.PauseTiming();
+        nstl::vector<typename Make::handle>* batch = &local;
+        if (cross_thread) {
+            batch = &other.fill();
+        } else {
+            for (uint64_t i = 0; i < batch_size; ++i) local.push_back(make(i));
+        }
+        state.ResumeTiming();
+        batch->clear();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(batch_size));
+}
+
+}
+
+static void BM_MakeUnique_Churn(benchmark::State& state) { churn<MakeUnique>(state); }
+BENCHMARK(BM_MakeUnique_Churn)->Threads(1)->Threads(2);
+
+static void BM_MakePooled_Churn(benchmark::State& state) { churn<MakePooled>(state); }
+BENCHMARK(BM_MakePooled_Churn)->Threads(1)->Threads(2);
+
+static void BM_MakeUnique_FreeSameThread(benchmark::State& state) { free_batch<MakeUnique>(state, false); }
+BENCHMARK(BM_MakeUnique_FreeSameThread);
+
+static void BM_MakeUnique_FreeCrossThread(benchmark::State& state) { free_batch<MakeUnique>(state, true); }
+BENCHMARK(BM_MakeUnique_FreeCrossThread);
+
+static void BM_MakePooled_FreeSameThread(benchmark::State& state) { free_batch<MakePooled>(state, false); }
+BENCHMARK(BM_MakePooled_FreeSameThread);
+
+static void BM_MakePooled_FreeCrossThread(benchmark::State& state) { free_batch<MakePooled>(state, true); }
+BENCHMARK(BM_MakePooled_FreeCrossThread);
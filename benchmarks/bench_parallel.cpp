@@ -0,0 +1,99 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <thread>
+#include <nstl/parallel.hpp>
+#include <nstl/span.hpp>
+#include <nstl/vector.hpp>
+
+// Scaling of nstl::parallel over large spans. The argument is the pool size, from
+// 1 (the calling thread alone) up to every core; wall-clock time is reported.
+
+namespace {
+
+constexpr size_t big = 1 << 24;
+
+nstl::vector<float> random_floats(size_t n) {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+    nstl::vector<float> values;
+    values.reserve(n);
+    for (size_t i = 0; i < n; ++i) values.push_back(dist(rng));
+    return values;
+}
+
+void thread_counts(benchmark::internal::Benchmark* b) {
+    int cores = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    for (int threads = 1; threads < cores; threads *= 2) b->Arg(threads);
+    b->Arg(cores);
+    b->UseRealTime()->Unit(benchmark::kMillisecond);
+}
+
+}
+
+static void BM_Parallel_Reduce(benchmark::State& state) {
+    nstl::parallel::thread_pool pool(static_cast<size_t>(state.range(0)));
+    nstl::vector<float> values = random_floats(big);
+    for (auto _ : state) {
+        double sum = nstl::parallel::reduce(nstl::span<const float>(values), 0.0, {.pool = &pool});
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(big * sizeof(float)));
+}
+BENCHMARK(BM_Parallel_Reduce)->Apply(thread_counts);
+
+static void BM_Parallel_Transform(benchmark::State& state) {
+    nstl::parallel::thread_pool pool(static_cast<size_t>(state.range(0)));
+    nstl::vector<float> in = random_floats(big);
+    nstl::vector<float> out;
+    out.resize(big);
+    for (auto _ : state) {
+        nstl::parallel::transform(nstl::span<const float>(in), nstl::span<float>(out),
+                                  [](float x) { return x * x + 1.0f; }, {.pool = &pool});
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(2 * big * sizeof(float)));
+}
+BENCHMARK(BM_Parallel_Transform)->Apply(thread_counts);
+
+static void BM_Parallel_InclusiveScan(benchmark::State& state) {
+    nstl::parallel::thread_pool pool(static_cast<size_t>(state.range(0)));
+    nstl::vector<float> in = random_floats(big);
+    nstl::vector<float> out;
+    out.resize(big);
+    for (auto _ : state) {
+        nstl::parallel::inclusive_scan(nstl::span<const float>(in), nstl::span<float>(out), {.pool = &pool});
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(2 * big * sizeof(float)));
+}
+BENCHMARK(BM_Parallel_InclusiveScan)->Apply(thread_counts);
+
+static void BM_Parallel_Sort(benchmark::State& state) {
+    nstl::parallel::thread_pool pool(static_cast<size_t>(state.range(0)));
+    nstl::vector<float> source = random_floats(big / 4);
+    nstl::vector<float> values;
+    for (auto _ : state) {
+        state.PauseTiming();
+        values = source;
+        state.ResumeTiming();
+        nstl::parallel::sort(nstl::span<float>(values), {.pool = &pool});
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(big / 4));
+}
+BENCHMARK(BM_Parallel_Sort)->Apply(thread_counts);
+
+static void BM_StdSort(benchmark::State& state) {
+    nstl::vector<float> source = random_floats(big / 4);
+    nstl::vector<float> values;
+    for (auto _ : state) {
+        state.PauseTiming();
+        values = source;
+        state.ResumeTiming();
+        std::sort(values.begin(), values.end());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(big / 4));
+}
+BENCHMARK(BM_StdSort)->UseRealTime()->Unit(benchmark::kMillisecond);
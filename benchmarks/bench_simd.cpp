@@ -0,0 +1,162 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <nstl/simd.hpp>
+#include <nstl/span.hpp>
+#include <nstl/vector.hpp>
+
+// nstl::simd kernels against the std algorithm a caller would otherwise write.
+// Sizes are floats that fill L1 (16 KB), L2 (256 KB), L3 (8 MB) and DRAM (128 MB).
+// The simd rows take a second argument selecting the code path
+// (0 scalar, 1 SSE2, 2 AVX2, 3 AVX-512); paths this CPU lacks are skipped.
+
+namespace {
+
+nstl::vector<float> random_floats(size_t n) {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> dist(0.0f, 100.0f);
+    nstl::vector<float> values;
+    values.reserve(n);
+    for (size_t i = 0; i < n; ++i) values.push_back(dist(rng));
+    return values;
+}
+
+const nstl::vector<float>& shared_input(size_t n) {
+    static nstl::vector<float> values = random_floats(size_t(32) << 20);
+    (void)n;
+    return values;
+}
+
+constexpr int64_t sizes[] = {4 << 10, 64 << 10, 2 << 20, 32 << 20};
+
+void std_sizes(benchmark::internal::Benchmark* b) {
+    for (int64_t n : sizes) b->Arg(n);
+}
+
+void simd_sizes(benchmark::internal::Benchmark* b) {
+    for (int64_t n : sizes) {
+        for (int level = 0; level <= 3; ++level) b->Args({n, level});
+    }
+}
+
+const nstl::simd::kernel_table<float>* select(benchmark::State& state) {
+    auto level = static_cast<nstl::simd::isa>(state.range(1));
+    if (!nstl::simd::supported(level)) {
+        state.SkipWithError("instruction set not supported");
+        return nullptr;
+    }
+    return &nstl::simd::kernels<float>(level);
+}
+
+void report(benchmark::State& state, int streams = 1) {
+    state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<int64_t>(sizeof(float)) * streams);
+}
+
+}
+
+// Searching for a value that is absent scans the whole span.
+static void BM_StdFind(benchmark::State& state) {
+    const float* p = shared_input(state.range(0)).data();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::find(p, p + state.range(0), -1.0f));
+    }
+    report(state);
+}
+BENCHMARK(BM_StdFind)->Apply(std_sizes);
+
+static void BM_SimdFind(benchmark::State& state) {
+    const float* p = shared_input(state.range(0)).data();
+    auto* k = select(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(k->find(p, static_cast<size_t>(state.range(0)), -1.0f));
+    }
+    report(state);
+}
+BENCHMARK(BM_SimdFind)->Apply(simd_sizes);
+
+static void BM_StdAccumulate(benchmark::State& state) {
+    const float* p = shared_input(state.range(0)).data();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::accumulate(p, p + state.range(0), 0.0f));
+    }
+    report(state);
+}
+BENCHMARK(BM_StdAccumulate)->Apply(std_sizes);
+
+static void BM_SimdSum(benchmark::State& state) {
+    const float* p = shared_input(state.range(0)).data();
+    auto* k = select(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(k->sum(p, static_cast<size_t>(state.range(0))));
+    }
+    report(state);
+}
+BENCHMARK(BM_SimdSum)->Apply(simd_sizes);
+
+static void BM_StdMinElement(benchmark::State& state) {
+    const float* p = shared_input(state.range(0)).data();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::min_element(p, p + state.range(0)));
+    }
+    report(state);
+}
+BENCHMARK(BM_StdMinElement)->Apply(std_sizes);
+
+static void BM_SimdMin(benchmark::State& state) {
+    const float* p = shared_input(state.range(0)).data();
+    auto* k = select(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(k->min(p, static_cast<size_t>(state.range(0))));
+    }
+    report(state);
+}
+BENCHMARK(BM_SimdMin)->Apply(simd_sizes);
+
+static void BM_StdInnerProduct(benchmark::State& state) {
+    const float* p = shared_input(state.range(0)).data();
+    const float* q = p + (state.range(0) < (16 << 20) ? state.range(0) : 0);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::inner_product(p, p + state.range(0), q, 0.0f));
+    }
+    report(state, 2);
+}
+BENCHMARK(BM_StdInnerProduct)->Apply(std_sizes);
+
+static void BM_SimdDot(benchmark::State& state) {
+    const float* p = shared_input(state.range(0)).data();
+    const float* q = p + (state.range(0) < (16 << 20) ? state.range(0) : 0);
+    auto* k = select(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(k->dot(p, q, static_cast<size_t>(state.range(0))));
+    }
+    report(state, 2);
+}
+BENCHMARK(BM_SimdDot)->Apply(simd_sizes);
+
+// Threshold check: which prices are at or above 50.
+static void BM_LoopCompareMask(benchmark::State& state) {
+    const float* p = shared_input(state.range(0)).data();
+    nstl::vector<uint64_t> bits;
+    bits.resize(static_cast<size_t>(state.range(0) + 63) / 64);
+    for (auto _ : state) {
+        std::fill(bits.begin(), bits.end(), 0);
+        for (int64_t i = 0; i < state.range(0); ++i) bits[i / 64] |= uint64_t(p[i] >= 50.0f) << (i % 64);
+        benchmark::DoNotOptimize(bits.data());
+    }
+    report(state);
+}
+BENCHMARK(BM_LoopCompareMask)->Apply(std_sizes);
+
+static void BM_SimdCompareMask(benchmark::State& state) {
+    const float* p = shared_input(state.range(0)).data();
+    nstl::vector<uint64_t> bits;
+    bits.resize(static_cast<size_t>(state.range(0) + 63) / 64);
+    auto* k = select(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(k->compare_mask(p, static_cast<size_t>(state.range(0)), nstl::simd::cmp::ge, 50.0f, bits.data()));
+    }
+    report(state);
+}
+BENCHMARK(BM_SimdCompareMask)->Apply(simd_sizes);
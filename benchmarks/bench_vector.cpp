@@ -1,7 +1,18 @@
 #include <benchmark/benchmark.h>
 #include <vector>
 #include <nstl/vector.hpp>
+#include <nstl/small_vector.hpp>
+#include <nstl/unique_ptr.hpp>
+#include <nstl/allocator.hpp>
+#include <nstl/incremental_vector.hpp>
+#include <nstl/span.hpp>
+#include <nstl/soa_vector.hpp>
+#include <nstl/static_vector.hpp>
+#include <nstl/stable_vector.hpp>
 #include <random>
+#include <memory_resource>
+#include <chrono>
+#include <algorithm>
 
 // ---------------------------------------------------
 // Benchmark 1: STL push_back
@@ -44,6 +55,273 @@ static void BM_NstlVector_PushBack(benchmark::State& state) {
 }
 BENCHMARK(BM_NstlVector_PushBack)->Range(8, 8<<10);
 
+// ---------------------------------------------------
+// Benchmark 2b: NSTL push_back from a per-iteration arena
+// ---------------------------------------------------
+// The arena's buffer is allocated once up front and rewound after every
+// iteration, the way a per-tick arena would be, so the loop never reaches malloc.
+static void BM_NstlVector_PushBack_Arena(benchmark::State& state) {
+    std::vector<std::byte> buffer(1 << 20);
+    std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+    for (auto _ : state) {
+        {
+            nstl::pmr::vector<int> v(&arena);
+            for (int i = 0; i < state.range(0); ++i) {
+                v.push_back(i);
+            }
+        }
+        arena.release();
+    }
+}
+BENCHMARK(BM_NstlVector_PushBack_Arena)->Range(8, 8<<10);
+
+// ---------------------------------------------------
+// Benchmark 2c: NSTL push_back from a pool resource
+// ---------------------------------------------------
+static void BM_NstlVector_PushBack_Pool(benchmark::State& state) {
+    std::pmr::unsynchronized_pool_resource pool;
+    for (auto _ : state) {
+        nstl::pmr::vector<int> v(&pool);
+        for (int i = 0; i < state.range(0); ++i) {
+            v.push_back(i);
+        }
+    }
+}
+BENCHMARK(BM_NstlVector_PushBack_Pool)->Range(8, 8<<10);
+
+// ---------------------------------------------------
+// Benchmark 2d: NSTL small_vector push_back
+// ---------------------------------------------------
+// Up to 16 elements stay inline and never reach the allocator; past that it
+// behaves like nstl::vector.
+static void BM_NstlSmallVector_PushBack(benchmark::State& state) {
+    for (auto _ : state) {
+        nstl::small_vector<int, 16> v;
+        for (int i = 0; i < state.range(0); ++i) {
+            v.push_back(i);
+        }
+        benchmark::DoNotOptimize(v.data());
+    }
+}
+BENCHMARK(BM_NstlSmallVector_PushBack)->Arg(4)->Arg(8)->Arg(16)->Arg(64)->Arg(512);
+
+// ---------------------------------------------------
+// Benchmark 2e: Large push_back, copy-on-growth vs in-place growth
+// ---------------------------------------------------
+// Same loop as above at tick-capture sizes (64K to 64M ints). The default
+// allocator copies the whole buffer on every doubling; malloc_allocator and
+// page_allocator let the vector extend the block with realloc/mremap instead.
+static void BM_StdVector_PushBack_Large(benchmark::State& state) {
+    for (auto _ : state) {
+        std::vector<int> v;
+        for (int i = 0; i < state.range(0); ++i) {
+            v.push_back(i);
+        }
+        benchmark::DoNotOptimize(v.data());
+    }
+}
+BENCHMARK(BM_StdVector_PushBack_Large)->Range(64<<10, 64<<20)->Unit(benchmark::kMillisecond);
+
+static void BM_NstlVector_PushBack_Large(benchmark::State& state) {
+    for (auto _ : state) {
+        nstl::vector<int> v;
+        for (int i = 0; i < state.range(0); ++i) {
+            v.push_back(i);
+        }
+        benchmark::DoNotOptimize(v.data());
+    }
+}
+BENCHMARK(BM_NstlVector_PushBack_Large)->Range(64<<10, 64<<20)->Unit(benchmark::kMillisecond);
+
+static void BM_NstlVector_PushBack_Large_Realloc(benchmark::State& state) {
+    for (auto _ : state) {
+        nstl::vector<int, nstl::malloc_allocator<int>> v;
+        for (int i = 0; i < state.range(0); ++i) {
+            v.push_back(i);
+        }
+        benchmark::DoNotOptimize(v.data());
+    }
+}
+BENCHMARK(BM_NstlVector_PushBack_Large_Realloc)->Range(64<<10, 64<<20)->Unit(benchmark::kMillisecond);
+
+#if defined(__linux__)
+static void BM_NstlVector_PushBack_Large_Mremap(benchmark::State& state) {
+    for (auto _ : state) {
+        nstl::vector<int, nstl::page_allocator<int>> v;
+        for (int i = 0; i < state.range(0); ++i) {
+            v.push_back(i);
+        }
+        benchmark::DoNotOptimize(v.data());
+    }
+}
+BENCHMARK(BM_NstlVector_PushBack_Large_Mremap)->Range(64<<10, 64<<20)->Unit(benchmark::kMillisecond);
+#endif
+
+// ---------------------------------------------------
+// Benchmark 2f: Worst-case push_back into freshly reserved storage
+// ---------------------------------------------------
+// Every push_back is timed on its own; "worst_ns" is the slowest one seen. With a
+// plain reserve() the first write to each page takes a fault inside the loop,
+// reserve_hot() takes those faults up front. Setup is excluded from the timings.
+template <typename Vec, typename Reserve>
+static void PushBackLatency(benchmark::State& state, Reserve reserve) {
+    using clock = std::chrono::steady_clock;
+    const int n = state.range(0);
+    long long worst = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        Vec v;
+        reserve(v, n);
+        state.ResumeTiming();
+
+        for (int i = 0; i < n; ++i) {
+            auto start = clock::now();
+            v.push_back(i);
+            auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count();
+            worst = std::max<long long>(worst, elapsed);
+        }
+        benchmark::DoNotOptimize(v.data());
+    }
+    state.counters["worst_ns"] = static_cast<double>(worst);
+}
+
+static void BM_NstlVector_PushBackLatency_Reserve(benchmark::State& state) {
+    PushBackLatency<nstl::vector<int>>(state, [](nstl::vector<int>& v, size_t n) { v.reserve(n); });
+}
+BENCHMARK(BM_NstlVector_PushBackLatency_Reserve)->Range(64<<10, 4<<20)->Unit(benchmark::kMillisecond);
+
+static void BM_NstlVector_PushBackLatency_ReserveHot(benchmark::State& state) {
+    PushBackLatency<nstl::vector<int>>(state, [](nstl::vector<int>& v, size_t n) { v.reserve_hot(n); });
+}
+BENCHMARK(BM_NstlVector_PushBackLatency_ReserveHot)->Range(64<<10, 4<<20)->Unit(benchmark::kMillisecond);
+
+static void BM_NstlVector_PushBackLatency_ReserveHotHuge(benchmark::State& state) {
+    PushBackLatency<nstl::vector<int>>(state, [](nstl::vector<int>& v, size_t n) {
+        v.reserve_hot(n, nstl::reserve_flags::huge_pages | nstl::reserve_flags::prefault);
+    });
+}
+BENCHMARK(BM_NstlVector_PushBackLatency_ReserveHotHuge)->Range(64<<10, 4<<20)->Unit(benchmark::kMillisecond);
+
+// ---------------------------------------------------
+// Benchmark 2g: Worst-case push_back with growth, doubling vs incremental
+// ---------------------------------------------------
+// No reserve: the vector starts empty, so nstl::vector's worst push_back is the
+// one that copies the whole buffer. incremental_vector spreads that copy over
+// the following appends.
+static void BM_NstlVector_PushBackLatency_Growth(benchmark::State& state) {
+    PushBackLatency<nstl::vector<int>>(state, [](nstl::vector<int>&, size_t) {});
+}
+BENCHMARK(BM_NstlVector_PushBackLatency_Growth)->Range(64<<10, 4<<20)->Unit(benchmark::kMillisecond);
+
+static void BM_NstlIncrementalVector_PushBackLatency_Growth(benchmark::State& state) {
+    PushBackLatency<nstl::incremental_vector<int>>(state, [](nstl::incremental_vector<int>&, size_t) {});
+}
+BENCHMARK(BM_NstlIncrementalVector_PushBackLatency_Growth)->Range(64<<10, 4<<20)->Unit(benchmark::kMillisecond);
+
+// ---------------------------------------------------
+// Benchmark 2h: push_back under each growth policy
+// ---------------------------------------------------
+// "reallocs" is how often the buffer was replaced and "slack" the fraction of
+// the final capacity left unused: the two quantities a policy trades.
+template <typename Growth>
+static void BM_NstlVector_PushBack_Growth(benchmark::State& state) {
+    size_t reallocs = 0;
+    size_t capacity = 0;
+    for (auto _ : state) {
+        nstl::vector<int, std::allocator<int>, Growth> v;
+        reallocs = 0;
+        for (int i = 0; i < state.range(0); ++i) {
+            if (v.size() == v.capacity()) ++reallocs;
+            v.push_back(i);
+        }
+        capacity = v.capacity();
+        benchmark::DoNotOptimize(v.data());
+    }
+    state.counters["reallocs"] = static_cast<double>(reallocs);
+    state.counters["slack"] = 1.0 - static_cast<double>(state.range(0)) / static_cast<double>(capacity);
+}
+BENCHMARK_TEMPLATE(BM_NstlVector_PushBack_Growth, nstl::growth::doubling)->Range(8, 8<<16);
+BENCHMARK_TEMPLATE(BM_NstlVector_PushBack_Growth, nstl::growth::one_and_half)->Range(8, 8<<16);
+BENCHMARK_TEMPLATE(BM_NstlVector_PushBack_Growth, nstl::growth::page_rounded<>)->Range(8, 8<<16);
+BENCHMARK_TEMPLATE(BM_NstlVector_PushBack_Growth, nstl::growth::huge_page_rounded<>)->Range(8, 8<<16);
+BENCHMARK_TEMPLATE(BM_NstlVector_PushBack_Growth, nstl::growth::size_class<>)->Range(8, 8<<16);
+
+// ---------------------------------------------------
+// Benchmark 2i: Appending batches from a feed buffer
+// ---------------------------------------------------
+// 64 batches of state.range(0) records, the way the feed handler appends them:
+// element-at-a-time push_back against a single bulk append per batch.
+struct FeedRecord {
+    long long order_id;
+    double price;
+    int quantity;
+    int side;
+};
+
+static std::vector<FeedRecord> MakeBatch(size_t n) {
+    std::vector<FeedRecord> batch(n);
+    for (size_t i = 0; i < n; ++i) batch[i] = {static_cast<long long>(i), 100.0 + i, 10, 0};
+    return batch;
+}
+
+static void BM_StdVector_AppendBatch(benchmark::State& state) {
+    auto batch = MakeBatch(state.range(0));
+    for (auto _ : state) {
+        std::vector<FeedRecord> v;
+        for (int b = 0; b < 64; ++b) {
+            v.insert(v.end(), batch.begin(), batch.end());
+        }
+        benchmark::DoNotOptimize(v.data());
+    }
+}
+BENCHMARK(BM_StdVector_AppendBatch)->RangeMultiplier(4)->Range(64, 4096);
+
+static void BM_NstlVector_AppendBatch_PushBack(benchmark::State& state) {
+    auto batch = MakeBatch(state.range(0));
+    for (auto _ : state) {
+        nstl::vector<FeedRecord> v;
+        for (int b = 0; b < 64; ++b) {
+            for (const auto& record : batch) v.push_back(record);
+        }
+        benchmark::DoNotOptimize(v.data());
+    }
+}
+BENCHMARK(BM_NstlVector_AppendBatch_PushBack)->RangeMultiplier(4)->Range(64, 4096);
+
+static void BM_NstlVector_AppendBatch(benchmark::State& state) {
+    auto batch = MakeBatch(state.range(0));
+    for (auto _ : state) {
+        nstl::vector<FeedRecord> v;
+        for (int b = 0; b < 64; ++b) {
+            v.append(nstl::span<const FeedRecord>(batch.data(), batch.size()));
+        }
+        benchmark::DoNotOptimize(v.data());
+    }
+}
+BENCHMARK(BM_NstlVector_AppendBatch)->RangeMultiplier(4)->Range(64, 4096);
+
+// Decoding into the vector's own storage: resize() zeroes the records first,
+// resize_for_overwrite() leaves them for the decoder to fill.
+static void BM_NstlVector_Resize(benchmark::State& state) {
+    nstl::vector<FeedRecord> v;
+    for (auto _ : state) {
+        v.resize(0);
+        v.resize(state.range(0));
+        benchmark::DoNotOptimize(v.data());
+    }
+}
+BENCHMARK(BM_NstlVector_Resize)->RangeMultiplier(4)->Range(64, 4096);
+
+static void BM_NstlVector_ResizeForOverwrite(benchmark::State& state) {
+    nstl::vector<FeedRecord> v;
+    for (auto _ : state) {
+        v.resize(0);
+        v.resize_for_overwrite(state.range(0));
+        benchmark::DoNotOptimize(v.data());
+    }
+}
+BENCHMARK(BM_NstlVector_ResizeForOverwrite)->RangeMultiplier(4)->Range(64, 4096);
+
 // ---------------------------------------------------
 // Benchmark 3: STL random access
 // ---------------------------------------------------
@@ -106,6 +384,232 @@ static void BM_NstlVector_RandomAccess(benchmark::State& state){
 }
 BENCHMARK(BM_NstlVector_RandomAccess)->Range(8, 8<<10);
 
+// ---------------------------------------------------
+// Benchmark 4b: Removing cancelled orders
+// ---------------------------------------------------
+// Each iteration copies a book of N order ids, then removes half of them one
+// at a time from the middle (erase) or drops every odd id in one pass (erase_if).
+// The copy is part of every variant so the numbers stay comparable.
+static void BM_StdVector_Erase(benchmark::State& state) {
+    std::vector<int> book(state.range(0));
+    for (int i = 0; i < state.range(0); ++i) book[i] = i;
+    for (auto _ : state) {
+        std::vector<int> v = book;
+        for (int k = 0; k < state.range(0) / 2; ++k) {
+            v.erase(v.begin() + v.size() / 2);
+        }
+        benchmark::DoNotOptimize(v.data());
+    }
+}
+BENCHMARK(BM_StdVector_Erase)->Range(8, 8<<10);
+
+static void BM_NstlVector_Erase(benchmark::State& state) {
+    nstl::vector<int> book;
+    for (int i = 0; i < state.range(0); ++i) book.push_back(i);
+    for (auto _ : state) {
+        nstl::vector<int> v = book;
+        for (int k = 0; k < state.range(0) / 2; ++k) {
+            v.erase(v.begin() + v.size() / 2);
+        }
+        benchmark::DoNotOptimize(v.data());
+    }
+}
+BENCHMARK(BM_NstlVector_Erase)->Range(8, 8<<10);
+
+static void BM_NstlVector_UnorderedErase(benchmark::State& state) {
+    nstl::vector<int> book;
+    for (int i = 0; i < state.range(0); ++i) book.push_back(i);
+    for (auto _ : state) {
+        nstl::vector<int> v = book;
+        for (int k = 0; k < state.range(0) / 2; ++k) {
+            v.unordered_erase(v.begin() + v.size() / 2);
+        }
+        benchmark::DoNotOptimize(v.data());
+    }
+}
+BENCHMARK(BM_NstlVector_UnorderedErase)->Range(8, 8<<10);
+
+static void BM_StdVector_EraseIf(benchmark::State& state) {
+    std::vector<int> book(state.range(0));
+    for (int i = 0; i < state.range(0); ++i) book[i] = i;
+    for (auto _ : state) {
+        std::vector<int> v = book;
+        std::erase_if(v, [](int id) { return id & 1; });
+        benchmark::DoNotOptimize(v.data());
+    }
+}
+BENCHMARK(BM_StdVector_EraseIf)->Range(8, 8<<10);
+
+static void BM_NstlVector_EraseIf(benchmark::State& state) {
+    nstl::vector<int> book;
+    for (int i = 0; i < state.range(0); ++i) book.push_back(i);
+    for (auto _ : state) {
+        nstl::vector<int> v = book;
+        nstl::erase_if(v, [](int id) { return id & 1; });
+        benchmark::DoNotOptimize(v.data());
+    }
+}
+BENCHMARK(BM_NstlVector_EraseIf)->Range(8, 8<<10);
+
+// Scales a batch of floats in place. The plain span needs a scalar tail for the
+// last size() % 16 elements; the aligned span runs whole 64-byte chunks over
+// padded_size() with no tail and lets the compiler assume aligned data.
+static void ScaleTail(nstl::span<float> s, float k) {
+    float* p = s.data();
+    size_t n = s.size(), i = 0;
+    for (; i + 16 <= n; i += 16) {
+        for (size_t j = 0; j < 16; ++j) p[i + j] *= k;
+    }
+    for (; i < n; ++i) p[i] *= k;
+}
+
+static void ScalePadded(nstl::aligned_span<float, 64> s, float k) {
+    float* p = s.data();
+    size_t n = s.padded_size();
+    for (size_t i = 0; i < n; i += 16) {
+        for (size_t j = 0; j < 16; ++j) p[i + j] *= k;
+    }
+}
+
+static void BM_NstlVector_ScaleFloats(benchmark::State& state) {
+    nstl::vector<float> v;
+    v.resize(state.range(0), 1.0f);
+    for (auto _ : state) {
+        ScaleTail(v, 1.0001f);
+        benchmark::DoNotOptimize(v.data());
+    }
+}
+BENCHMARK(BM_NstlVector_ScaleFloats)->Arg(13)->Arg(61)->Arg(1021)->Arg(16381);
+
+static void BM_NstlAlignedVector_ScaleFloats(benchmark::State& state) {
+    nstl::aligned_vector<float> v;
+    v.resize(state.range(0), 1.0f);
+    for (auto _ : state) {
+        ScalePadded(v, 1.0001f);
+        benchmark::DoNotOptimize(v.data());
+    }
+}
+BENCHMARK(BM_NstlAlignedVector_ScaleFloats)->Arg(13)->Arg(61)->Arg(1021)->Arg(16381);
+
+// Sums one field of a quote table: the array of structs drags the other 40 bytes
+// of every record through the cache, the soa_vector column streams only prices.
+struct Quote {
+    double bid;
+    double ask;
+    int64_t bid_size;
+    int64_t ask_size;
+    uint64_t timestamp;
+    uint32_t venue;
+    uint32_t flags;
+};
+
+static void BM_NstlVector_SumField(benchmark::State& state) {
+    nstl::vector<Quote> quotes;
+    for (int i = 0; i < state.range(0); ++i) {
+        quotes.push_back({i * 0.01, i * 0.01 + 0.5, i, i, uint64_t(i), 1, 0});
+    }
+    for (auto _ : state) {
+        double sum = 0;
+        for (const Quote& q : quotes) sum += q.bid;
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(double));
+}
+BENCHMARK(BM_NstlVector_SumField)->Range(1<<10, 1<<22);
+
+static void BM_NstlSoaVector_SumField(benchmark::State& state) {
+    nstl::soa_vector<double, double, int64_t, int64_t, uint64_t, uint32_t, uint32_t> quotes;
+    for (int i = 0; i < state.range(0); ++i) {
+        quotes.emplace_back(i * 0.01, i * 0.01 + 0.5, i, i, uint64_t(i), 1u, 0u);
+    }
+    for (auto _ : state) {
+        double sum = 0;
+        for (double bid : quotes.column<0>()) sum += bid;
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(double));
+}
+BENCHMARK(BM_NstlSoaVector_SumField)->Range(1<<10, 1<<22);
+
+// A fresh per-message scratch buffer: the vector pays an allocation (and its
+// growth) every time, the static_vector lives on the stack.
+static void BM_NstlVector_Scratch(benchmark::State& state) {
+    for (auto _ : state) {
+        nstl::vector<int> v;
+        for (int i = 0; i < state.range(0); ++i) v.push_back(i);
+        benchmark::DoNotOptimize(v.data());
+    }
+}
+BENCHMARK(BM_NstlVector_Scratch)->Arg(8)->Arg(64)->Arg(256);
+
+static void BM_NstlStaticVector_Scratch(benchmark::State& state) {
+    for (auto _ : state) {
+        nstl::static_vector<int, 256> v;
+        for (int i = 0; i < state.range(0); ++i) v.push_back(i);
+        benchmark::DoNotOptimize(v.data());
+    }
+}
+BENCHMARK(BM_NstlStaticVector_Scratch)->Arg(8)->Arg(64)->Arg(256);
+
+// stable_vector against nstl::vector: append (no reallocation copies), random
+// access (shift + mask + one extra load) and a full scan (per chunk span).
+static void BM_NstlStableVector_PushBack(benchmark::State& state) {
+    for (auto _ : state) {
+        nstl::stable_vector<int> v;
+        for (int i = 0; i < state.range(0); ++i) v.push_back(i);
+        benchmark::DoNotOptimize(&v[0]);
+    }
+}
+BENCHMARK(BM_NstlStableVector_PushBack)->Range(8, 8<<10);
+
+static void BM_NstlStableVector_RandomAccess(benchmark::State& state){
+    size_t N = state.range(0);
+    nstl::stable_vector<int> v;
+    for (size_t i = 0; i < N; ++i) v.push_back(static_cast<int>(i));
+
+    std::vector<int> random_indices;
+    random_indices.reserve(100000);
+    std::mt19937 rng(12345);
+    std::uniform_int_distribution<int> dist(0, static_cast<int>(N) - 1);
+    for(int i=0; i<100000; ++i) {
+        random_indices.push_back(dist(rng));
+    }
+
+    long long sum = 0;
+    size_t idx = 0;
+    for (auto _ : state){
+        int rand_pos = random_indices[idx % 100000];
+        sum += v[rand_pos];
+        idx++;
+    }
+    benchmark::DoNotOptimize(sum);
+}
+BENCHMARK(BM_NstlStableVector_RandomAccess)->Range(8, 8<<10);
+
+static void BM_NstlVector_Scan(benchmark::State& state) {
+    nstl::vector<int> v;
+    for (int i = 0; i < state.range(0); ++i) v.push_back(i);
+    for (auto _ : state) {
+        long long sum = 0;
+        for (int x : v) sum += x;
+        benchmark::DoNotOptimize(sum);
+    }
+}
+BENCHMARK(BM_NstlVector_Scan)->Range(1<<10, 1<<20);
+
+static void BM_NstlStableVector_Scan(benchmark::State& state) {
+    nstl::stable_vector<int> v;
+    for (int i = 0; i < state.range(0); ++i) v.push_back(i);
+    for (auto _ : state) {
+        long long sum = 0;
+        for (size_t c = 0; c < v.chunk_count(); ++c) {
+            for (int x : v.chunk(c)) sum += x;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+BENCHMARK(BM_NstlStableVector_Scan)->Range(1<<10, 1<<20);
+
 
 
 
@@ -146,6 +650,47 @@ static void BM_NstlVector_PushBack_Heavy(benchmark::State& state){
 BENCHMARK(BM_NstlVector_PushBack_Heavy)->Range(8, 1<<10);
 
 
+// Same payload as Heavy, but held through nstl::unique_ptr so the record can opt
+// into trivial relocation (libstdc++'s std::string points into itself and can't).
+struct HeavyRelocatable {
+    nstl::unique_ptr<std::string> s;
+    HeavyRelocatable(const char* c) : s(new std::string(c)) {}
+    HeavyRelocatable(const HeavyRelocatable& other) : s(new std::string(*other.s)) {}
+    HeavyRelocatable(HeavyRelocatable&&) noexcept = default;
+};
+template <>
+struct nstl::is_trivially_relocatable<HeavyRelocatable> : std::true_type {};
+
+// ---------------------------------------------------
+// Benchmark 6b: STL Heavy Push_back, relocatable record
+// ---------------------------------------------------
+static void BM_StdVector_PushBack_HeavyRelocatable(benchmark::State& state){
+    HeavyRelocatable proto("Long string to defeat Small String Optimization");
+    for (auto _ : state) {
+        std::vector<HeavyRelocatable> v;
+        for (int i = 0; i < state.range(0); ++i) {
+            v.push_back(proto);
+        }
+    }
+}
+BENCHMARK(BM_StdVector_PushBack_HeavyRelocatable)->Range(8, 1<<10);
+
+// ---------------------------------------------------
+// Benchmark 6c: NSTL Heavy Push_back, relocatable record
+// ---------------------------------------------------
+// Every reallocation is one memcpy instead of a move + destroy per element.
+static void BM_NstlVector_PushBack_HeavyRelocatable(benchmark::State& state){
+    HeavyRelocatable proto("Long string to defeat Small String Optimization");
+    for (auto _ : state) {
+        nstl::vector<HeavyRelocatable> v;
+        for (int i = 0; i < state.range(0); ++i) {
+            v.push_back(proto);
+        }
+    }
+}
+BENCHMARK(BM_NstlVector_PushBack_HeavyRelocatable)->Range(8, 1<<10);
+
+
 struct HeavyConstruct {
     std::string data;
     int x, y, z;
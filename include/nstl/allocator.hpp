@@ -0,0 +1,203 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <type_traits>
+#include <bit>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace nstl {
+    inline size_t page_size() noexcept {
+#if defined(__linux__)
+        static const size_t size = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+        return size;
+#else
+        return 4096;
+#endif
+    }
+
+    // Distance that independently written atomics are kept apart by to avoid false
+    // sharing (std::hardware_destructive_interference_size on current x86 and ARM).
+    inline constexpr size_t cache_line_size = 64;
+
+    // Page-level helpers for storage that must not fault once a hot loop starts.
+    // All of them take a byte range of raw (not yet constructed) storage.
+
+    // Writes one byte into every page of the range so the kernel backs it now
+    // rather than on the first store from the hot path.
+    inline void prefault_pages(void* p, size_t bytes) noexcept {
+        if (bytes == 0) return;
+        auto* first = static_cast<volatile unsigned char*>(p);
+        for (size_t offset = 0; offset < bytes; offset += page_size()) {
+            first[offset] = 0;
+        }
+        first[bytes - 1] = 0;
+    }
+
+    // Pins the pages of the range in RAM. Fails (returns false) beyond RLIMIT_MEMLOCK.
+    // The lock outlives free(), so it is meant for long-lived buffers.
+    inline bool lock_pages(void* p, size_t bytes) noexcept {
+#if defined(__linux__)
+        return bytes == 0 || ::mlock(p, bytes) == 0;
+#else
+        (void)p; (void)bytes;
+        return false;
+#endif
+    }
+
+    // Asks for transparent huge pages on the whole pages inside the range. Only
+    // 2 MB-aligned stretches can actually be backed by huge pages.
+    inline bool advise_huge_pages(void* p, size_t bytes) noexcept {
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+        uintptr_t begin = (reinterpret_cast<uintptr_t>(p) + page_size() - 1) & ~(page_size() - 1);
+        uintptr_t end = (reinterpret_cast<uintptr_t>(p) + bytes) & ~(page_size() - 1);
+        if (end <= begin) return true;
+        return ::madvise(reinterpret_cast<void*>(begin), end - begin, MADV_HUGEPAGE) == 0;
+#else
+        (void)p; (void)bytes;
+        return false;
+#endif
+    }
+
+    // Allocators in this header expose reallocate(p, old_n, new_n) on top of the
+    // standard interface. nstl::vector calls it for trivially relocatable element
+    // types so that growth can extend a block in place instead of copying it.
+
+    // Allocator backed by malloc/realloc/free. realloc extends a chunk in place when
+    // the heap has room behind it, and glibc moves large (mmapped) chunks with mremap,
+    // so the elements are only copied when neither is possible.
+    template<typename T>
+    struct malloc_allocator {
+        static_assert(alignof(T) <= alignof(std::max_align_t), "malloc_allocator cannot over-align");
+
+        using value_type = T;
+        using is_always_equal = std::true_type;
+
+        constexpr malloc_allocator() noexcept = default;
+        template<typename U>
+        constexpr malloc_allocator(const malloc_allocator<U>&) noexcept {}
+
+        T* allocate(size_t n) {
+            void* p = std::malloc(n * sizeof(T));
+            if (!p) [[unlikely]] {
+                throw std::bad_alloc();
+            }
+            return static_cast<T*>(p);
+        }
+        void deallocate(T* p, size_t) noexcept {
+            std::free(p);
+        }
+
+        T* reallocate(T* p, size_t, size_t new_n) {
+#if defined(__GLIBC__)
+            // The chunk is often bigger than what was asked for; growing into the slack is free.
+            if (new_n * sizeof(T) <= malloc_usable_size(p)) {
+                return p;
+            }
+#endif
+            void* q = std::realloc(p, new_n * sizeof(T));
+            if (!q) [[unlikely]] {
+                throw std::bad_alloc();
+            }
+            return static_cast<T*>(q);
+        }
+
+        template<typename U>
+        constexpr bool operator==(const malloc_allocator<U>&) const noexcept { return true; }
+    };
+
+    // Allocator whose blocks start on an Alignment-byte boundary (a cache line by
+    // default) and are padded to a whole number of Alignment-sized chunks. A SIMD
+    // kernel can therefore use aligned loads throughout and run its last full-width
+    // iteration past size() without leaving the allocation.
+    template<typename T, size_t Alignment = 64>
+    struct aligned_allocator {
+        static_assert(std::has_single_bit(Alignment), "Alignment must be a power of two");
+        static_assert(Alignment >= alignof(T), "Alignment cannot be weaker than alignof(T)");
+
+        using value_type = T;
+        using is_always_equal = std::true_type;
+        static constexpr size_t alignment = Alignment;
+
+        template<typename U>
+        struct rebind { using other = aligned_allocator<U, Alignment>; };
+
+        constexpr aligned_allocator() noexcept = default;
+        template<typename U>
+        constexpr aligned_allocator(const aligned_allocator<U, Alignment>&) noexcept {}
+
+        T* allocate(size_t n) {
+            return static_cast<T*>(::operator new(padded_bytes(n), std::align_val_t(Alignment)));
+        }
+        void deallocate(T* p, size_t n) noexcept {
+            ::operator delete(p, padded_bytes(n), std::align_val_t(Alignment));
+        }
+
+        static constexpr size_t padded_bytes(size_t n) noexcept {
+            return (n * sizeof(T) + Alignment - 1) & ~(Alignment - 1);
+        }
+
+        template<typename U>
+        constexpr bool operator==(const aligned_allocator<U, Alignment>&) const noexcept { return true; }
+    };
+
+#if defined(__linux__)
+    // Allocator that maps every block directly from the kernel, rounded up to whole
+    // pages. Growth goes through mremap, which moves page table entries rather than
+    // bytes, so even a multi-hundred-MB buffer grows without a copy. Meant for a few
+    // large, long-lived buffers; small blocks waste most of a page.
+    template<typename T>
+    struct page_allocator {
+        using value_type = T;
+        using is_always_equal = std::true_type;
+
+        constexpr page_allocator() noexcept = default;
+        template<typename U>
+        constexpr page_allocator(const page_allocator<U>&) noexcept {}
+
+        T* allocate(size_t n) {
+            void* p = ::mmap(nullptr, mapping_size(n), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (p == MAP_FAILED) [[unlikely]] {
+                throw std::bad_alloc();
+            }
+            return static_cast<T*>(p);
+        }
+        void deallocate(T* p, size_t n) noexcept {
+            ::munmap(p, mapping_size(n));
+        }
+
+        T* reallocate(T* p, size_t old_n, size_t new_n) {
+            size_t old_bytes = mapping_size(old_n);
+            size_t new_bytes = mapping_size(new_n);
+            if (old_bytes == new_bytes) {
+                return p;
+            }
+            void* q = ::mremap(p, old_bytes, new_bytes, MREMAP_MAYMOVE);
+            if (q == MAP_FAILED) [[unlikely]] {
+                throw std::bad_alloc();
+            }
+            return static_cast<T*>(q);
+        }
+
+        template<typename U>
+        constexpr bool operator==(const page_allocator<U>&) const noexcept { return true; }
+
+        static size_t page_size() noexcept { return nstl::page_size(); }
+
+    private:
+        static size_t mapping_size(size_t n) noexcept {
+            size_t page = page_size();
+            return (n * sizeof(T) + page - 1) & ~(page - 1);
+        }
+    };
+#endif
+}
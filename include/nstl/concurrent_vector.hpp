@@ -0,0 +1,303 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <compare>
+#include <nstl/type_traits.hpp>
+#include <nstl/allocator.hpp>
+
+namespace nstl {
+    // Append-only vector that any number of threads can push into without a lock.
+    //
+    // A producer claims a slot with one fetch_add, constructs its element there and
+    // marks the slot ready. Storage is a fixed table of buckets whose sizes double
+    // (first_bucket_size, then 2x, 4x, ...), allocated on first use and published
+    // with a CAS, so elements never move and indexing needs no lock either.
+    //
+    // size() is the published watermark: the longest prefix of slots that are all
+    // constructed. Readers may iterate [0, size()) while producers keep appending;
+    // a slot past the watermark becomes visible once every slot before it is done.
+    //
+    // Only emplace_back/push_back, reserve and the read side are thread-safe;
+    // copying, moving and destruction need the producers to have finished.
+    template<typename T, typename Alloc = std::allocator<T>>
+    class concurrent_vector {
+        using alloc_traits = std::allocator_traits<Alloc>;
+        using flag_type = std::atomic<bool>;
+        using flag_allocator = typename alloc_traits::template rebind_alloc<flag_type>;
+        using flag_traits = std::allocator_traits<flag_allocator>;
+
+        static_assert(std::is_nothrow_move_constructible_v<T>,
+                      "concurrent_vector needs a nothrow move to place elements after a slot is claimed");
+
+        static constexpr size_t first_bucket_shift = 6;
+        static constexpr size_t bucket_count = 64 - first_bucket_shift;
+
+        template<bool Const>
+        class basic_iterator {
+            using owner_type = std::conditional_t<Const, const concurrent_vector, concurrent_vector>;
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using reference = std::conditional_t<Const, const T&, T&>;
+            using pointer = std::conditional_t<Const, const T*, T*>;
+
+            basic_iterator() noexcept = default;
+            basic_iterator(owner_type* owner, size_t idx) noexcept : _owner(owner), _idx(idx) {}
+            operator basic_iterator<true>() const noexcept { return {_owner, _idx}; }
+
+            reference operator*() const noexcept { return (*_owner)[_idx]; }
+            pointer operator->() const noexcept { return &(*_owner)[_idx]; }
+            reference operator[](difference_type n) const noexcept { return (*_owner)[_idx + n]; }
+
+            basic_iterator& operator++() noexcept { ++_idx; return *this; }
+            basic_iterator operator++(int) noexcept { auto tmp = *this; ++_idx; return tmp; }
+            basic_iterator& operator--() noexcept { --_idx; return *this; }
+            basic_iterator operator--(int) noexcept { auto tmp = *this; --_idx; return tmp; }
+            basic_iterator& operator+=(difference_type n) noexcept { _idx += n; return *this; }
+            basic_iterator& operator-=(difference_type n) noexcept { _idx -= n; return *this; }
+
+            friend basic_iterator operator+(basic_iterator it, difference_type n) noexcept { return it += n; }
+            friend basic_iterator operator+(difference_type n, basic_iterator it) noexcept { return it += n; }
+            friend basic_iterator operator-(basic_iterator it, difference_type n) noexcept { return it -= n; }
+            friend difference_type operator-(const basic_iterator& a, const basic_iterator& b) noexcept {
+                return static_cast<difference_type>(a._idx) - static_cast<difference_type>(b._idx);
+            }
+            friend bool operator==(const basic_iterator& a, const basic_iterator& b) noexcept { return a._idx == b._idx; }
+            friend auto operator<=>(const basic_iterator& a, const basic_iterator& b) noexcept { return a._idx <=> b._idx; }
+
+        private:
+            owner_type* _owner = nullptr;
+            size_t _idx = 0;
+        };
+
+    public:
+        using value_type = T;
+        using allocator_type = Alloc;
+        using iterator = basic_iterator<false>;
+        using const_iterator = basic_iterator<true>;
+
+        static constexpr size_t first_bucket_size = size_t(1) << first_bucket_shift;
+
+        concurrent_vector() noexcept(noexcept(Alloc())) = default;
+        explicit concurrent_vector(const Alloc& alloc) noexcept : _allocator(alloc) {}
+        ~concurrent_vector() {
+            release();
+        }
+        concurrent_vector(const concurrent_vector& other)
+            : _allocator(alloc_traits::select_on_container_copy_construction(other._allocator)) {
+            try {
+                for (const T& value : other) emplace_back(value);
+            } catch (...) {
+                release();
+                throw;
+            }
+        }
+        concurrent_vector(concurrent_vector&& other) noexcept : _allocator(std::move(other._allocator)) {
+            steal(other);
+        }
+        concurrent_vector& operator=(const concurrent_vector& other) {
+            if (this == &other) return *this;
+            concurrent_vector copy(alloc_traits::propagate_on_container_copy_assignment::value ? other._allocator : _allocator);
+            for (const T& value : other) copy.emplace_back(value);
+            release();
+            if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+                _allocator = other._allocator;
+            }
+            steal(copy);
+            return *this;
+        }
+        concurrent_vector& operator=(concurrent_vector&& other) noexcept {
+            static_assert(alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value,
+                          "concurrent_vector move assignment needs a propagating or always-equal allocator");
+            if (this == &other) return *this;
+            release();
+            if constexpr (alloc_traits::propagate_on_container_move_assignment::value) {
+                _allocator = std::move(other._allocator);
+            }
+            steal(other);
+            return *this;
+        }
+
+        allocator_type get_allocator() const noexcept { return _allocator; }
+
+        T& push_back(const T& value) { return emplace_back(value); }
+        T& push_back(T&& value) { return emplace_back(std::move(value)); }
+
+        // Thread-safe. A constructor that may throw runs before a slot is claimed,
+        // so a failed append never leaves a hole below the watermark.
+        template<typename... Args>
+        T& emplace_back(Args&&... args) {
+            if constexpr (std::is_nothrow_constructible_v<T, Args...>) {
+                return *place(std::forward<Args>(args)...);
+            } else {
+                T value(std::forward<Args>(args)...);
+                return *place(std::move(value));
+            }
+        }
+
+        // Thread-safe. Allocates the buckets that cover the first n elements.
+        void reserve(size_t n) {
+            if (n == 0) return;
+            for (size_t b = 0, last = locate(n - 1).bucket; b <= last; ++b) {
+                bucket(b);
+            }
+        }
+
+        // Thread-safe. Elements [0, size()) are constructed and visible.
+        size_t size() const noexcept { return _published.load(std::memory_order_acquire); }
+        bool empty() const noexcept { return size() == 0; }
+        // Slots claimed so far, including ones still being constructed.
+        size_t reserved() const noexcept { return _reserved.load(std::memory_order_relaxed); }
+
+        const T& operator[](size_t idx) const noexcept {
+            auto [b, offset] = locate(idx);
+            return _buckets[b].load(std::memory_order_relaxed)[offset];
+        }
+        T& operator[](size_t idx) noexcept {
+            auto [b, offset] = locate(idx);
+            return _buckets[b].load(std::memory_order_relaxed)[offset];
+        }
+
+        const T& at(size_t idx) const {
+            if (idx >= size()) [[unlikely]] {
+                throw std::out_of_range("Error: Index out of bounds");
+            }
+            return (*this)[idx];
+        }
+        T& at(size_t idx) {
+            if (idx >= size()) [[unlikely]] {
+                throw std::out_of_range("Error: Index out of bounds");
+            }
+            return (*this)[idx];
+        }
+
+        // end() is the watermark at the time of the call.
+        iterator begin() noexcept { return {this, 0}; }
+        iterator end() noexcept { return {this, size()}; }
+        const_iterator begin() const noexcept { return {this, 0}; }
+        const_iterator end() const noexcept { return {this, size()}; }
+        const_iterator cbegin() const noexcept { return {this, 0}; }
+        const_iterator cend() const noexcept { return {this, size()}; }
+
+    private:
+        struct location {
+            size_t bucket;
+            size_t offset;
+        };
+
+        [[no_unique_address]] Alloc _allocator;
+        // Producers bump _reserved and _published from different cores; keep them
+        // off each other's cache line and off the read-mostly bucket table.
+        alignas(cache_line_size) std::atomic<size_t> _reserved{0};
+        alignas(cache_line_size) std::atomic<size_t> _published{0};
+        alignas(cache_line_size) std::atomic<T*> _buckets[bucket_count] = {};
+        std::atomic<flag_type*> _ready[bucket_count] = {};
+
+        static constexpr size_t bucket_size(size_t b) noexcept { return first_bucket_size << b; }
+
+        // Bucket b covers [first_bucket_size * (2^b - 1), first_bucket_size * (2^(b+1) - 1)).
+        static constexpr location locate(size_t idx) noexcept {
+            size_t pos = idx + first_bucket_size;
+            size_t b = std::bit_width(pos) - 1 - first_bucket_shift;
+            return {b, pos - (first_bucket_size << b)};
+        }
+
+        // Returns bucket b, allocating it if no thread has yet. Racing allocators
+        // resolve with a CAS; the losers free their block.
+        T* bucket(size_t b) {
+            T* data = _buckets[b].load(std::memory_order_acquire);
+            if (data) [[likely]] {
+                return data;
+            }
+            flag_allocator flag_alloc(_allocator);
+            flag_type* flags = flag_traits::allocate(flag_alloc, bucket_size(b));
+            std::uninitialized_value_construct_n(flags, bucket_size(b));
+            flag_type* expected_flags = nullptr;
+            if (!_ready[b].compare_exchange_strong(expected_flags, flags, std::memory_order_acq_rel)) {
+                flag_traits::deallocate(flag_alloc, flags, bucket_size(b));
+            }
+            T* fresh = alloc_traits::allocate(_allocator, bucket_size(b));
+            if (!_buckets[b].compare_exchange_strong(data, fresh, std::memory_order_acq_rel)) {
+                alloc_traits::deallocate(_allocator, fresh, bucket_size(b));
+                return data;
+            }
+            return fresh;
+        }
+
+        // If the bucket allocation throws, the claimed slot is never filled and
+        // size() stops below it; elements already published stay readable.
+        template<typename... Args>
+        T* place(Args&&... args) {
+            size_t idx = _reserved.fetch_add(1);
+            auto [b, offset] = locate(idx);
+            T* slot = bucket(b) + offset;
+            alloc_traits::construct(_allocator, slot, std::forward<Args>(args)...);
+            _ready[b].load(std::memory_order_acquire)[offset].store(true);
+            // Uncontended case: this slot is the watermark and nobody claimed another.
+            // A producer that claimed the next slot and already missed this flag did
+            // so before this CAS, so the seq_cst load below sees its claim.
+            size_t expected = idx;
+            if (_published.compare_exchange_strong(expected, idx + 1) && _reserved.load() == idx + 1) {
+                return slot;
+            }
+            advance_watermark();
+            return slot;
+        }
+
+        // Moves _published over every consecutive ready slot. Each producer runs it
+        // after marking its own slot, so the last one to finish a gap closes it.
+        // seq_cst on the flags, the watermark and _reserved rules out two producers
+        // each missing the other's flag or claim.
+        void advance_watermark() noexcept {
+            size_t watermark = _published.load();
+            while (watermark < _reserved.load()) {
+                auto [b, offset] = locate(watermark);
+                flag_type* flags = _ready[b].load(std::memory_order_acquire);
+                if (!flags || !flags[offset].load()) {
+                    return;
+                }
+                _published.compare_exchange_weak(watermark, watermark + 1);
+            }
+        }
+
+        void release() noexcept {
+            size_t length = _published.load(std::memory_order_relaxed);
+            flag_allocator flag_alloc(_allocator);
+            for (size_t b = 0; b < bucket_count; ++b) {
+                T* data = _buckets[b].exchange(nullptr, std::memory_order_relaxed);
+                flag_type* flags = _ready[b].exchange(nullptr, std::memory_order_relaxed);
+                size_t first = first_bucket_size * ((size_t(1) << b) - 1);
+                if (data) {
+                    if constexpr (!std::is_trivially_destructible_v<T>) {
+                        for (size_t i = first; i < length && i < first + bucket_size(b); ++i) {
+                            alloc_traits::destroy(_allocator, &data[i - first]);
+                        }
+                    }
+                    alloc_traits::deallocate(_allocator, data, bucket_size(b));
+                }
+                if (flags) {
+                    flag_traits::deallocate(flag_alloc, flags, bucket_size(b));
+                }
+            }
+            _reserved.store(0, std::memory_order_relaxed);
+            _published.store(0, std::memory_order_relaxed);
+        }
+
+        void steal(concurrent_vector& other) noexcept {
+            for (size_t b = 0; b < bucket_count; ++b) {
+                _buckets[b].store(other._buckets[b].exchange(nullptr, std::memory_order_relaxed), std::memory_order_relaxed);
+                _ready[b].store(other._ready[b].exchange(nullptr, std::memory_order_relaxed), std::memory_order_relaxed);
+            }
+            _reserved.store(other._reserved.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+            _published.store(other._published.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+    };
+}
@@ -0,0 +1,336 @@
+#pragma once
+
+#include <algorithm>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <nstl/flat_set.hpp>
+#include <nstl/span.hpp>
+#include <nstl/vector.hpp>
+
+namespace nstl {
+    // Map kept as two parallel nstl::vectors: the sorted keys and, at the same
+    // indices, their values. A lookup binary-searches the key array alone, so the
+    // values never enter the cache until a key matches, and iteration is two linear
+    // scans. Inserting in the middle is O(n); bulk construction and insert_range
+    // sort once instead.
+    //
+    // Iterators hand out std::pair<const K&, V&> proxies, which work with
+    // structured bindings:
+    //
+    //     for (auto [symbol, state] : book) ...
+    template<typename K, typename V, typename Compare = std::less<K>>
+    class flat_map {
+        template<bool Const>
+        class basic_iterator {
+            using mapped_pointer = std::conditional_t<Const, const V*, V*>;
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = std::pair<K, V>;
+            using difference_type = std::ptrdiff_t;
+            using reference = std::pair<const K&, std::conditional_t<Const, const V&, V&>>;
+
+            // operator-> needs somewhere to keep the proxy it points at.
+            struct pointer {
+                reference ref;
+                const reference* operator->() const noexcept { return &ref; }
+            };
+
+            basic_iterator() noexcept = default;
+            basic_iterator(const K* key, mapped_pointer value) noexcept : _key(key), _value(value) {}
+            operator basic_iterator<true>() const noexcept { return {_key, _value}; }
+
+            reference operator*() const noexcept { return {*_key, *_value}; }
+            pointer operator->() const noexcept { return {**this}; }
+            reference operator[](difference_type n) const noexcept { return {_key[n], _value[n]}; }
+
+            basic_iterator& operator++() noexcept { ++_key; ++_value; return *this; }
+            basic_iterator operator++(int) noexcept { auto tmp = *this; ++*this; return tmp; }
+            basic_iterator& operator--() noexcept { --_key; --_value; return *this; }
+            basic_iterator operator--(int) noexcept { auto tmp = *this; --*this; return tmp; }
+            basic_iterator& operator+=(difference_type n) noexcept { _key += n; _value += n; return *this; }
+            basic_iterator& operator-=(difference_type n) noexcept { _key -= n; _value -= n; return *this; }
+
+            friend basic_iterator operator+(basic_iterator it, difference_type n) noexcept { return it += n; }
+            friend basic_iterator operator+(difference_type n, basic_iterator it) noexcept { return it += n; }
+            friend basic_iterator operator-(basic_iterator it, difference_type n) noexcept { return it -= n; }
+            friend difference_type operator-(const basic_iterator& a, const basic_iterator& b) noexcept { return a._key - b._key; }
+            friend bool operator==(const basic_iterator& a, const basic_iterator& b) noexcept { return a._key == b._key; }
+            friend auto operator<=>(const basic_iterator& a, const basic_iterator& b) noexcept { return a._key <=> b._key; }
+
+            const K& key() const noexcept { return *_key; }
+            auto& value() const noexcept { return *_value; }
+
+        private:
+            friend class flat_map;
+            const K* _key = nullptr;
+            mapped_pointer _value = nullptr;
+        };
+
+    public:
+        using key_type = K;
+        using mapped_type = V;
+        using value_type = std::pair<K, V>;
+        using key_compare = Compare;
+        using iterator = basic_iterator<false>;
+        using const_iterator = basic_iterator<true>;
+
+        flat_map() = default;
+        explicit flat_map(const Compare& comp) : _comp(comp) {}
+
+        // Takes unsorted keys and the values at the same indices; sorts both and
+        // drops duplicate keys (the first occurrence wins) in one pass.
+        flat_map(vector<K> keys, vector<V> values, const Compare& comp = Compare())
+            : _keys(std::move(keys)), _values(std::move(values)), _comp(comp) {
+            if (_keys.size() != _values.size()) [[unlikely]] {
+                throw std::length_error("Error: Key and value counts differ");
+            }
+            sort_unique(0);
+        }
+        // Takes keys that are already sorted and unique, without checking them.
+        flat_map(sorted_unique_t, vector<K> keys, vector<V> values, const Compare& comp = Compare())
+            : _keys(std::move(keys)), _values(std::move(values)), _comp(comp) {
+            if (_keys.size() != _values.size()) [[unlikely]] {
+                throw std::length_error("Error: Key and value counts differ");
+            }
+        }
+        // Any range of pairs (or tuples) of key and value, in any order.
+        template<std::ranges::input_range R>
+            requires (!std::same_as<std::remove_cvref_t<R>, flat_map>)
+        explicit flat_map(R&& range, const Compare& comp = Compare()) : _comp(comp) {
+            insert_range(std::forward<R>(range));
+        }
+
+        // Appends the whole range, then sorts only the new entries and merges them
+        // in. Keys already present keep their value, as with insert().
+        template<std::ranges::input_range R>
+        void insert_range(R&& range) {
+            size_t old_size = _keys.size();
+            if constexpr (std::ranges::sized_range<R>) {
+                _keys.reserve(old_size + std::ranges::size(range));
+                _values.reserve(old_size + std::ranges::size(range));
+            }
+            for (auto&& entry : range) {
+                using Entry = decltype(entry);
+                _keys.emplace_back(std::get<0>(std::forward<Entry>(entry)));
+                _values.emplace_back(std::get<1>(std::forward<Entry>(entry)));
+            }
+            sort_unique(old_size);
+        }
+
+        template<typename Key, typename... Args>
+        std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args) {
+            size_t i = lower_index(key);
+            if (i < size() && !_comp(key, _keys[i])) return {at_index(i), false};
+            place(i, std::forward<Key>(key), std::forward<Args>(args)...);
+            return {at_index(i), true};
+        }
+        template<typename Key, typename... Args>
+        std::pair<iterator, bool> emplace(Key&& key, Args&&... args) {
+            return try_emplace(std::forward<Key>(key), std::forward<Args>(args)...);
+        }
+        std::pair<iterator, bool> insert(const value_type& entry) { return try_emplace(entry.first, entry.second); }
+        std::pair<iterator, bool> insert(value_type&& entry) { return try_emplace(std::move(entry.first), std::move(entry.second)); }
+
+        template<typename Key, typename M>
+        std::pair<iterator, bool> insert_or_assign(Key&& key, M&& value) {
+            size_t i = lower_index(key);
+            if (i < size() && !_comp(key, _keys[i])) {
+                _values[i] = std::forward<M>(value);
+                return {at_index(i), false};
+            }
+            place(i, std::forward<Key>(key), std::forward<M>(value));
+            return {at_index(i), true};
+        }
+
+        V& operator[](const K& key) { return try_emplace(key).first.value(); }
+        V& operator[](K&& key) { return try_emplace(std::move(key)).first.value(); }
+
+        V& at(const K& key) { return _values[index_of(key)]; }
+        const V& at(const K& key) const { return _values[index_of(key)]; }
+        template<typename Key> requires detail::transparent_compare<Compare>
+        V& at(const Key& key) { return _values[index_of(key)]; }
+        template<typename Key> requires detail::transparent_compare<Compare>
+        const V& at(const Key& key) const { return _values[index_of(key)]; }
+
+        iterator erase(const_iterator pos) { return erase_at(static_cast<size_t>(pos._key - _keys.data())); }
+        iterator erase(const_iterator first, const_iterator last) {
+            size_t i = static_cast<size_t>(first._key - _keys.data());
+            size_t j = static_cast<size_t>(last._key - _keys.data());
+            _keys.erase(_keys.begin() + i, _keys.begin() + j);
+            _values.erase(_values.begin() + i, _values.begin() + j);
+            return at_index(i);
+        }
+        size_t erase(const K& key) { return erase_key(key); }
+        template<typename Key>
+            requires detail::transparent_compare<Compare> && (!std::convertible_to<const Key&, const_iterator>)
+        size_t erase(const Key& key) { return erase_key(key); }
+
+        iterator find(const K& key) { return at_index(find_index(key)); }
+        const_iterator find(const K& key) const { return at_index(find_index(key)); }
+        template<typename Key> requires detail::transparent_compare<Compare>
+        iterator find(const Key& key) { return at_index(find_index(key)); }
+        template<typename Key> requires detail::transparent_compare<Compare>
+        const_iterator find(const Key& key) const { return at_index(find_index(key)); }
+
+        bool contains(const K& key) const { return find_index(key) != size(); }
+        template<typename Key> requires detail::transparent_compare<Compare>
+        bool contains(const Key& key) const { return find_index(key) != size(); }
+
+        size_t count(const K& key) const { return contains(key) ? 1 : 0; }
+        template<typename Key> requires detail::transparent_compare<Compare>
+        size_t count(const Key& key) const { return contains(key) ? 1 : 0; }
+
+        iterator lower_bound(const K& key) { return at_index(lower_index(key)); }
+        const_iterator lower_bound(const K& key) const { return at_index(lower_index(key)); }
+        template<typename Key> requires detail::transparent_compare<Compare>
+        iterator lower_bound(const Key& key) { return at_index(lower_index(key)); }
+        template<typename Key> requires detail::transparent_compare<Compare>
+        const_iterator lower_bound(const Key& key) const { return at_index(lower_index(key)); }
+
+        iterator upper_bound(const K& key) { return at_index(upper_index(key)); }
+        const_iterator upper_bound(const K& key) const { return at_index(upper_index(key)); }
+        template<typename Key> requires detail::transparent_compare<Compare>
+        iterator upper_bound(const Key& key) { return at_index(upper_index(key)); }
+        template<typename Key> requires detail::transparent_compare<Compare>
+        const_iterator upper_bound(const Key& key) const { return at_index(upper_index(key)); }
+
+        // The sorted keys and their values as arrays, for scans over one column.
+        span<const K> keys() const noexcept { return span<const K>(_keys.data(), _keys.size()); }
+        span<V> values() noexcept { return span<V>(_values.data(), _values.size()); }
+        span<const V> values() const noexcept { return span<const V>(_values.data(), _values.size()); }
+
+        void reserve(size_t n) {
+            _keys.reserve(n);
+            _values.reserve(n);
+        }
+        void clear() noexcept {
+            _keys.clear();
+            _values.clear();
+        }
+        size_t size() const noexcept { return _keys.size(); }
+        bool empty() const noexcept { return _keys.empty(); }
+        key_compare key_comp() const { return _comp; }
+
+        iterator begin() noexcept { return at_index(0); }
+        iterator end() noexcept { return at_index(size()); }
+        const_iterator begin() const noexcept { return at_index(0); }
+        const_iterator end() const noexcept { return at_index(size()); }
+        const_iterator cbegin() const noexcept { return begin(); }
+        const_iterator cend() const noexcept { return end(); }
+
+        friend bool operator==(const flat_map& a, const flat_map& b) {
+            return std::ranges::equal(a.keys(), b.keys()) && std::ranges::equal(a.values(), b.values());
+        }
+
+    private:
+        iterator at_index(size_t i) noexcept { return {_keys.data() + i, _values.data() + i}; }
+        const_iterator at_index(size_t i) const noexcept { return {_keys.data() + i, _values.data() + i}; }
+
+        template<typename Key>
+        size_t lower_index(const Key& key) const {
+            return detail::sorted_lower_bound(_keys.data(), _keys.size(), key, _comp);
+        }
+        template<typename Key>
+        size_t upper_index(const Key& key) const {
+            return detail::sorted_upper_bound(_keys.data(), _keys.size(), key, _comp);
+        }
+        // size() when the key is absent.
+        template<typename Key>
+        size_t find_index(const Key& key) const {
+            size_t i = lower_index(key);
+            if (i == size() || _comp(key, _keys[i])) return size();
+            return i;
+        }
+        template<typename Key>
+        size_t index_of(const Key& key) const {
+            size_t i = find_index(key);
+            if (i == size()) [[unlikely]] {
+                throw std::out_of_range("Error: Key not found");
+            }
+            return i;
+        }
+        template<typename Key>
+        size_t erase_key(const Key& key) {
+            size_t i = find_index(key);
+            if (i == size()) return 0;
+            erase_at(i);
+            return 1;
+        }
+        iterator erase_at(size_t i) {
+            _keys.erase(_keys.begin() + i);
+            _values.erase(_values.begin() + i);
+            return at_index(i);
+        }
+
+        template<typename Key, typename... Args>
+        void place(size_t i, Key&& key, Args&&... args) {
+            _keys.emplace(_keys.begin() + i, std::forward<Key>(key));
+            try {
+                _values.emplace(_values.begin() + i, std::forward<Args>(args)...);
+            } catch (...) {
+                _keys.erase(_keys.begin() + i);
+                throw;
+            }
+        }
+
+        // [0, sorted) is already sorted and unique. Sorts the rest together with its
+        // values, drops entries whose key repeats within it or appears in the prefix,
+        // and merges the two.
+        void sort_unique(size_t sorted) {
+            size_t count = size() - sorted;
+            if (count == 0) return;
+            if (!detail::is_sorted_unique(_keys.data() + sorted, count, _comp)) {
+                // Sorting (key, value) rows in one contiguous array keeps the sort
+                // cache-friendly; the rows are split back into the columns after.
+                vector<std::pair<K, V>> rows;
+                rows.reserve(count);
+                for (size_t i = sorted; i < size(); ++i) rows.emplace_back(std::move(_keys[i]), std::move(_values[i]));
+                std::stable_sort(rows.begin(), rows.end(),
+                                 [this](const auto& a, const auto& b) { return _comp(a.first, b.first); });
+                _keys.erase(_keys.begin() + sorted, _keys.end());
+                _values.erase(_values.begin() + sorted, _values.end());
+                for (size_t i = 0; i < rows.size(); ++i) {
+                    if (i > 0 && !_comp(rows[i - 1].first, rows[i].first)) continue;
+                    _keys.push_back(std::move(rows[i].first));
+                    _values.push_back(std::move(rows[i].second));
+                }
+            }
+            // Appending keys past the current maximum is the common case and needs no merge.
+            if (sorted == 0 || _comp(_keys[sorted - 1], _keys[sorted])) return;
+
+            vector<K> keys;
+            vector<V> values;
+            keys.reserve(size());
+            values.reserve(size());
+            auto take = [&](size_t i) {
+                keys.push_back(std::move(_keys[i]));
+                values.push_back(std::move(_values[i]));
+            };
+            size_t i = 0, j = sorted;
+            while (i < sorted && j < size()) {
+                if (_comp(_keys[j], _keys[i])) {
+                    take(j++);
+                } else {
+                    if (!_comp(_keys[i], _keys[j])) ++j;
+                    take(i++);
+                }
+            }
+            for (; i < sorted; ++i) take(i);
+            for (; j < size(); ++j) take(j);
+            _keys = std::move(keys);
+            _values = std::move(values);
+        }
+
+        vector<K> _keys;
+        vector<V> _values;
+        [[no_unique_address]] Compare _comp;
+    };
+}
@@ -0,0 +1,229 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <nstl/span.hpp>
+#include <nstl/vector.hpp>
+
+namespace nstl {
+    // Tag for constructors whose input is already sorted and free of duplicates.
+    struct sorted_unique_t {
+        explicit sorted_unique_t() = default;
+    };
+    inline constexpr sorted_unique_t sorted_unique{};
+
+    namespace detail {
+        // Lookups by a type other than the key need a comparator that declares
+        // is_transparent, e.g. std::less<>.
+        template<typename Compare>
+        concept transparent_compare = requires { typename Compare::is_transparent; };
+
+        // Index of the first element of the sorted range [keys, keys + n) that is not
+        // less than key. The loop has no data-dependent branch: each step picks the
+        // half with a conditional move, so small tables do not pay for mispredicts.
+        template<typename K, typename Key, typename Compare>
+        size_t sorted_lower_bound(const K* keys, size_t n, const Key& key, const Compare& comp) {
+            if (n == 0) [[unlikely]] return 0;
+            const K* base = keys;
+            while (n > 1) {
+                size_t half = n / 2;
+                base = comp(base[half], key) ? base + half : base;
+                n -= half;
+            }
+            return static_cast<size_t>(base - keys) + (comp(*base, key) ? 1 : 0);
+        }
+
+        template<typename K, typename Key, typename Compare>
+        size_t sorted_upper_bound(const K* keys, size_t n, const Key& key, const Compare& comp) {
+            if (n == 0) [[unlikely]] return 0;
+            const K* base = keys;
+            while (n > 1) {
+                size_t half = n / 2;
+                base = comp(key, base[half]) ? base : base + half;
+                n -= half;
+            }
+            return static_cast<size_t>(base - keys) + (comp(key, *base) ? 0 : 1);
+        }
+
+        template<typename K, typename Compare>
+        bool is_sorted_unique(const K* keys, size_t n, const Compare& comp) {
+            for (size_t i = 1; i < n; ++i) {
+                if (!comp(keys[i - 1], keys[i])) return false;
+            }
+            return true;
+        }
+    }
+
+    // Set kept as a sorted nstl::vector. Lookups are a binary search over
+    // contiguous keys and iteration is a linear scan, which beats a node-based
+    // std::set for small, read-mostly sets; inserting in the middle is O(n).
+    // Bulk construction and insert_range sort once instead of inserting one by one.
+    template<typename K, typename Compare = std::less<K>>
+    class flat_set {
+    public:
+        using key_type = K;
+        using value_type = K;
+        using key_compare = Compare;
+        using iterator = const K*;
+        using const_iterator = const K*;
+
+        flat_set() = default;
+        explicit flat_set(const Compare& comp) : _comp(comp) {}
+
+        // Takes unsorted keys; sorts them and drops duplicates in one pass.
+        explicit flat_set(vector<K> keys, const Compare& comp = Compare()) : _keys(std::move(keys)), _comp(comp) {
+            sort_unique(0);
+        }
+        // Takes keys that are already sorted and unique, without checking.
+        flat_set(sorted_unique_t, vector<K> keys, const Compare& comp = Compare()) : _keys(std::move(keys)), _comp(comp) {}
+
+        template<std::ranges::input_range R>
+            requires (!std::same_as<std::remove_cvref_t<R>, flat_set> && !std::same_as<std::remove_cvref_t<R>, vector<K>>)
+        explicit flat_set(R&& range, const Compare& comp = Compare()) : _comp(comp) {
+            _keys.append_range(std::forward<R>(range));
+            sort_unique(0);
+        }
+
+        // Appends the whole range, then sorts only the new keys and merges them in.
+        // Keys already present are kept and the duplicates from the range dropped.
+        template<std::ranges::input_range R>
+        void insert_range(R&& range) {
+            size_t old_size = _keys.size();
+            _keys.append_range(std::forward<R>(range));
+            sort_unique(old_size);
+        }
+
+        template<typename... Args>
+        std::pair<iterator, bool> emplace(Args&&... args) {
+            return insert(K(std::forward<Args>(args)...));
+        }
+        std::pair<iterator, bool> insert(const K& key) { return insert_unique(key); }
+        std::pair<iterator, bool> insert(K&& key) { return insert_unique(std::move(key)); }
+
+        iterator erase(const_iterator pos) {
+            return _keys.erase(pos);
+        }
+        iterator erase(const_iterator first, const_iterator last) {
+            return _keys.erase(first, last);
+        }
+        size_t erase(const K& key) { return erase_key(key); }
+        template<typename Key>
+            requires detail::transparent_compare<Compare> && (!std::convertible_to<const Key&, const_iterator>)
+        size_t erase(const Key& key) { return erase_key(key); }
+
+        const_iterator find(const K& key) const { return find_key(key); }
+        template<typename Key> requires detail::transparent_compare<Compare>
+        const_iterator find(const Key& key) const { return find_key(key); }
+
+        bool contains(const K& key) const { return find_key(key) != end(); }
+        template<typename Key> requires detail::transparent_compare<Compare>
+        bool contains(const Key& key) const { return find_key(key) != end(); }
+
+        size_t count(const K& key) const { return contains(key) ? 1 : 0; }
+        template<typename Key> requires detail::transparent_compare<Compare>
+        size_t count(const Key& key) const { return contains(key) ? 1 : 0; }
+
+        const_iterator lower_bound(const K& key) const { return begin() + lower_index(key); }
+        template<typename Key> requires detail::transparent_compare<Compare>
+        const_iterator lower_bound(const Key& key) const { return begin() + lower_index(key); }
+
+        const_iterator upper_bound(const K& key) const { return begin() + upper_index(key); }
+        template<typename Key> requires detail::transparent_compare<Compare>
+        const_iterator upper_bound(const Key& key) const { return begin() + upper_index(key); }
+
+        std::pair<const_iterator, const_iterator> equal_range(const K& key) const { return {lower_bound(key), upper_bound(key)}; }
+        template<typename Key> requires detail::transparent_compare<Compare>
+        std::pair<const_iterator, const_iterator> equal_range(const Key& key) const { return {lower_bound(key), upper_bound(key)}; }
+
+        // The sorted keys, for scans that want the raw array.
+        span<const K> keys() const noexcept { return span<const K>(_keys.data(), _keys.size()); }
+        // Gives the keys back, leaving the set empty.
+        vector<K> extract() && { return std::move(_keys); }
+
+        void reserve(size_t n) { _keys.reserve(n); }
+        void clear() noexcept { _keys.clear(); }
+        size_t size() const noexcept { return _keys.size(); }
+        bool empty() const noexcept { return _keys.empty(); }
+        key_compare key_comp() const { return _comp; }
+
+        const_iterator begin() const noexcept { return _keys.begin(); }
+        const_iterator end() const noexcept { return _keys.end(); }
+        const_iterator cbegin() const noexcept { return _keys.begin(); }
+        const_iterator cend() const noexcept { return _keys.end(); }
+
+        friend bool operator==(const flat_set& a, const flat_set& b) {
+            return std::equal(a.begin(), a.end(), b.begin(), b.end());
+        }
+
+    private:
+        template<typename Key>
+        size_t lower_index(const Key& key) const {
+            return detail::sorted_lower_bound(_keys.data(), _keys.size(), key, _comp);
+        }
+        template<typename Key>
+        size_t upper_index(const Key& key) const {
+            return detail::sorted_upper_bound(_keys.data(), _keys.size(), key, _comp);
+        }
+        template<typename Key>
+        const_iterator find_key(const Key& key) const {
+            size_t i = lower_index(key);
+            if (i == _keys.size() || _comp(key, _keys[i])) return end();
+            return begin() + i;
+        }
+        template<typename Key>
+        size_t erase_key(const Key& key) {
+            const_iterator it = find_key(key);
+            if (it == end()) return 0;
+            _keys.erase(it);
+            return 1;
+        }
+
+        template<typename Arg>
+        std::pair<iterator, bool> insert_unique(Arg&& key) {
+            size_t i = lower_index(key);
+            if (i < _keys.size() && !_comp(key, _keys[i])) return {begin() + i, false};
+            return {_keys.emplace(_keys.begin() + i, std::forward<Arg>(key)), true};
+        }
+
+        // [0, sorted) is already sorted and unique. Sorts the rest, drops keys that
+        // repeat within it or already appear in the prefix, and merges the two.
+        void sort_unique(size_t sorted) {
+            K* tail = _keys.data() + sorted;
+            size_t count = _keys.size() - sorted;
+            if (count == 0) return;
+            if (!detail::is_sorted_unique(tail, count, _comp)) {
+                std::stable_sort(tail, tail + count, _comp);
+                K* last = std::unique(tail, tail + count, [this](const K& a, const K& b) { return !_comp(a, b); });
+                _keys.erase(last, _keys.end());
+                count = _keys.size() - sorted;
+            }
+            // Appending keys past the current maximum is the common case and needs no merge.
+            if (sorted == 0 || _comp(_keys[sorted - 1], _keys[sorted])) return;
+
+            vector<K> merged;
+            merged.reserve(_keys.size());
+            size_t i = 0, j = sorted;
+            while (i < sorted && j < _keys.size()) {
+                if (_comp(_keys[j], _keys[i])) {
+                    merged.push_back(std::move(_keys[j++]));
+                } else {
+                    if (!_comp(_keys[i], _keys[j])) ++j;
+                    merged.push_back(std::move(_keys[i++]));
+                }
+            }
+            for (; i < sorted; ++i) merged.push_back(std::move(_keys[i]));
+            for (; j < _keys.size(); ++j) merged.push_back(std::move(_keys[j]));
+            _keys = std::move(merged);
+        }
+
+        vector<K> _keys;
+        [[no_unique_address]] Compare _comp;
+    };
+}
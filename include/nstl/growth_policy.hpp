@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <bit>
+
+namespace nstl {
+    // Growth policies decide the capacity a full vector moves to:
+    //
+    //     static constexpr size_t next_capacity(size_t capacity, size_t element_size) noexcept;
+    //
+    // The result must be larger than capacity. element_size lets a policy round
+    // the block size in bytes rather than the element count.
+    namespace growth {
+        // x2, starting at 8 elements. The default.
+        struct doubling {
+            static constexpr size_t next_capacity(size_t capacity, size_t) noexcept {
+                return capacity ? capacity * 2 : 8;
+            }
+        };
+
+        // x1.5, starting at 8 elements. The sum of the freed blocks eventually exceeds
+        // the next request, so an allocator can reuse them; costs more reallocations.
+        struct one_and_half {
+            static constexpr size_t next_capacity(size_t capacity, size_t) noexcept {
+                return capacity ? capacity + (capacity >> 1) : 8;
+            }
+        };
+
+        // Grows like Base, then widens the block to a whole number of PageSize pages
+        // so no tail of the last page is wasted.
+        template<typename Base = doubling, size_t PageSize = 4096>
+        struct page_rounded {
+            static_assert(std::has_single_bit(PageSize), "PageSize must be a power of two");
+
+            static constexpr size_t next_capacity(size_t capacity, size_t element_size) noexcept {
+                size_t bytes = Base::next_capacity(capacity, element_size) * element_size;
+                return ((bytes + PageSize - 1) & ~(PageSize - 1)) / element_size;
+            }
+        };
+
+        // page_rounded to 2 MB transparent huge pages.
+        template<typename Base = doubling>
+        using huge_page_rounded = page_rounded<Base, size_t(2) << 20>;
+
+        // Grows like Base, then widens the block to the allocator's size class, i.e.
+        // the bytes malloc would hand out anyway. Models the jemalloc/tcmalloc layout:
+        // 16-byte steps up to 128 bytes, then four classes per power of two.
+        template<typename Base = doubling>
+        struct size_class {
+            static constexpr size_t round_bytes(size_t bytes) noexcept {
+                if (bytes <= 128) {
+                    return (bytes + 15) & ~size_t(15);
+                }
+                size_t step = std::bit_floor(bytes - 1) >> 2;
+                return (bytes + step - 1) & ~(step - 1);
+            }
+
+            static constexpr size_t next_capacity(size_t capacity, size_t element_size) noexcept {
+                return round_bytes(Base::next_capacity(capacity, element_size) * element_size) / element_size;
+            }
+        };
+    }
+}
@@ -0,0 +1,180 @@
+#pragma once
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <nstl/span.hpp>
+#include <nstl/type_traits.hpp>
+
+namespace nstl {
+    namespace detail::wy {
+        // wyhash final 4 with the default secret of its original release, whose
+        // reference test vectors HashTest.KnownAnswers checks (later wyhash revisions
+        // changed the secret and so hash differently). Two 64x64->128 multiplies per
+        // 16 bytes, folded by XOR; keys up to 16 bytes take two overlapping reads and
+        // no loop.
+        inline constexpr uint64_t secret[4] = {
+            0xa0761d6478bd642full, 0xe7037ed1a0b428dbull, 0x8ebc6af09c88c6e3ull, 0x589965cc75374cc3ull,
+        };
+
+        [[gnu::always_inline]] inline void mum(uint64_t& a, uint64_t& b) noexcept {
+#if defined(__SIZEOF_INT128__)
+            __uint128_t r = static_cast<__uint128_t>(a) * b;
+            a = static_cast<uint64_t>(r);
+            b = static_cast<uint64_t>(r >> 64);
+#else
+            uint64_t ha = a >> 32, hb = b >> 32, la = static_cast<uint32_t>(a), lb = static_cast<uint32_t>(b);
+            uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+            uint64_t t = rl + (rm0 << 32);
+            uint64_t c = t < rl;
+            uint64_t lo = t + (rm1 << 32);
+            c += lo < t;
+            a = lo;
+            b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+        }
+        [[gnu::always_inline]] inline uint64_t mix(uint64_t a, uint64_t b) noexcept {
+            mum(a, b);
+            return a ^ b;
+        }
+
+        // Little-endian reads on every platform, so hashes match across machines.
+        template<std::unsigned_integral U>
+        [[gnu::always_inline]] inline U from_little_endian(U v) noexcept {
+            if constexpr (std::endian::native == std::endian::big) {
+                U r = 0;
+                for (size_t i = 0; i < sizeof(U); ++i) r = static_cast<U>((r << 8) | ((v >> (8 * i)) & 0xFF));
+                return r;
+            }
+            return v;
+        }
+        [[gnu::always_inline]] inline uint64_t read8(const std::byte* p) noexcept {
+            uint64_t v;
+            std::memcpy(&v, p, 8);
+            return from_little_endian(v);
+        }
+        [[gnu::always_inline]] inline uint64_t read4(const std::byte* p) noexcept {
+            uint32_t v;
+            std::memcpy(&v, p, 4);
+            return from_little_endian(v);
+        }
+        // 1 to 3 bytes: first, middle and last, which together cover every byte.
+        [[gnu::always_inline]] inline uint64_t read3(const std::byte* p, size_t len) noexcept {
+            return (static_cast<uint64_t>(p[0]) << 16) | (static_cast<uint64_t>(p[len >> 1]) << 8) |
+                   static_cast<uint64_t>(p[len - 1]);
+        }
+
+        [[gnu::always_inline]] inline uint64_t start(uint64_t seed) noexcept {
+            return seed ^ mix(seed ^ secret[0], secret[1]);
+        }
+        // 1 to 16 bytes as two words. From 4 bytes on, the reads overlap so that every
+        // byte lands in a or b without a loop or a length switch.
+        [[gnu::always_inline]] inline void read_short(const std::byte* p, size_t len, uint64_t& a, uint64_t& b) noexcept {
+            if (len >= 4) {
+                size_t step = (len >> 3) << 2;
+                a = (read4(p) << 32) | read4(p + step);
+                b = (read4(p + len - 4) << 32) | read4(p + len - 4 - step);
+            } else {
+                a = read3(p, len);
+                b = 0;
+            }
+        }
+        // More than 16 bytes: 48-byte strides with three independent lanes, then 16 at a
+        // time, then the last 16 bytes (overlapping what came before) become a and b.
+        [[gnu::always_inline]] inline uint64_t read_long(const std::byte* p, size_t len, uint64_t seed, uint64_t& a,
+                                                        uint64_t& b) noexcept {
+            size_t i = len;
+            if (i > 48) {
+                uint64_t see1 = seed, see2 = seed;
+                do {
+                    seed = mix(read8(p) ^ secret[1], read8(p + 8) ^ seed);
+                    see1 = mix(read8(p + 16) ^ secret[2], read8(p + 24) ^ see1);
+                    see2 = mix(read8(p + 32) ^ secret[3], read8(p + 40) ^ see2);
+                    p += 48;
+                    i -= 48;
+                } while (i > 48);
+                seed ^= see1 ^ see2;
+            }
+            while (i > 16) {
+                seed = mix(read8(p) ^ secret[1], read8(p + 8) ^ seed);
+                i -= 16;
+                p += 16;
+            }
+            a = read8(p + i - 16);
+            b = read8(p + i - 8);
+            return seed;
+        }
+        [[gnu::always_inline]] inline uint64_t finish(uint64_t a, uint64_t b, uint64_t seed, size_t len) noexcept {
+            a ^= secret[1];
+            b ^= seed;
+            mum(a, b);
+            return mix(a ^ secret[0] ^ len, b ^ secret[1]);
+        }
+
+        inline uint64_t hash(const std::byte* p, size_t len, uint64_t seed) noexcept {
+            seed = start(seed);
+            uint64_t a = 0, b = 0;
+            if (len <= 16) [[likely]] {
+                if (len > 0) read_short(p, len, a, b);
+            } else {
+                seed = read_long(p, len, seed, a, b);
+            }
+            return finish(a, b, seed, len);
+        }
+
+        // Same result as hash(p, Len, seed). With the length known, every branch on it
+        // folds away: an 8-byte key is two loads and three multiplies. Keys long enough
+        // for the 48-byte loop gain nothing from inlining and share the generic code.
+        template<size_t Len>
+        [[gnu::always_inline]] inline uint64_t hash_fixed(const std::byte* p, uint64_t seed) noexcept {
+            if constexpr (Len > 48) return hash(p, Len, seed);
+            seed = start(seed);
+            uint64_t a = 0, b = 0;
+            if constexpr (Len == 0) {
+            } else if constexpr (Len <= 16) {
+                read_short(p, Len, a, b);
+            } else {
+                seed = read_long(p, Len, seed, a, b);
+            }
+            return finish(a, b, seed, Len);
+        }
+    }
+
+    // 64-bit hash of a byte range (wyhash). Equal bytes and seed give equal hashes
+    // on every platform. Not cryptographic: use it for tables, not against attackers.
+    inline uint64_t hash_bytes(span<const std::byte> bytes, uint64_t seed = 0) noexcept {
+        return detail::wy::hash(bytes.data(), bytes.size(), seed);
+    }
+
+    // Hashes the elements' bytes, so T must be trivially hashable. A fixed-extent span
+    // compiles to a path specialised for its exact byte count.
+    template<typename T, size_t Extent>
+        requires is_trivially_hashable_v<T>
+    uint64_t hash_bytes(span<T, Extent> values, uint64_t seed = 0) noexcept {
+        const std::byte* p = reinterpret_cast<const std::byte*>(values.data());
+        if constexpr (Extent != dynamic_extent) {
+            return detail::wy::hash_fixed<Extent * sizeof(T)>(p, seed);
+        } else {
+            return detail::wy::hash(p, values.size_bytes(), seed);
+        }
+    }
+
+    // Hasher for hash_map and friends: strings by their characters, trivially
+    // hashable keys by their bytes through the fixed-size path. Transparent, so a
+    // table keyed by std::string can be probed with a std::string_view.
+    struct byte_hash {
+        using is_transparent = void;
+
+        size_t operator()(std::string_view s) const noexcept {
+            return static_cast<size_t>(detail::wy::hash(reinterpret_cast<const std::byte*>(s.data()), s.size(), 0));
+        }
+        template<typename T>
+            requires is_trivially_hashable_v<T> && (!std::convertible_to<const T&, std::string_view>)
+        size_t operator()(const T& value) const noexcept {
+            return static_cast<size_t>(detail::wy::hash_fixed<sizeof(T)>(reinterpret_cast<const std::byte*>(&value), 0));
+        }
+    };
+}
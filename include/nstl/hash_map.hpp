@@ -0,0 +1,597 @@
+#pragma once
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <nstl/allocator.hpp>
+#include <nstl/type_traits.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define NSTL_HASH_MAP_SSE2 1
+#endif
+
+namespace nstl {
+    namespace detail {
+        // One control byte per slot. Full slots hold the low 7 bits of their hash
+        // (0..127); the two free states are negative so a single sign test finds them.
+        enum class ctrl_t : int8_t {
+            empty = -128,
+            deleted = -2, // tombstone: probes must keep going past it
+        };
+        inline constexpr size_t group_width = 16;
+
+        // Sixteen control bytes, compared in one instruction each. Groups are aligned
+        // to multiples of 16 slots; bit i of a mask stands for slot i of the group.
+        class ctrl_group {
+        public:
+            explicit ctrl_group(const int8_t* ctrl) noexcept {
+#if defined(NSTL_HASH_MAP_SSE2)
+                _bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+#else
+                std::memcpy(_bytes, ctrl, group_width);
+#endif
+            }
+
+            uint32_t match(int8_t h2) const noexcept {
+#if defined(NSTL_HASH_MAP_SSE2)
+                return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), _bytes)));
+#else
+                uint32_t mask = 0;
+                for (size_t i = 0; i < group_width; ++i) mask |= uint32_t(_bytes[i] == h2) << i;
+                return mask;
+#endif
+            }
+            uint32_t match_empty() const noexcept { return match(static_cast<int8_t>(ctrl_t::empty)); }
+            uint32_t match_free() const noexcept {
+#if defined(NSTL_HASH_MAP_SSE2)
+                return static_cast<uint32_t>(_mm_movemask_epi8(_bytes));
+#else
+                uint32_t mask = 0;
+                for (size_t i = 0; i < group_width; ++i) mask |= uint32_t(_bytes[i] < 0) << i;
+                return mask;
+#endif
+            }
+
+        private:
+#if defined(NSTL_HASH_MAP_SSE2)
+            __m128i _bytes;
+#else
+            int8_t _bytes[group_width];
+#endif
+        };
+
+        // Control bytes of a table with no storage yet: one group of empty slots, so
+        // lookups need no capacity check.
+        alignas(group_width) inline const int8_t empty_group[group_width] = {
+            -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128, -128,
+        };
+
+        // std::hash is the identity for integers on common standard libraries. The
+        // table takes its group index from the high bits and the tag from the low
+        // seven, so every input bit has to reach both.
+        inline uint64_t mix_hash(uint64_t h) noexcept {
+#if defined(__SIZEOF_INT128__)
+            __uint128_t product = static_cast<__uint128_t>(h) * 0x9E3779B97F4A7C15ull;
+            return static_cast<uint64_t>(product) ^ static_cast<uint64_t>(product >> 64);
+#else
+            h ^= h >> 33;
+            h *= 0xFF51AFD7ED558CCDull;
+            h ^= h >> 33;
+            return h;
+#endif
+        }
+
+        template<typename Hash, typename KeyEqual>
+        concept transparent_hash = requires {
+            typename Hash::is_transparent;
+            typename KeyEqual::is_transparent;
+        };
+    }
+
+    // Open-addressing hash map in the style of Swiss tables. Alongside the slot
+    // array sits one control byte per slot holding 7 bits of the key's hash. A lookup
+    // loads 16 control bytes at a time and compares them against the tag with one
+    // SSE2 instruction, so keys are only compared on a tag match (about 1 in 128
+    // otherwise), and the probe ends at the first group with an empty slot.
+    //
+    // Slots and control bytes share one allocation from Alloc. An erase only leaves a
+    // tombstone when the slot's group has been full since its last rehash; otherwise
+    // the slot simply becomes empty again. Iterators and references are invalidated
+    // by any insert that rehashes.
+    //
+    // Iterators hand out std::pair<const K&, V&> proxies, which work with
+    // structured bindings. erase(iterator) returns nothing, which saves a scan for
+    // the next full slot.
+    template<typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>,
+             typename Alloc = aligned_allocator<std::byte>>
+    class hash_map {
+        using slot_type = std::pair<K, V>;
+        using byte_allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<std::byte>;
+        using alloc_traits = std::allocator_traits<byte_allocator>;
+        static constexpr bool propagate_on_copy = alloc_traits::propagate_on_container_copy_assignment::value;
+        static constexpr bool propagate_on_move = alloc_traits::propagate_on_container_move_assignment::value;
+        static constexpr bool propagate_on_swap = alloc_traits::propagate_on_container_swap::value;
+        static_assert(alignof(slot_type) <= cache_line_size, "hash_map slots cannot be over-aligned");
+
+        template<bool Const>
+        class basic_iterator {
+            using slot_pointer = std::conditional_t<Const, const slot_type*, slot_type*>;
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = std::pair<K, V>;
+            using difference_type = std::ptrdiff_t;
+            using reference = std::pair<const K&, std::conditional_t<Const, const V&, V&>>;
+
+            // operator-> needs somewhere to keep the proxy it points at.
+            struct pointer {
+                reference ref;
+                const reference* operator->() const noexcept { return &ref; }
+            };
+
+            basic_iterator() noexcept = default;
+            basic_iterator(const int8_t* ctrl, const int8_t* end, slot_pointer slot) noexcept
+                : _ctrl(ctrl), _end(end), _slot(slot) {}
+            operator basic_iterator<true>() const noexcept { return {_ctrl, _end, _slot}; }
+
+            reference operator*() const noexcept { return {_slot->first, _slot->second}; }
+            pointer operator->() const noexcept { return {**this}; }
+
+            basic_iterator& operator++() noexcept {
+                ++_ctrl;
+                ++_slot;
+                skip_free();
+                return *this;
+            }
+            basic_iterator operator++(int) noexcept { auto tmp = *this; ++*this; return tmp; }
+
+            friend bool operator==(const basic_iterator& a, const basic_iterator& b) noexcept { return a._ctrl == b._ctrl; }
+
+            const K& key() const noexcept { return _slot->first; }
+            auto& value() const noexcept { return _slot->second; }
+
+        private:
+            friend class hash_map;
+
+            void skip_free() noexcept {
+                while (_ctrl != _end && *_ctrl < 0) {
+                    ++_ctrl;
+                    ++_slot;
+                }
+            }
+
+            const int8_t* _ctrl = nullptr;
+            const int8_t* _end = nullptr;
+            slot_pointer _slot = nullptr;
+        };
+
+        // Where a key lives, or where it would go.
+        struct probe_result {
+            size_t index;
+            bool found;
+            int8_t tag;
+        };
+
+    public:
+        using key_type = K;
+        using mapped_type = V;
+        using value_type = std::pair<K, V>;
+        using hasher = Hash;
+        using key_equal = KeyEqual;
+        using allocator_type = Alloc;
+        using iterator = basic_iterator<false>;
+        using const_iterator = basic_iterator<true>;
+
+        hash_map() = default;
+        explicit hash_map(size_t expected, const Hash& hash = Hash(), const KeyEqual& eq = KeyEqual(),
+                          const Alloc& alloc = Alloc())
+            : _allocator(alloc), _hash(hash), _eq(eq) {
+            reserve(expected);
+        }
+        ~hash_map() {
+            destroy_slots();
+            release();
+        }
+
+        hash_map(const hash_map& other)
+            : hash_map(other, alloc_traits::select_on_container_copy_construction(other._allocator)) {}
+        hash_map(const hash_map& other, const Alloc& alloc)
+            : _allocator(alloc), _hash(other._hash), _eq(other._eq) {
+            copy_from(other);
+        }
+        hash_map(hash_map&& other) noexcept
+            : _allocator(std::move(other._allocator)), _hash(std::move(other._hash)), _eq(std::move(other._eq)) {
+            steal(other);
+        }
+        hash_map& operator=(const hash_map& other) {
+            if (this == &other) return *this;
+            if constexpr (propagate_on_copy) {
+                if (_allocator != other._allocator) {
+                    // The old block goes back to the allocator it came from.
+                    destroy_slots();
+                    release();
+                }
+                _allocator = other._allocator;
+            }
+            hash_map copy(other, allocator_type(_allocator));
+            swap_contents(copy);
+            return *this;
+        }
+        hash_map& operator=(hash_map&& other) noexcept(propagate_on_move || alloc_traits::is_always_equal::value) {
+            if (this == &other) return *this;
+            if constexpr (propagate_on_move) {
+                destroy_slots();
+                release();
+                _allocator = std::move(other._allocator);
+            } else if (_allocator != other._allocator) {
+                // The block cannot change hands between unequal allocators, so the
+                // elements move into storage from ours instead.
+                hash_map moved(other.size(), other._hash, other._eq, allocator_type(_allocator));
+                for (size_t i = 0; i < other._capacity; ++i) {
+                    if (other._ctrl[i] >= 0) moved.try_emplace(std::move(other._slots[i].first), std::move(other._slots[i].second));
+                }
+                swap_contents(moved);
+                other.clear();
+                return *this;
+            } else {
+                destroy_slots();
+                release();
+            }
+            _hash = std::move(other._hash);
+            _eq = std::move(other._eq);
+            steal(other);
+            return *this;
+        }
+
+        // Allocators are exchanged only when they propagate on swap; otherwise they
+        // must compare equal, as for the standard containers.
+        void swap(hash_map& other) noexcept {
+            if constexpr (propagate_on_swap) {
+                using std::swap;
+                swap(_allocator, other._allocator);
+            }
+            swap_contents(other);
+        }
+        friend void swap(hash_map& a, hash_map& b) noexcept { a.swap(b); }
+
+        template<typename Key, typename... Args>
+        std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args) {
+            probe_result at = find_or_prepare_insert(key);
+            if (!at.found) {
+                construct_at(at, std::piecewise_construct, std::forward_as_tuple(std::forward<Key>(key)),
+                             std::forward_as_tuple(std::forward<Args>(args)...));
+            }
+            return {iterator_at(at.index), !at.found};
+        }
+        template<typename Key, typename... Args>
+        std::pair<iterator, bool> emplace(Key&& key, Args&&... args) {
+            return try_emplace(std::forward<Key>(key), std::forward<Args>(args)...);
+        }
+        std::pair<iterator, bool> insert(const value_type& entry) { return try_emplace(entry.first, entry.second); }
+        std::pair<iterator, bool> insert(value_type&& entry) { return try_emplace(std::move(entry.first), std::move(entry.second)); }
+
+        template<typename Key, typename M>
+        std::pair<iterator, bool> insert_or_assign(Key&& key, M&& value) {
+            probe_result at = find_or_prepare_insert(key);
+            if (at.found) {
+                _slots[at.index].second = std::forward<M>(value);
+            } else {
+                construct_at(at, std::forward<Key>(key), std::forward<M>(value));
+            }
+            return {iterator_at(at.index), !at.found};
+        }
+
+        V& operator[](const K& key) { return try_emplace(key).first.value(); }
+        V& operator[](K&& key) { return try_emplace(std::move(key)).first.value(); }
+
+        V& at(const K& key) { return _slots[index_of(key)].second; }
+        const V& at(const K& key) const { return _slots[index_of(key)].second; }
+        template<typename Key> requires detail::transparent_hash<Hash, KeyEqual>
+        V& at(const Key& key) { return _slots[index_of(key)].second; }
+        template<typename Key> requires detail::transparent_hash<Hash, KeyEqual>
+        const V& at(const Key& key) const { return _slots[index_of(key)].second; }
+
+        iterator find(const K& key) { return find_iterator(key); }
+        const_iterator find(const K& key) const { return find_iterator(key); }
+        template<typename Key> requires detail::transparent_hash<Hash, KeyEqual>
+        iterator find(const Key& key) { return find_iterator(key); }
+        template<typename Key> requires detail::transparent_hash<Hash, KeyEqual>
+        const_iterator find(const Key& key) const { return find_iterator(key); }
+
+        bool contains(const K& key) const { return find_index(key) != npos; }
+        template<typename Key> requires detail::transparent_hash<Hash, KeyEqual>
+        bool contains(const Key& key) const { return find_index(key) != npos; }
+
+        size_t count(const K& key) const { return contains(key) ? 1 : 0; }
+        template<typename Key> requires detail::transparent_hash<Hash, KeyEqual>
+        size_t count(const Key& key) const { return contains(key) ? 1 : 0; }
+
+        void erase(const_iterator pos) { erase_at(static_cast<size_t>(pos._ctrl - _ctrl)); }
+        size_t erase(const K& key) { return erase_key(key); }
+        template<typename Key>
+            requires detail::transparent_hash<Hash, KeyEqual> && (!std::convertible_to<const Key&, const_iterator>)
+        size_t erase(const Key& key) { return erase_key(key); }
+
+        // Sizes the table for n elements, so inserting up to n never rehashes.
+        void reserve(size_t n) {
+            size_t needed = capacity_for(n);
+            if (needed > _capacity) rehash(needed);
+        }
+        void clear() noexcept {
+            destroy_slots();
+            if (_capacity > 0) {
+                std::memset(_ctrl, static_cast<int8_t>(detail::ctrl_t::empty), _capacity);
+                _growth_left = max_load(_capacity);
+            }
+            _size = 0;
+        }
+
+        size_t size() const noexcept { return _size; }
+        bool empty() const noexcept { return _size == 0; }
+        size_t capacity() const noexcept { return _capacity; }
+        float load_factor() const noexcept { return _capacity == 0 ? 0.0f : static_cast<float>(_size) / _capacity; }
+        hasher hash_function() const { return _hash; }
+        key_equal key_eq() const { return _eq; }
+        allocator_type get_allocator() const { return allocator_type(_allocator); }
+
+        iterator begin() noexcept {
+            iterator it = iterator_at(0);
+            it.skip_free();
+            return it;
+        }
+        iterator end() noexcept { return iterator_at(_capacity); }
+        const_iterator begin() const noexcept {
+            const_iterator it = iterator_at(0);
+            it.skip_free();
+            return it;
+        }
+        const_iterator end() const noexcept { return iterator_at(_capacity); }
+        const_iterator cbegin() const noexcept { return begin(); }
+        const_iterator cend() const noexcept { return end(); }
+
+    private:
+        static constexpr size_t npos = ~size_t{0};
+
+        // At most 7/8 of the slots are ever full, which keeps probe sequences short.
+        static constexpr size_t max_load(size_t capacity) noexcept { return capacity - capacity / 8; }
+        static size_t capacity_for(size_t n) noexcept {
+            if (n == 0) return 0;
+            size_t slots = n + (n + 6) / 7;
+            return std::bit_ceil(slots < detail::group_width ? detail::group_width : slots);
+        }
+        static size_t slots_offset(size_t capacity) noexcept {
+            return (capacity + alignof(slot_type) - 1) & ~(alignof(slot_type) - 1);
+        }
+        static size_t block_bytes(size_t capacity) noexcept {
+            return slots_offset(capacity) + capacity * sizeof(slot_type);
+        }
+
+        iterator iterator_at(size_t i) noexcept { return {_ctrl + i, _ctrl + _capacity, _slots + i}; }
+        const_iterator iterator_at(size_t i) const noexcept { return {_ctrl + i, _ctrl + _capacity, _slots + i}; }
+
+        template<typename Key>
+        uint64_t hash_of(const Key& key) const {
+            return detail::mix_hash(static_cast<uint64_t>(_hash(key)));
+        }
+        static int8_t tag(uint64_t hash) noexcept { return static_cast<int8_t>(hash & 0x7F); }
+        size_t group_mask() const noexcept { return _capacity == 0 ? 0 : _capacity / detail::group_width - 1; }
+
+        // Triangular steps over a power-of-two number of groups visit every group once.
+        template<typename Key>
+        size_t find_index(const Key& key) const { return find_index(key, hash_of(key)); }
+        template<typename Key>
+        size_t find_index(const Key& key, uint64_t hash) const {
+            int8_t h2 = tag(hash);
+            size_t mask = group_mask();
+            size_t g = static_cast<size_t>(hash >> 7) & mask;
+            for (size_t step = 1;; ++step) {
+                detail::ctrl_group group(_ctrl + g * detail::group_width);
+                for (uint32_t m = group.match(h2); m != 0; m &= m - 1) {
+                    size_t i = g * detail::group_width + static_cast<size_t>(std::countr_zero(m));
+                    if (_eq(_slots[i].first, key)) [[likely]] return i;
+                }
+                if (group.match_empty() != 0) [[likely]] return npos;
+                g = (g + step) & mask;
+            }
+        }
+        // First free slot on the key's probe sequence; the table must have one.
+        size_t find_free(uint64_t hash) const noexcept {
+            size_t mask = group_mask();
+            size_t g = static_cast<size_t>(hash >> 7) & mask;
+            for (size_t step = 1;; ++step) {
+                uint32_t m = detail::ctrl_group(_ctrl + g * detail::group_width).match_free();
+                if (m != 0) return g * detail::group_width + static_cast<size_t>(std::countr_zero(m));
+                g = (g + step) & mask;
+            }
+        }
+
+        template<typename Key>
+        probe_result find_or_prepare_insert(const Key& key) {
+            uint64_t hash = hash_of(key);
+            size_t i = find_index(key, hash);
+            if (i != npos) return {i, true, tag(hash)};
+            i = find_free(hash);
+            // Reusing a tombstone costs no growth; only turning an empty slot full does.
+            if (_growth_left == 0 && _ctrl[i] != static_cast<int8_t>(detail::ctrl_t::deleted)) [[unlikely]] {
+                grow();
+                i = find_free(hash);
+            }
+            return {i, false, tag(hash)};
+        }
+
+        template<typename... Args>
+        void construct_at(probe_result at, Args&&... args) {
+            ::new (static_cast<void*>(_slots + at.index)) slot_type(std::forward<Args>(args)...);
+            if (_ctrl[at.index] == static_cast<int8_t>(detail::ctrl_t::empty)) --_growth_left;
+            _ctrl[at.index] = at.tag;
+            ++_size;
+        }
+
+        template<typename Key>
+        iterator find_iterator(const Key& key) {
+            size_t i = find_index(key);
+            return i == npos ? end() : iterator_at(i);
+        }
+        template<typename Key>
+        const_iterator find_iterator(const Key& key) const {
+            size_t i = find_index(key);
+            return i == npos ? end() : iterator_at(i);
+        }
+        template<typename Key>
+        size_t index_of(const Key& key) const {
+            size_t i = find_index(key);
+            if (i == npos) [[unlikely]] {
+                throw std::out_of_range("Error: Key not found");
+            }
+            return i;
+        }
+        template<typename Key>
+        size_t erase_key(const Key& key) {
+            size_t i = find_index(key);
+            if (i == npos) return 0;
+            erase_at(i);
+            return 1;
+        }
+
+        // A probe only ever moves past a group with no empty slot. If the group
+        // still has one, no probe can have passed through it since the last rehash,
+        // so the slot can become empty instead of a tombstone.
+        void erase_at(size_t i) {
+            _slots[i].~slot_type();
+            --_size;
+            size_t group_start = i & ~(detail::group_width - 1);
+            if (detail::ctrl_group(_ctrl + group_start).match_empty() != 0) {
+                _ctrl[i] = static_cast<int8_t>(detail::ctrl_t::empty);
+                ++_growth_left;
+            } else {
+                _ctrl[i] = static_cast<int8_t>(detail::ctrl_t::deleted);
+            }
+        }
+
+        // Doubles the table, or rebuilds it at the same size when tombstones rather
+        // than elements have used up the free slots.
+        void grow() {
+            if (_capacity > 0 && _size < max_load(_capacity) / 2) {
+                rehash(_capacity);
+            } else {
+                rehash(_capacity == 0 ? detail::group_width : _capacity * 2);
+            }
+        }
+
+        void rehash(size_t new_capacity) {
+            int8_t* old_ctrl = _ctrl;
+            slot_type* old_slots = _slots;
+            size_t old_capacity = _capacity;
+
+            allocate(new_capacity);
+            for (size_t i = 0; i < old_capacity; ++i) {
+                if (old_ctrl[i] < 0) continue;
+                uint64_t hash = hash_of(old_slots[i].first);
+                size_t j = find_free(hash);
+                _ctrl[j] = tag(hash);
+                if constexpr (is_trivially_relocatable_v<slot_type>) {
+                    std::memcpy(static_cast<void*>(_slots + j), static_cast<const void*>(old_slots + i), sizeof(slot_type));
+                } else {
+                    ::new (static_cast<void*>(_slots + j)) slot_type(std::move(old_slots[i]));
+                    old_slots[i].~slot_type();
+                }
+            }
+            _growth_left = max_load(new_capacity) - _size;
+            if (old_capacity > 0) {
+                alloc_traits::deallocate(_allocator, reinterpret_cast<std::byte*>(old_ctrl), block_bytes(old_capacity));
+            }
+        }
+
+        // Points the table at a fresh block with every slot empty; sizes are left alone.
+        void allocate(size_t capacity) {
+            std::byte* block = alloc_traits::allocate(_allocator, block_bytes(capacity));
+            _ctrl = reinterpret_cast<int8_t*>(block);
+            _slots = reinterpret_cast<slot_type*>(block + slots_offset(capacity));
+            _capacity = capacity;
+            std::memset(_ctrl, static_cast<int8_t>(detail::ctrl_t::empty), capacity);
+        }
+
+        void release() noexcept {
+            if (_capacity > 0) {
+                alloc_traits::deallocate(_allocator, reinterpret_cast<std::byte*>(_ctrl), block_bytes(_capacity));
+            }
+            reset();
+        }
+        void reset() noexcept {
+            _ctrl = const_cast<int8_t*>(detail::empty_group);
+            _slots = nullptr;
+            _capacity = 0;
+            _size = 0;
+            _growth_left = 0;
+        }
+
+        void destroy_slots() noexcept {
+            if constexpr (!std::is_trivially_destructible_v<slot_type>) {
+                for (size_t i = 0; i < _capacity; ++i) {
+                    if (_ctrl[i] >= 0) _slots[i].~slot_type();
+                }
+            }
+        }
+
+        // Same capacity and layout, so every element keeps its slot.
+        void copy_from(const hash_map& other) {
+            if (other._size == 0) return;
+            allocate(other._capacity);
+            size_t i = 0;
+            try {
+                for (; i < _capacity; ++i) {
+                    if (other._ctrl[i] >= 0) ::new (static_cast<void*>(_slots + i)) slot_type(other._slots[i]);
+                    _ctrl[i] = other._ctrl[i];
+                }
+            } catch (...) {
+                std::memset(_ctrl + i, static_cast<int8_t>(detail::ctrl_t::empty), _capacity - i);
+                destroy_slots();
+                release();
+                throw;
+            }
+            _size = other._size;
+            _growth_left = other._growth_left;
+        }
+
+        // Everything but the allocator.
+        void swap_contents(hash_map& other) noexcept {
+            using std::swap;
+            swap(_hash, other._hash);
+            swap(_eq, other._eq);
+            swap(_ctrl, other._ctrl);
+            swap(_slots, other._slots);
+            swap(_capacity, other._capacity);
+            swap(_size, other._size);
+            swap(_growth_left, other._growth_left);
+        }
+
+        void steal(hash_map& other) noexcept {
+            _ctrl = other._ctrl;
+            _slots = other._slots;
+            _capacity = other._capacity;
+            _size = other._size;
+            _growth_left = other._growth_left;
+            other.reset();
+        }
+
+        int8_t* _ctrl = const_cast<int8_t*>(detail::empty_group);
+        slot_type* _slots = nullptr;
+        size_t _capacity = 0;
+        size_t _size = 0;
+        size_t _growth_left = 0;
+        [[no_unique_address]] byte_allocator _allocator;
+        [[no_unique_address]] Hash _hash;
+        [[no_unique_address]] KeyEqual _eq;
+    };
+}
+
+#undef NSTL_HASH_MAP_SSE2
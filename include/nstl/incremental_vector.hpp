@@ -0,0 +1,297 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <algorithm>
+#include <compare>
+#include <nstl/type_traits.hpp>
+
+namespace nstl {
+    // Append-oriented vector without the O(n) reallocation spike. When it runs out of
+    // room it allocates the larger block but leaves the elements where they are; every
+    // later push_back/emplace_back then relocates migration_step of them across. With
+    // doubling growth the old block is drained after half of the new capacity has been
+    // appended, long before the next growth.
+    //
+    // Elements [0, pending) still live in the old block and the rest in the new one,
+    // so indexing stays a single compare. Worst case per append is one allocation plus
+    // migration_step relocations. data(), reserve() and shrink_to_fit() need a single
+    // block and finish any migration in flight first.
+    template<typename T, typename Alloc = std::allocator<T>>
+    class incremental_vector{
+        using alloc_traits = std::allocator_traits<Alloc>;
+
+        template<bool Const>
+        class basic_iterator {
+            using owner_type = std::conditional_t<Const, const incremental_vector, incremental_vector>;
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using reference = std::conditional_t<Const, const T&, T&>;
+            using pointer = std::conditional_t<Const, const T*, T*>;
+
+            basic_iterator() noexcept = default;
+            basic_iterator(owner_type* owner, size_t idx) noexcept : _owner(owner), _idx(idx) {}
+            operator basic_iterator<true>() const noexcept { return {_owner, _idx}; }
+
+            reference operator*() const noexcept { return (*_owner)[_idx]; }
+            pointer operator->() const noexcept { return &(*_owner)[_idx]; }
+            reference operator[](difference_type n) const noexcept { return (*_owner)[_idx + n]; }
+
+            basic_iterator& operator++() noexcept { ++_idx; return *this; }
+            basic_iterator operator++(int) noexcept { auto tmp = *this; ++_idx; return tmp; }
+            basic_iterator& operator--() noexcept { --_idx; return *this; }
+            basic_iterator operator--(int) noexcept { auto tmp = *this; --_idx; return tmp; }
+            basic_iterator& operator+=(difference_type n) noexcept { _idx += n; return *this; }
+            basic_iterator& operator-=(difference_type n) noexcept { _idx -= n; return *this; }
+
+            friend basic_iterator operator+(basic_iterator it, difference_type n) noexcept { return it += n; }
+            friend basic_iterator operator+(difference_type n, basic_iterator it) noexcept { return it += n; }
+            friend basic_iterator operator-(basic_iterator it, difference_type n) noexcept { return it -= n; }
+            friend difference_type operator-(const basic_iterator& a, const basic_iterator& b) noexcept {
+                return static_cast<difference_type>(a._idx) - static_cast<difference_type>(b._idx);
+            }
+            friend bool operator==(const basic_iterator& a, const basic_iterator& b) noexcept { return a._idx == b._idx; }
+            friend auto operator<=>(const basic_iterator& a, const basic_iterator& b) noexcept { return a._idx <=> b._idx; }
+
+        private:
+            owner_type* _owner = nullptr;
+            size_t _idx = 0;
+        };
+
+    public:
+        using value_type = T;
+        using allocator_type = Alloc;
+        using iterator = basic_iterator<false>;
+        using const_iterator = basic_iterator<true>;
+
+        // Elements relocated out of the old block per append while a migration is in flight.
+        static constexpr size_t migration_step = 2;
+
+        incremental_vector() noexcept(noexcept(Alloc())) = default;
+        explicit incremental_vector(const Alloc& alloc) noexcept : _allocator(alloc) {}
+        ~incremental_vector() {
+            release();
+        }
+        incremental_vector(const incremental_vector& other)
+            : _allocator(alloc_traits::select_on_container_copy_construction(other._allocator)) {
+            copy_from(other);
+        }
+        incremental_vector(incremental_vector&& other) noexcept : _allocator(std::move(other._allocator)) {
+            steal(other);
+        }
+        incremental_vector& operator=(const incremental_vector& other) {
+            if (this == &other) return *this;
+            release();
+            if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+                _allocator = other._allocator;
+            }
+            copy_from(other);
+            return *this;
+        }
+        incremental_vector& operator=(incremental_vector&& other) noexcept {
+            static_assert(alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value,
+                          "incremental_vector move assignment needs a propagating or always-equal allocator");
+            if (this == &other) return *this;
+            release();
+            if constexpr (alloc_traits::propagate_on_container_move_assignment::value) {
+                _allocator = std::move(other._allocator);
+            }
+            steal(other);
+            return *this;
+        }
+
+        allocator_type get_allocator() const noexcept { return _allocator; }
+
+        void push_back(const T& value) { emplace_back(value); }
+        void push_back(T&& value) { emplace_back(std::move(value)); }
+
+        template<typename... Args>
+        T& emplace_back(Args&&... args) {
+            if (_length == _capacity) [[unlikely]] {
+                grow();
+            }
+            // Growth leaves the old elements in place, so args that refer to one stay valid.
+            T* slot = &_data[_length];
+            alloc_traits::construct(_allocator, slot, std::forward<Args>(args)...);
+            _length++;
+            if (_pending) [[unlikely]] {
+                migrate(migration_step);
+            }
+            return *slot;
+        }
+
+        void pop_back() {
+            if (_length == 0) [[unlikely]] {
+                throw std::out_of_range("Error: Cannot pop_back when Vector is Empty");
+            }
+            _length--;
+            alloc_traits::destroy(_allocator, &(*this)[_length]);
+            if (_length < _pending) {
+                _pending = _length;
+                if (_pending == 0) release_old();
+            }
+        }
+
+        void clear() noexcept {
+            if constexpr (!std::is_trivially_destructible_v<T>) {
+                for (size_t i = 0; i < _length; ++i) {
+                    alloc_traits::destroy(_allocator, &(*this)[i]);
+                }
+            }
+            _length = 0;
+            _pending = 0;
+            release_old();
+        }
+
+        const T& operator[](size_t idx) const noexcept {
+            return idx < _pending ? _old[idx] : _data[idx];
+        }
+        T& operator[](size_t idx) noexcept {
+            return idx < _pending ? _old[idx] : _data[idx];
+        }
+
+        const T& at(size_t idx) const {
+            if (idx >= _length) [[unlikely]] {
+                throw std::out_of_range("Error: Index out of bounds");
+            }
+            return (*this)[idx];
+        }
+        T& at(size_t idx) {
+            if (idx >= _length) [[unlikely]] {
+                throw std::out_of_range("Error: Index out of bounds");
+            }
+            return (*this)[idx];
+        }
+
+        // Contiguous view of the elements; completes a pending migration (O(pending)).
+        T* data() {
+            finish_migration();
+            return _data;
+        }
+
+        size_t size() const noexcept { return _length; }
+        bool empty() const noexcept { return _length == 0; }
+        size_t capacity() const noexcept { return _capacity; }
+        // Number of elements still waiting in the old block.
+        size_t pending() const noexcept { return _pending; }
+
+        void reserve(size_t new_capacity) {
+            if (new_capacity <= _capacity) return;
+            finish_migration();
+            reallocate(new_capacity);
+        }
+
+        void shrink_to_fit() {
+            if (_length == _capacity) return;
+            finish_migration();
+            reallocate(_length);
+        }
+
+        void finish_migration() {
+            if (_pending) migrate(_pending);
+        }
+
+        iterator begin() noexcept { return {this, 0}; }
+        iterator end() noexcept { return {this, _length}; }
+        const_iterator begin() const noexcept { return {this, 0}; }
+        const_iterator end() const noexcept { return {this, _length}; }
+        const_iterator cbegin() const noexcept { return {this, 0}; }
+        const_iterator cend() const noexcept { return {this, _length}; }
+
+    private:
+        [[no_unique_address]] Alloc _allocator;
+        size_t _capacity = 0;
+        size_t _length = 0;
+        T* _data = nullptr;
+        // Block being drained: elements [0, _pending) still live here.
+        T* _old = nullptr;
+        size_t _old_capacity = 0;
+        size_t _pending = 0;
+
+        // Switches to a block twice the size without moving anything. The previous
+        // migration has always finished by now: it needed half as many appends.
+        void grow() {
+            size_t new_capacity = _capacity ? _capacity * 2 : 8;
+            T* new_data = alloc_traits::allocate(_allocator, new_capacity);
+            if (_length > 0) {
+                _old = _data;
+                _old_capacity = _capacity;
+                _pending = _length;
+            } else if (_data) {
+                alloc_traits::deallocate(_allocator, _data, _capacity);
+            }
+            _data = new_data;
+            _capacity = new_capacity;
+        }
+
+        // Relocates up to count elements from the top of the pending range.
+        void migrate(size_t count) {
+            count = std::min(count, _pending);
+            _pending -= count;
+            relocate(_old + _pending, count, _data + _pending);
+            if (_pending == 0) release_old();
+        }
+
+        void reallocate(size_t new_capacity) {
+            T* new_data = new_capacity ? alloc_traits::allocate(_allocator, new_capacity) : nullptr;
+            relocate(_data, _length, new_data);
+            if (_data) alloc_traits::deallocate(_allocator, _data, _capacity);
+            _data = new_data;
+            _capacity = new_capacity;
+        }
+
+        void relocate(T* first, size_t count, T* dest) {
+            if constexpr (is_trivially_relocatable_v<T>) {
+                if (count > 0) std::memcpy(static_cast<void*>(dest), static_cast<const void*>(first), count * sizeof(T));
+            } else {
+                for (size_t i = 0; i < count; ++i) {
+                    alloc_traits::construct(_allocator, &dest[i], std::move(first[i]));
+                    alloc_traits::destroy(_allocator, &first[i]);
+                }
+            }
+        }
+
+        void release_old() noexcept {
+            if (_old) {
+                alloc_traits::deallocate(_allocator, _old, _old_capacity);
+                _old = nullptr;
+                _old_capacity = 0;
+            }
+        }
+
+        void release() noexcept {
+            clear();
+            if (_data) alloc_traits::deallocate(_allocator, _data, _capacity);
+            _data = nullptr;
+            _capacity = 0;
+        }
+
+        void copy_from(const incremental_vector& other) {
+            if (other._length == 0) return;
+            _data = alloc_traits::allocate(_allocator, other._length);
+            _capacity = other._length;
+            for (; _length < other._length; ++_length) {
+                alloc_traits::construct(_allocator, &_data[_length], other[_length]);
+            }
+        }
+
+        void steal(incremental_vector& other) noexcept {
+            _data = std::exchange(other._data, nullptr);
+            _capacity = std::exchange(other._capacity, 0);
+            _length = std::exchange(other._length, 0);
+            _old = std::exchange(other._old, nullptr);
+            _old_capacity = std::exchange(other._old_capacity, 0);
+            _pending = std::exchange(other._pending, 0);
+        }
+    };
+
+    template<typename T, typename Alloc>
+    struct is_trivially_relocatable<incremental_vector<T, Alloc>> : is_trivially_relocatable<Alloc> {};
+}
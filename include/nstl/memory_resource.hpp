@@ -0,0 +1,416 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <nstl/per_thread.hpp>
+#include <nstl/unique_ptr.hpp>
+
+namespace nstl {
+    // nstl's resources are std::pmr resources, so they plug into nstl::pmr::vector,
+    // the std::pmr containers and allocate_unique alike.
+    using memory_resource = std::pmr::memory_resource;
+
+    namespace detail {
+        inline std::byte* align_up(std::byte* p, size_t alignment) noexcept {
+            auto v = reinterpret_cast<uintptr_t>(p);
+            return p + (((v + alignment - 1) & ~(alignment - 1)) - v);
+        }
+    }
+
+    // Bump allocator over a list of chunks. deallocate() does nothing; memory comes
+    // back all at once through rewind() or release(), which only move the cursor,
+    // and the chunks stay around for the next event. Not thread-safe.
+    //
+    //     auto start = arena.mark();
+    //     handle(event, arena);   // every per-event allocation comes from arena
+    //     arena.rewind(start);    // O(1), whatever was allocated
+    class monotonic_arena : public memory_resource {
+        struct chunk {
+            chunk* next;
+            size_t bytes; // including this header
+            bool owned;
+        };
+        static constexpr size_t header_size =
+            (sizeof(chunk) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+        static constexpr size_t max_chunk_size = size_t(64) << 20;
+
+    public:
+        // Where the arena stood at mark(); rewind() frees everything allocated since.
+        struct rewind_point {
+            chunk* current;
+            std::byte* cursor;
+        };
+
+        explicit monotonic_arena(size_t initial_chunk = size_t(64) << 10,
+                                 memory_resource* upstream = std::pmr::new_delete_resource()) noexcept
+            : _upstream(upstream), _next_chunk_size(std::max(initial_chunk, 4 * header_size)) {}
+
+        // Starts in buffer, which the arena never frees, and grows from upstream.
+        monotonic_arena(void* buffer, size_t bytes, memory_resource* upstream = std::pmr::new_delete_resource()) noexcept
+            : monotonic_arena(std::max(bytes, size_t(4096)), upstream) {
+            std::byte* start = detail::align_up(static_cast<std::byte*>(buffer), alignof(std::max_align_t));
+            size_t skipped = static_cast<size_t>(start - static_cast<std::byte*>(buffer));
+            if (bytes > skipped + header_size) {
+                _head = ::new (static_cast<void*>(start)) chunk{nullptr, bytes - skipped, false};
+                enter(_head);
+            }
+        }
+
+        monotonic_arena(const monotonic_arena&) = delete;
+        monotonic_arena& operator=(const monotonic_arena&) = delete;
+
+        ~monotonic_arena() override {
+            for (chunk* c = _head; c;) {
+                chunk* next = c->next;
+                if (c->owned) _upstream->deallocate(c, c->bytes, alignof(std::max_align_t));
+                c = next;
+            }
+        }
+
+        rewind_point mark() const noexcept { return {_current, _cursor}; }
+
+        // Everything allocated after p is gone; the chunks are kept for reuse.
+        void rewind(rewind_point p) noexcept {
+            _current = p.current;
+            _cursor = p.cursor;
+            _end = _current ? end_of(_current) : nullptr;
+        }
+        // Back to empty, keeping every chunk.
+        void release() noexcept { rewind({}); }
+
+        // Returns the chunks past the current one to upstream.
+        void shrink_to_fit() noexcept {
+            chunk** link = _current ? &_current->next : &_head;
+            for (chunk* c = *link; c;) {
+                chunk* next = c->next;
+                if (c->owned) {
+                    _upstream->deallocate(c, c->bytes, alignof(std::max_align_t));
+                } else {
+                    *link = c;
+                    link = &c->next;
+                }
+                c = next;
+            }
+            *link = nullptr;
+        }
+
+        // Bytes held in chunks, used or not.
+        size_t capacity() const noexcept {
+            size_t total = 0;
+            for (chunk* c = _head; c; c = c->next) total += c->bytes - header_size;
+            return total;
+        }
+
+        memory_resource* upstream_resource() const noexcept { return _upstream; }
+
+    protected:
+        void* do_allocate(size_t bytes, size_t alignment) override {
+            std::byte* p = detail::align_up(_cursor, alignment);
+            if (_cursor && static_cast<size_t>(_end - p) >= bytes && p <= _end) [[likely]] {
+                _cursor = p + bytes;
+                return p;
+            }
+            return allocate_slow(bytes, alignment);
+        }
+        void do_deallocate(void*, size_t, size_t) override {}
+        bool do_is_equal(const memory_resource& other) const noexcept override { return this == &other; }
+
+    private:
+        static std::byte* begin_of(chunk* c) noexcept { return reinterpret_cast<std::byte*>(c) + header_size; }
+        static std::byte* end_of(chunk* c) noexcept { return reinterpret_cast<std::byte*>(c) + c->bytes; }
+
+        void enter(chunk* c) noexcept {
+            _current = c;
+            _cursor = begin_of(c);
+            _end = end_of(c);
+        }
+
+        static bool fits(chunk* c, size_t bytes, size_t alignment) noexcept {
+            std::byte* p = detail::align_up(begin_of(c), alignment);
+            return p <= end_of(c) && static_cast<size_t>(end_of(c) - p) >= bytes;
+        }
+
+        // The current chunk is full: move on to a kept chunk that fits, or add one
+        // right after the current chunk.
+        void* allocate_slow(size_t bytes, size_t alignment) {
+            chunk* next = _current ? _current->next : _head;
+            for (; next; next = next->next) {
+                if (fits(next, bytes, alignment)) {
+                    enter(next);
+                    return do_allocate(bytes, alignment);
+                }
+            }
+            size_t needed = header_size + bytes + (alignment > alignof(std::max_align_t) ? alignment : 0);
+            size_t size = std::max(_next_chunk_size, needed);
+            auto* c = static_cast<chunk*>(_upstream->allocate(size, alignof(std::max_align_t)));
+            ::new (static_cast<void*>(c)) chunk{nullptr, size, true};
+            if (_current) {
+                c->next = _current->next;
+                _current->next = c;
+            } else {
+                c->next = _head;
+                _head = c;
+            }
+            _next_chunk_size = std::min(_next_chunk_size * 2, max_chunk_size);
+            enter(c);
+            return do_allocate(bytes, alignment);
+        }
+
+        memory_resource* _upstream;
+        size_t _next_chunk_size;
+        chunk* _head = nullptr;
+        chunk* _current = nullptr;
+        std::byte* _cursor = nullptr;
+        std::byte* _end = nullptr;
+    };
+
+    // Rewinds the arena to where it was when the scope began.
+    class arena_scope {
+    public:
+        explicit arena_scope(monotonic_arena& arena) noexcept : _arena(arena), _mark(arena.mark()) {}
+        ~arena_scope() { _arena.rewind(_mark); }
+        arena_scope(const arena_scope&) = delete;
+        arena_scope& operator=(const arena_scope&) = delete;
+
+    private:
+        monotonic_arena& _arena;
+        monotonic_arena::rewind_point _mark;
+    };
+
+    // Power-of-two size classes from 8 bytes to max_block, each with an intrusive
+    // free list. Blocks are carved from chunks taken from upstream and go back on
+    // their list when freed, so steady-state allocation is a pointer pop. Bigger or
+    // over-aligned requests pass straight through to upstream. Not thread-safe.
+    class pool_resource : public memory_resource {
+        struct free_block {
+            free_block* next;
+        };
+        struct chunk {
+            chunk* next;
+            size_t bytes;
+        };
+        static constexpr size_t min_block = 8;
+        static constexpr size_t max_classes = 16; // up to 256 KB blocks
+        static constexpr size_t chunk_alignment = 64;
+
+    public:
+        explicit pool_resource(size_t max_block = 1024, memory_resource* upstream = std::pmr::new_delete_resource()) noexcept
+            : _upstream(upstream),
+              _max_block(std::clamp(std::bit_ceil(max_block), min_block, min_block << (max_classes - 1))) {}
+
+        pool_resource(const pool_resource&) = delete;
+        pool_resource& operator=(const pool_resource&) = delete;
+
+        ~pool_resource() override { release(); }
+
+        // Returns every chunk to upstream, freeing all blocks at once.
+        void release() noexcept {
+            for (chunk* c = _chunks; c;) {
+                chunk* next = c->next;
+                _upstream->deallocate(c, c->bytes, chunk_alignment);
+                c = next;
+            }
+            _chunks = nullptr;
+            _cursor = _end = nullptr;
+            std::fill(std::begin(_free), std::end(_free), nullptr);
+        }
+
+        size_t max_block() const noexcept { return _max_block; }
+        memory_resource* upstream_resource() const noexcept { return _upstream; }
+
+        // Size class of a request, or -1 when upstream serves it.
+        int size_class(size_t bytes, size_t alignment) const noexcept {
+            size_t size = std::max({bytes, alignment, min_block});
+            if (size > _max_block || alignment > chunk_alignment) return -1;
+            return std::bit_width(size - 1) - 3;
+        }
+        static constexpr size_t class_size(int c) noexcept { return min_block << c; }
+
+    protected:
+        void* do_allocate(size_t bytes, size_t alignment) override {
+            int c = size_class(bytes, alignment);
+            if (c < 0) [[unlikely]] return _upstream->allocate(bytes, alignment);
+            if (free_block* b = _free[c]) [[likely]] {
+                _free[c] = b->next;
+                return b;
+            }
+            return carve(class_size(c));
+        }
+        void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+            int c = size_class(bytes, alignment);
+            if (c < 0) [[unlikely]] {
+                _upstream->deallocate(p, bytes, alignment);
+                return;
+            }
+            _free[c] = ::new (p) free_block{_free[c]};
+        }
+        bool do_is_equal(const memory_resource& other) const noexcept override { return this == &other; }
+
+    private:
+        // Blocks of a power-of-two size are aligned to that size, up to a cache line.
+        void* carve(size_t size) {
+            std::byte* p = detail::align_up(_cursor, std::min(size, chunk_alignment));
+            if (!_cursor || p > _end || static_cast<size_t>(_end - p) < size) {
+                size_t bytes = std::max(_next_chunk_size, size + chunk_alignment);
+                auto* c = static_cast<chunk*>(_upstream->allocate(bytes, chunk_alignment));
+                *c = chunk{_chunks, bytes};
+                _chunks = c;
+                _next_chunk_size = std::min(_next_chunk_size * 2, size_t(1) << 20);
+                _cursor = reinterpret_cast<std::byte*>(c) + chunk_alignment;
+                _end = reinterpret_cast<std::byte*>(c) + bytes;
+                p = detail::align_up(_cursor, std::min(size, chunk_alignment));
+            }
+            _cursor = p + size;
+            return p;
+        }
+
+        memory_resource* _upstream;
+        size_t _max_block;
+        size_t _next_chunk_size = size_t(16) << 10;
+        free_block* _free[max_classes] = {};
+        chunk* _chunks = nullptr;
+        std::byte* _cursor = nullptr;
+        std::byte* _end = nullptr;
+    };
+
+    // Thread-safe pool: each thread keeps its own free lists, so allocate and
+    // deallocate take no lock until a thread's list runs dry (it then takes a batch
+    // from a shared, locked pool_resource) or overflows (it gives half back). A block
+    // may be freed by any thread. A thread's cache returns to the shared pool when the
+    // thread exits, and everything is released when the resource is destroyed, which
+    // must not race with other threads still using it.
+    class thread_cache_resource : public memory_resource {
+        struct free_block {
+            free_block* next;
+        };
+        struct cache {
+            free_block* lists[16] = {};
+            uint32_t counts[16] = {};
+        };
+        struct shared_pool {
+            shared_pool(size_t max_block, memory_resource* upstream) : pool(max_block, upstream) {}
+
+            pool_resource pool;
+
+            void give_back(free_block* b, int c) noexcept {
+                pool.deallocate(b, pool_resource::class_size(c), alignof(std::max_align_t));
+            }
+            void flush(cache& local) noexcept {
+                for (int c = 0; c < 16; ++c) {
+                    while (free_block* b = local.lists[c]) {
+                        local.lists[c] = b->next;
+                        give_back(b, c);
+                    }
+                    local.counts[c] = 0;
+                }
+            }
+        };
+
+    public:
+        explicit thread_cache_resource(size_t max_block = 1024, size_t blocks_per_class = 64,
+                                       memory_resource* upstream = std::pmr::new_delete_resource())
+            : _caches(max_block, upstream),
+              _limit(static_cast<uint32_t>(std::max<size_t>(blocks_per_class, 2))),
+              _upstream(upstream) {}
+
+        thread_cache_resource(const thread_cache_resource&) = delete;
+        thread_cache_resource& operator=(const thread_cache_resource&) = delete;
+
+        ~thread_cache_resource() override {
+            _caches.shutdown([](shared_pool& shared) noexcept { shared.pool.release(); });
+        }
+
+        memory_resource* upstream_resource() const noexcept { return _upstream; }
+
+    protected:
+        void* do_allocate(size_t bytes, size_t alignment) override {
+            int c = _caches.shared().pool.size_class(bytes, alignment);
+            if (c < 0) [[unlikely]] return _upstream->allocate(bytes, alignment);
+            cache& local = _caches.local();
+            if (free_block* b = local.lists[c]) [[likely]] {
+                local.lists[c] = b->next;
+                --local.counts[c];
+                return b;
+            }
+            return refill(local, c);
+        }
+        // Does not throw: a thread whose cache cannot be created frees straight into
+        // the shared pool.
+        void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+            int c = _caches.shared().pool.size_class(bytes, alignment);
+            if (c < 0) [[unlikely]] {
+                _upstream->deallocate(p, bytes, alignment);
+                return;
+            }
+            cache* local = _caches.try_local();
+            if (!local) [[unlikely]] {
+                std::lock_guard lock(_caches.mutex());
+                _caches.shared().give_back(static_cast<free_block*>(p), c);
+                return;
+            }
+            local->lists[c] = ::new (p) free_block{local->lists[c]};
+            if (++local->counts[c] > _limit) [[unlikely]] drain(*local, c, _limit / 2);
+        }
+        bool do_is_equal(const memory_resource& other) const noexcept override { return this == &other; }
+
+    private:
+        // Takes half a cache's worth of blocks from the shared pool in one lock.
+        void* refill(cache& local, int c) {
+            size_t size = pool_resource::class_size(c);
+            uint32_t batch = _limit / 2;
+            std::lock_guard lock(_caches.mutex());
+            pool_resource& pool = _caches.shared().pool;
+            for (uint32_t i = 1; i < batch; ++i) {
+                local.lists[c] = ::new (pool.allocate(size, alignof(std::max_align_t))) free_block{local.lists[c]};
+                ++local.counts[c];
+            }
+            return pool.allocate(size, alignof(std::max_align_t));
+        }
+
+        void drain(cache& local, int c, uint32_t keep) noexcept {
+            std::lock_guard lock(_caches.mutex());
+            while (local.counts[c] > keep) {
+                free_block* b = local.lists[c];
+                local.lists[c] = b->next;
+                --local.counts[c];
+                _caches.shared().give_back(b, c);
+            }
+        }
+
+        detail::per_thread_caches<cache, shared_pool> _caches;
+        uint32_t _limit;
+        memory_resource* _upstream;
+    };
+
+    // Deleter for objects placed in a memory_resource: destroys the object and hands
+    // its bytes back to the resource it came from.
+    template<typename T>
+    struct resource_deleter {
+        memory_resource* resource = nullptr;
+
+        void operator()(T* p) const {
+            p->~T();
+            resource->deallocate(p, sizeof(T), alignof(T));
+        }
+    };
+
+    // make_unique whose storage comes from resource instead of operator new.
+    template<typename T, typename... Args>
+    requires Scalar<T>
+    unique_ptr<T, resource_deleter<T>> allocate_unique(memory_resource* resource, Args&&... args) {
+        void* p = resource->allocate(sizeof(T), alignof(T));
+        try {
+            return unique_ptr<T, resource_deleter<T>>(::new (p) T(std::forward<Args>(args)...), resource_deleter<T>{resource});
+        } catch (...) {
+            resource->deallocate(p, sizeof(T), alignof(T));
+            throw;
+        }
+    }
+}
@@ -0,0 +1,297 @@
+#pragma once
+
+#if defined(__linux__)
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <algorithm>
+#include <functional>
+#include <nstl/span.hpp>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace nstl {
+    enum class open_mode {
+        read_write, // created if missing; appends grow the file
+        read_only,  // the file must exist; only the read side is usable
+    };
+
+    // vector of trivially copyable T whose elements live in a shared file mapping.
+    //
+    // The file holds a 64-byte header (magic, element size, count) followed by the
+    // raw elements, so reopening it is an open plus an mmap: no parsing and no
+    // copying, only page faults as the data is touched. view() hands the contents
+    // out as a span<const T>.
+    //
+    // Growth extends the file with ftruncate and the mapping with mremap, which
+    // invalidates pointers like vector reallocation does. flush() msyncs; the
+    // destructor trims unused capacity from the file.
+    template<typename T>
+    class mmap_vector {
+        static_assert(std::is_trivially_copyable_v<T>, "mmap_vector stores raw bytes; T must be trivially copyable");
+
+        struct header {
+            uint64_t magic;
+            uint32_t version;
+            uint32_t element_size;
+            uint64_t count;
+            unsigned char reserved[40];
+        };
+        static_assert(sizeof(header) == 64);
+        static_assert(alignof(T) <= sizeof(header), "mmap_vector elements must fit the header's 64-byte alignment");
+
+        static constexpr uint64_t file_magic = 0x5243'4556'4c54'534eull; // "NSTLVECR"
+        static constexpr uint32_t file_version = 1;
+
+    public:
+        using value_type = T;
+        using iterator = T*;
+        using const_iterator = const T*;
+
+        explicit mmap_vector(const std::string& path, open_mode mode = open_mode::read_write) : _mode(mode) {
+            int flags = mode == open_mode::read_only ? O_RDONLY : O_RDWR | O_CREAT;
+            _fd = ::open(path.c_str(), flags | O_CLOEXEC, 0644);
+            if (_fd < 0) {
+                throw std::system_error(errno, std::generic_category(), "mmap_vector: cannot open " + path);
+            }
+            try {
+                attach(path);
+            } catch (...) {
+                ::close(_fd);
+                throw;
+            }
+        }
+        mmap_vector(const mmap_vector&) = delete;
+        mmap_vector& operator=(const mmap_vector&) = delete;
+        mmap_vector(mmap_vector&& other) noexcept
+            : _fd(std::exchange(other._fd, -1)), _mode(other._mode), _map(std::exchange(other._map, nullptr)),
+              _capacity(std::exchange(other._capacity, 0)) {}
+        mmap_vector& operator=(mmap_vector&& other) noexcept {
+            if (this == &other) return *this;
+            close();
+            _fd = std::exchange(other._fd, -1);
+            _mode = other._mode;
+            _map = std::exchange(other._map, nullptr);
+            _capacity = std::exchange(other._capacity, 0);
+            return *this;
+        }
+        ~mmap_vector() {
+            close();
+        }
+
+        void push_back(const T& value) {
+            require_writable("push_back");
+            if (size() == _capacity) [[unlikely]] {
+                // value may live in the mapping, which remap() can move.
+                size_t offset = offset_of(&value);
+                remap(std::max<size_t>(_capacity * 2, min_capacity));
+                data()[size()] = offset < size() ? data()[offset] : value;
+            } else {
+                data()[size()] = value;
+            }
+            _map->count++;
+        }
+
+        void append(span<const T> values) {
+            require_writable("append");
+            size_t length = size();
+            const T* src = values.data();
+            if (length + values.size() > _capacity) {
+                size_t offset = offset_of(src);
+                remap(std::max(length + values.size(), _capacity * 2));
+                if (offset < length) src = data() + offset;
+            }
+            if (!values.empty()) {
+                std::memcpy(static_cast<void*>(data() + length), src, values.size() * sizeof(T));
+            }
+            _map->count += values.size();
+        }
+
+        void pop_back() {
+            require_writable("pop_back");
+            if (size() == 0) [[unlikely]] {
+                throw std::out_of_range("Error: Cannot pop_back when Vector is Empty");
+            }
+            _map->count--;
+        }
+
+        // New elements are zero-filled (fresh file space reads as zeros).
+        void resize(size_t new_size) {
+            require_writable("resize");
+            if (new_size > _capacity) {
+                remap(new_size);
+            }
+            if (new_size > size()) {
+                std::memset(static_cast<void*>(data() + size()), 0, (new_size - size()) * sizeof(T));
+            }
+            _map->count = new_size;
+        }
+
+        void reserve(size_t new_capacity) {
+            if (new_capacity > _capacity) remap(new_capacity);
+        }
+
+        void clear() noexcept {
+            if (_mode == open_mode::read_write) _map->count = 0;
+        }
+
+        // Writes the mapping back to the file and waits for it.
+        void flush() {
+            if (_mode == open_mode::read_only) return;
+            if (::msync(_map, mapping_size(_capacity), MS_SYNC) != 0) {
+                throw std::system_error(errno, std::generic_category(), "mmap_vector: msync failed");
+            }
+        }
+
+        const T& operator[](size_t idx) const noexcept { return data()[idx]; }
+        T& operator[](size_t idx) noexcept { return data()[idx]; }
+
+        const T& at(size_t idx) const {
+            if (idx >= size()) [[unlikely]] {
+                throw std::out_of_range("Error: Index out of bounds");
+            }
+            return data()[idx];
+        }
+        T& at(size_t idx) {
+            if (idx >= size()) [[unlikely]] {
+                throw std::out_of_range("Error: Index out of bounds");
+            }
+            return data()[idx];
+        }
+
+        T* data() noexcept { return reinterpret_cast<T*>(_map + 1); }
+        const T* data() const noexcept { return reinterpret_cast<const T*>(_map + 1); }
+        span<const T> view() const noexcept { return span<const T>(data(), size()); }
+
+        size_t size() const noexcept { return _map->count; }
+        bool empty() const noexcept { return size() == 0; }
+        size_t capacity() const noexcept { return _capacity; }
+
+        T* begin() noexcept { return data(); }
+        T* end() noexcept { return data() + size(); }
+        const T* begin() const noexcept { return data(); }
+        const T* end() const noexcept { return data() + size(); }
+        const T* cbegin() const noexcept { return data(); }
+        const T* cend() const noexcept { return data() + size(); }
+
+    private:
+        static constexpr size_t min_capacity = 64;
+
+        int _fd = -1;
+        open_mode _mode;
+        header* _map = nullptr;
+        size_t _capacity = 0;
+
+        static size_t mapping_size(size_t capacity) noexcept {
+            return sizeof(header) + capacity * sizeof(T);
+        }
+
+        int protection() const noexcept {
+            return _mode == open_mode::read_only ? PROT_READ : PROT_READ | PROT_WRITE;
+        }
+
+        // Maps the file, writing a fresh header if it is empty, and validates it.
+        void attach(const std::string& path) {
+            struct stat st;
+            if (::fstat(_fd, &st) != 0) {
+                throw std::system_error(errno, std::generic_category(), "mmap_vector: cannot stat " + path);
+            }
+            size_t file_size = static_cast<size_t>(st.st_size);
+            bool fresh = file_size == 0;
+            if (fresh) {
+                if (_mode == open_mode::read_only) {
+                    throw std::runtime_error("mmap_vector: " + path + " is empty");
+                }
+                file_size = mapping_size(0);
+                if (::ftruncate(_fd, static_cast<off_t>(file_size)) != 0) {
+                    throw std::system_error(errno, std::generic_category(), "mmap_vector: cannot size " + path);
+                }
+            }
+            if (file_size < sizeof(header)) {
+                throw std::runtime_error("mmap_vector: " + path + " is too short for a header");
+            }
+
+            void* p = ::mmap(nullptr, file_size, protection(), MAP_SHARED, _fd, 0);
+            if (p == MAP_FAILED) {
+                throw std::system_error(errno, std::generic_category(), "mmap_vector: cannot map " + path);
+            }
+            _map = static_cast<header*>(p);
+            _capacity = (file_size - sizeof(header)) / sizeof(T);
+
+            if (fresh) {
+                *_map = header{file_magic, file_version, sizeof(T), 0, {}};
+                return;
+            }
+            const char* problem = nullptr;
+            if (_map->magic != file_magic) problem = " is not an mmap_vector file";
+            else if (_map->version != file_version) problem = " has an unsupported version";
+            else if (_map->element_size != sizeof(T)) problem = " holds elements of a different size";
+            else if (_map->count > _capacity) problem = " is truncated";
+            if (problem) {
+                ::munmap(_map, file_size);
+                _map = nullptr;
+                throw std::runtime_error("mmap_vector: " + path + problem);
+            }
+        }
+
+        void require_writable(const char* operation) const {
+            if (_mode == open_mode::read_only) [[unlikely]] {
+                throw std::logic_error(std::string("mmap_vector: cannot ") + operation + " a read-only mapping");
+            }
+        }
+
+        // Index of p if it points at one of the stored elements, size() otherwise.
+        size_t offset_of(const T* p) const noexcept {
+            if (std::less_equal<const T*>{}(data(), p) && std::less<const T*>{}(p, data() + size())) {
+                return static_cast<size_t>(p - data());
+            }
+            return size();
+        }
+
+        void remap(size_t new_capacity) {
+            require_writable("grow");
+            size_t old_bytes = mapping_size(_capacity);
+            size_t new_bytes = mapping_size(new_capacity);
+            if (::ftruncate(_fd, static_cast<off_t>(new_bytes)) != 0) {
+                throw std::system_error(errno, std::generic_category(), "mmap_vector: cannot grow file");
+            }
+            void* p = ::mremap(_map, old_bytes, new_bytes, MREMAP_MAYMOVE);
+            if (p == MAP_FAILED) {
+                int error = errno;
+                [[maybe_unused]] int ignored = ::ftruncate(_fd, static_cast<off_t>(old_bytes));
+                throw std::system_error(error, std::generic_category(), "mmap_vector: cannot remap");
+            }
+            _map = static_cast<header*>(p);
+            _capacity = new_capacity;
+        }
+
+        // Trims spare capacity so the file is exactly header + size() elements.
+        void close() noexcept {
+            if (_map) {
+                size_t used = mapping_size(size());
+                ::munmap(_map, mapping_size(_capacity));
+                if (_mode == open_mode::read_write) {
+                    [[maybe_unused]] int ignored = ::ftruncate(_fd, static_cast<off_t>(used));
+                }
+                _map = nullptr;
+            }
+            if (_fd >= 0) {
+                ::close(_fd);
+                _fd = -1;
+            }
+            _capacity = 0;
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,198 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <nstl/allocator.hpp>
+
+namespace nstl {
+    namespace detail {
+        // Tells the core we are spinning (frees pipeline resources for the sibling
+        // hyperthread and saves power).
+        inline void cpu_relax() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+            __builtin_ia32_pause();
+#elif defined(__aarch64__)
+            asm volatile("yield");
+#endif
+        }
+    }
+
+    // Bounded multi-producer multi-consumer queue (Dmitry Vyukov's array design).
+    //
+    // Every slot carries a sequence number that says whose turn it is: pos means
+    // free for the producer at position pos, pos + 1 means filled for the consumer
+    // at pos. A producer or consumer claims a position with one CAS on its own
+    // counter and then only touches that slot, so producers and consumers never
+    // contend with each other. Slots are padded to a cache line.
+    //
+    // try_push/try_pop never block. push/pop spin for spin_limit attempts, then park
+    // on the slot's sequence with std::atomic::wait until the other side notifies.
+    template<typename T, size_t Capacity>
+    class mpmc_queue {
+        static_assert(std::has_single_bit(Capacity) && Capacity >= 2, "Capacity must be a power of two, at least 2");
+        static_assert(std::is_nothrow_move_constructible_v<T> && std::is_nothrow_move_assignable_v<T>,
+                      "mpmc_queue needs nothrow moves: a claimed slot cannot be given back");
+
+        static constexpr size_t mask = Capacity - 1;
+
+        struct alignas(cache_line_size) slot {
+            std::atomic<size_t> sequence;
+            // Threads parked on this slot's sequence; lives in the slot's padding.
+            std::atomic<uint32_t> parked;
+            alignas(T) unsigned char storage[sizeof(T)];
+
+            T* item() noexcept { return reinterpret_cast<T*>(storage); }
+        };
+        using slot_allocator = aligned_allocator<slot, cache_line_size>;
+
+    public:
+        using value_type = T;
+
+        // Attempts push/pop make before parking.
+        static constexpr int spin_limit = 128;
+
+        mpmc_queue() : _slots(slot_allocator().allocate(Capacity)) {
+            for (size_t i = 0; i < Capacity; ++i) {
+                std::construct_at(&_slots[i]);
+                _slots[i].sequence.store(i, std::memory_order_relaxed);
+                _slots[i].parked.store(0, std::memory_order_relaxed);
+            }
+        }
+        mpmc_queue(const mpmc_queue&) = delete;
+        mpmc_queue& operator=(const mpmc_queue&) = delete;
+        ~mpmc_queue() {
+            size_t end = _enqueue_pos.load(std::memory_order_relaxed);
+            for (size_t pos = _dequeue_pos.load(std::memory_order_relaxed); pos != end; ++pos) {
+                std::destroy_at(_slots[pos & mask].item());
+            }
+            slot_allocator().deallocate(_slots, Capacity);
+        }
+
+        // Non-blocking. A constructor that may throw runs before a slot is claimed.
+        bool try_push(const T& value) { return try_emplace(value); }
+        bool try_push(T&& value) { return try_emplace(std::move(value)); }
+
+        template<typename... Args>
+        bool try_emplace(Args&&... args) {
+            if constexpr (std::is_nothrow_constructible_v<T, Args...>) {
+                return try_place(std::forward<Args>(args)...);
+            } else {
+                T value(std::forward<Args>(args)...);
+                return try_place(std::move(value));
+            }
+        }
+
+        bool try_pop(T& out) noexcept {
+            size_t pos = _dequeue_pos.load(std::memory_order_relaxed);
+            slot* s;
+            for (;;) {
+                s = &_slots[pos & mask];
+                size_t seq = s->sequence.load(std::memory_order_acquire);
+                intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+                if (diff == 0) {
+                    if (_dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+                } else if (diff < 0) {
+                    return false;
+                } else {
+                    pos = _dequeue_pos.load(std::memory_order_relaxed);
+                }
+            }
+            out = std::move(*s->item());
+            std::destroy_at(s->item());
+            publish(*s, pos + Capacity);
+            return true;
+        }
+
+        // Blocking: spin, then park until a consumer frees a slot.
+        void push(const T& value) { emplace(value); }
+        void push(T&& value) { emplace(std::move(value)); }
+
+        template<typename... Args>
+        void emplace(Args&&... args) {
+            T value(std::forward<Args>(args)...);
+            for (int i = 0; i < spin_limit; ++i) {
+                if (try_place(std::move(value))) return;
+                detail::cpu_relax();
+            }
+            while (!try_place(std::move(value))) {
+                // Full: the slot for the next push is still waiting for its consumer.
+                size_t pos = _enqueue_pos.load(std::memory_order_relaxed);
+                park(_slots[pos & mask], pos);
+            }
+        }
+
+        // Blocking: spin, then park until a producer fills a slot.
+        void pop(T& out) noexcept {
+            for (int i = 0; i < spin_limit; ++i) {
+                if (try_pop(out)) return;
+                detail::cpu_relax();
+            }
+            while (!try_pop(out)) {
+                size_t pos = _dequeue_pos.load(std::memory_order_relaxed);
+                park(_slots[pos & mask], pos + 1);
+            }
+        }
+
+        // Approximate while other threads are active.
+        size_t size_approx() const noexcept {
+            size_t enqueued = _enqueue_pos.load(std::memory_order_relaxed);
+            size_t dequeued = _dequeue_pos.load(std::memory_order_relaxed);
+            return enqueued > dequeued ? enqueued - dequeued : 0;
+        }
+        bool empty() const noexcept { return size_approx() == 0; }
+        static constexpr size_t capacity() noexcept { return Capacity; }
+
+    private:
+        slot* _slots;
+        alignas(cache_line_size) std::atomic<size_t> _enqueue_pos{0};
+        alignas(cache_line_size) std::atomic<size_t> _dequeue_pos{0};
+
+        template<typename... Args>
+        bool try_place(Args&&... args) noexcept {
+            size_t pos = _enqueue_pos.load(std::memory_order_relaxed);
+            slot* s;
+            for (;;) {
+                s = &_slots[pos & mask];
+                size_t seq = s->sequence.load(std::memory_order_acquire);
+                intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+                if (diff == 0) {
+                    if (_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+                } else if (diff < 0) {
+                    return false;
+                } else {
+                    pos = _enqueue_pos.load(std::memory_order_relaxed);
+                }
+            }
+            std::construct_at(s->item(), std::forward<Args>(args)...);
+            publish(*s, pos + 1);
+            return true;
+        }
+
+        // Hands the slot to the other side and wakes whoever is parked on it. Only
+        // threads waiting for this very slot are counted, so a publish normally costs
+        // no syscall even while others sleep. seq_cst on the store and on the count
+        // pairs with park(): either we see the parked thread, or its wait() sees the
+        // new sequence.
+        static void publish(slot& s, size_t sequence) noexcept {
+            s.sequence.store(sequence, std::memory_order_seq_cst);
+            if (s.parked.load(std::memory_order_seq_cst) > 0) [[unlikely]] {
+                s.sequence.notify_all();
+            }
+        }
+
+        // Sleeps until the slot's sequence is next published, unless it already reads
+        // ready. Waking early is harmless: the caller just retries.
+        static void park(slot& s, size_t ready) noexcept {
+            size_t seq = s.sequence.load(std::memory_order_seq_cst);
+            if (seq == ready) return;
+            s.parked.fetch_add(1, std::memory_order_seq_cst);
+            s.sequence.wait(seq, std::memory_order_seq_cst);
+            s.parked.fetch_sub(1, std::memory_order_relaxed);
+        }
+    };
+}
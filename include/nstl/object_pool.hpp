@@ -0,0 +1,191 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <nstl/per_thread.hpp>
+#include <nstl/unique_ptr.hpp>
+
+namespace nstl {
+    template<typename T>
+    class object_pool;
+
+    // Empty deleter for pooled objects: a slot's slab is aligned to its own size, so
+    // masking the pointer finds the slab header and, through it, the owning pool.
+    template<typename T>
+    struct pool_deleter {
+        void operator()(T* p) const noexcept {
+            p->~T();
+            object_pool<T>::owner_of(p)->deallocate(p);
+        }
+    };
+
+    template<typename T>
+    using pooled_ptr = unique_ptr<T, pool_deleter<T>>;
+
+    // Slab allocator for one type. Each thread allocates from and frees into its own
+    // free list, and only locks the pool to trade a batch of slots with the shared list
+    // when its own runs dry or grows past the cache size. Objects may be freed on any
+    // thread. The pool must outlive its objects, and destroying it must not race with
+    // threads still using it.
+    //
+    //     nstl::object_pool<Order> orders;
+    //     nstl::pooled_ptr<Order> order = orders.make_pooled(id, price, quantity);
+    template<typename T>
+    class object_pool {
+        struct free_slot {
+            free_slot* next;
+        };
+        struct slab_header {
+            object_pool* owner;
+            slab_header* next;
+        };
+
+        static constexpr size_t slot_align = std::max(alignof(T), alignof(free_slot));
+        static constexpr size_t slot_size = (std::max(sizeof(T), sizeof(free_slot)) + slot_align - 1) & ~(slot_align - 1);
+        static constexpr size_t header_size = (sizeof(slab_header) + slot_align - 1) & ~(slot_align - 1);
+
+    public:
+        // At least 64 slots per slab, and at least 64 KB.
+        static constexpr size_t slab_size = std::bit_ceil(std::max(size_t(64) << 10, header_size + 64 * slot_size));
+        static constexpr size_t slots_per_slab = (slab_size - header_size) / slot_size;
+
+        explicit object_pool(size_t cache_size = 256)
+            : _caches(this), _limit(static_cast<uint32_t>(std::max<size_t>(cache_size, 2))) {}
+
+        object_pool(const object_pool&) = delete;
+        object_pool& operator=(const object_pool&) = delete;
+
+        ~object_pool() {
+            _caches.shutdown([](shared_slabs& shared) noexcept {
+                for (slab_header* s = shared.slabs; s;) {
+                    slab_header* next = s->next;
+                    ::operator delete(static_cast<void*>(s), slab_size, std::align_val_t(slab_size));
+                    s = next;
+                }
+            });
+        }
+
+        template<typename... Args>
+        pooled_ptr<T> make_pooled(Args&&... args) {
+            void* p = allocate();
+            try {
+                return pooled_ptr<T>(::new (p) T(std::forward<Args>(args)...));
+            } catch (...) {
+                deallocate(static_cast<T*>(p));
+                throw;
+            }
+        }
+
+        // Raw, uninitialised slots.
+        [[nodiscard]] T* allocate() {
+            cache& local = _caches.local();
+            if (free_slot* s = local.head) [[likely]] {
+                local.head = s->next;
+                --local.count;
+                return reinterpret_cast<T*>(s);
+            }
+            return refill(local);
+        }
+        // A thread whose cache cannot be created frees straight to the shared list, so
+        // the first free on a new thread cannot throw.
+        void deallocate(T* p) noexcept {
+            cache* local = _caches.try_local();
+            if (!local) [[unlikely]] {
+                std::lock_guard lock(_caches.mutex());
+                _caches.shared().give_back(::new (static_cast<void*>(p)) free_slot{nullptr});
+                return;
+            }
+            local->head = ::new (static_cast<void*>(p)) free_slot{local->head};
+            if (++local->count > _limit) [[unlikely]] drain(*local, _limit / 2);
+        }
+
+        size_t slab_count() const {
+            std::lock_guard lock(_caches.mutex());
+            return _caches.shared().slab_count;
+        }
+
+        static object_pool* owner_of(const T* p) noexcept {
+            auto slab = reinterpret_cast<uintptr_t>(p) & ~(uintptr_t(slab_size) - 1);
+            return reinterpret_cast<slab_header*>(slab)->owner;
+        }
+
+    private:
+        struct cache {
+            free_slot* head = nullptr;
+            uint32_t count = 0;
+        };
+        struct shared_slabs {
+            explicit shared_slabs(object_pool* owner) : owner(owner) {}
+            object_pool* owner;
+            free_slot* free = nullptr;
+            slab_header* slabs = nullptr;
+            std::byte* cursor = nullptr; // next uncarved slot in the newest slab
+            std::byte* end = nullptr;
+            size_t slab_count = 0;
+
+            void give_back(free_slot* slot) noexcept {
+                slot->next = free;
+                free = slot;
+            }
+            void flush(cache& local) noexcept {
+                while (free_slot* slot = local.head) {
+                    local.head = slot->next;
+                    give_back(slot);
+                }
+                local.count = 0;
+            }
+        };
+
+        // Moves half a cache's worth of slots into this thread's list in one lock, from
+        // the shared list first and then from fresh slabs.
+        T* refill(cache& local) {
+            std::lock_guard lock(_caches.mutex());
+            shared_slabs& s = _caches.shared();
+            for (uint32_t i = 0; i < _limit / 2; ++i) {
+                free_slot* slot = s.free;
+                if (slot) {
+                    s.free = slot->next;
+                } else {
+                    if (s.cursor == s.end) add_slab(s);
+                    slot = reinterpret_cast<free_slot*>(s.cursor);
+                    s.cursor += slot_size;
+                }
+                slot->next = local.head;
+                local.head = slot;
+                ++local.count;
+            }
+            free_slot* first = local.head;
+            local.head = first->next;
+            --local.count;
+            return reinterpret_cast<T*>(first);
+        }
+
+        void drain(cache& local, uint32_t keep) noexcept {
+            std::lock_guard lock(_caches.mutex());
+            while (local.count > keep) {
+                free_slot* slot = local.head;
+                local.head = slot->next;
+                --local.count;
+                _caches.shared().give_back(slot);
+            }
+        }
+
+        // Caller holds the lock.
+        static void add_slab(shared_slabs& s) {
+            void* memory = ::operator new(slab_size, std::align_val_t(slab_size));
+            auto* slab = ::new (memory) slab_header{s.owner, s.slabs};
+            s.slabs = slab;
+            ++s.slab_count;
+            s.cursor = static_cast<std::byte*>(memory) + header_size;
+            s.end = s.cursor + slots_per_slab * slot_size;
+        }
+
+        detail::per_thread_caches<cache, shared_slabs> _caches;
+        uint32_t _limit;
+    };
+}
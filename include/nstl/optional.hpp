@@ -1,12 +1,16 @@
+#pragma once
+
 #include <cstddef>
 #include <stdexcept>
 #include <memory>
+#include <optional>
 #include <iostream>
 #include <utility>
 #include <cstring>
 #include <type_traits>
 #include <algorithm>
 #include <compare>
+#include <nstl/type_traits.hpp>
 
 namespace nstl {
     struct nullopt_t {
@@ -171,4 +175,7 @@ namespace nstl {
         };
         bool engaged_ = false;
     };
+
+    template<typename T>
+    struct is_trivially_relocatable<optional<T>> : is_trivially_relocatable<T> {};
 }
\ No newline at end of file
@@ -0,0 +1,409 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <nstl/allocator.hpp>
+#include <nstl/optional.hpp>
+#include <nstl/span.hpp>
+#include <nstl/unique_ptr.hpp>
+#include <nstl/vector.hpp>
+
+namespace nstl::parallel {
+    // Fork-join thread pool with one deque per thread.
+    //
+    // run(chunks, body) starts as a single task covering [0, chunks). Whoever executes
+    // a task keeps halving it, pushing the right half onto the bottom of its own deque,
+    // until one chunk is left to run. Owners pop from the bottom (newest, still in
+    // cache); idle threads steal from the top of other deques, which holds the largest
+    // halves, so a steal moves a lot of work for one lock.
+    //
+    // The calling thread works too: it runs the root task and then steals until the
+    // job is done, so a pool of N threads starts N - 1 workers, and nested calls from
+    // inside a chunk cannot deadlock.
+    class thread_pool {
+        struct job {
+            void (*run_chunk)(job&, size_t chunk);
+            void* body;
+            std::atomic<size_t> pending;
+            std::atomic<bool> failed{false};
+            std::exception_ptr error;
+        };
+
+        struct task {
+            job* owner;
+            size_t begin;
+            size_t end;
+        };
+
+        struct alignas(cache_line_size) task_queue {
+            std::mutex mutex;
+            std::deque<task> tasks;
+        };
+
+    public:
+        // threads counts the calling thread.
+        explicit thread_pool(size_t threads = std::max(1u, std::thread::hardware_concurrency()))
+            : _size(std::max<size_t>(threads, 1)), _queues(new task_queue[_size]) {
+            _workers.reserve(_size - 1);
+            for (size_t i = 1; i < _size; ++i) {
+                _workers.emplace_back([this, i] { work(i); });
+            }
+        }
+        thread_pool(const thread_pool&) = delete;
+        thread_pool& operator=(const thread_pool&) = delete;
+        ~thread_pool() {
+            _stop.store(true, std::memory_order_seq_cst);
+            _epoch.fetch_add(1, std::memory_order_seq_cst);
+            _epoch.notify_all();
+            for (std::thread& worker : _workers) worker.join();
+        }
+
+        size_t size() const noexcept { return _size; }
+
+        // Calls body(chunk) once for every chunk in [0, chunks) and returns when all
+        // have finished. If a chunk throws, chunks that have not started are skipped
+        // and the first exception is rethrown here.
+        template<typename Body>
+        void run(size_t chunks, Body&& body) {
+            if (chunks == 0) return;
+            job j;
+            j.run_chunk = [](job& self, size_t chunk) { (*static_cast<std::remove_reference_t<Body>*>(self.body))(chunk); };
+            j.body = const_cast<void*>(static_cast<const void*>(std::addressof(body)));
+            j.pending.store(chunks, std::memory_order_relaxed);
+
+            size_t self = current_index();
+            execute(task{&j, 0, chunks}, self);
+            while (j.pending.load(std::memory_order_acquire) != 0) {
+                uint32_t seen = _completions.load(std::memory_order_seq_cst);
+                if (optional<task> t = find_work(self)) {
+                    execute(*t, self);
+                    continue;
+                }
+                if (j.pending.load(std::memory_order_acquire) == 0) break;
+                // Whatever is left is running on other threads.
+                _completions.wait(seen, std::memory_order_seq_cst);
+            }
+            if (j.failed.load(std::memory_order_relaxed)) {
+                std::rethrow_exception(j.error);
+            }
+        }
+
+        // Shared pool sized to the machine, started on first use.
+        static thread_pool& default_pool() {
+            static thread_pool pool;
+            return pool;
+        }
+
+    private:
+        size_t _size;
+        unique_ptr<task_queue[]> _queues;
+        vector<std::thread> _workers;
+        std::atomic<bool> _stop{false};
+        // Bumped on every push; idle workers sleep on it.
+        alignas(cache_line_size) std::atomic<uint32_t> _epoch{0};
+        std::atomic<uint32_t> _sleepers{0};
+        // Bumped whenever a job finishes; callers waiting for stolen chunks sleep on it.
+        // It lives in the pool, not the job, because a job's stack frame is gone as soon
+        // as its caller sees pending reach zero.
+        alignas(cache_line_size) std::atomic<uint32_t> _completions{0};
+
+        static inline thread_local const thread_pool* t_pool = nullptr;
+        static inline thread_local size_t t_index = 0;
+
+        // Workers use their own deque; any other thread shares deque 0.
+        size_t current_index() const noexcept {
+            return t_pool == this ? t_index : 0;
+        }
+
+        void push(size_t queue, task t) {
+            {
+                std::lock_guard<std::mutex> lock(_queues[queue].mutex);
+                _queues[queue].tasks.push_back(t);
+            }
+            // Pairs with the sleeper check in work(): either we see the sleeper, or it
+            // sees the new epoch and does not wait.
+            _epoch.fetch_add(1, std::memory_order_seq_cst);
+            if (_sleepers.load(std::memory_order_seq_cst) > 0) {
+                _epoch.notify_all();
+            }
+        }
+
+        optional<task> find_work(size_t self) {
+            {
+                task_queue& own = _queues[self];
+                std::lock_guard<std::mutex> lock(own.mutex);
+                if (!own.tasks.empty()) {
+                    task t = own.tasks.back();
+                    own.tasks.pop_back();
+                    return t;
+                }
+            }
+            for (size_t k = 1; k < _size; ++k) {
+                task_queue& victim = _queues[(self + k) % _size];
+                std::lock_guard<std::mutex> lock(victim.mutex);
+                if (!victim.tasks.empty()) {
+                    task t = victim.tasks.front();
+                    victim.tasks.pop_front();
+                    return t;
+                }
+            }
+            return nullopt;
+        }
+
+        void execute(task t, size_t self) {
+            while (t.end - t.begin > 1) {
+                size_t mid = t.begin + (t.end - t.begin) / 2;
+                push(self, task{t.owner, mid, t.end});
+                t.end = mid;
+            }
+            job& j = *t.owner;
+            if (!j.failed.load(std::memory_order_relaxed)) {
+                try {
+                    j.run_chunk(j, t.begin);
+                } catch (...) {
+                    if (!j.failed.exchange(true, std::memory_order_relaxed)) {
+                        j.error = std::current_exception();
+                    }
+                }
+            }
+            if (j.pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                _completions.fetch_add(1, std::memory_order_seq_cst);
+                _completions.notify_all();
+            }
+        }
+
+        void work(size_t index) {
+            t_pool = this;
+            t_index = index;
+            while (!_stop.load(std::memory_order_relaxed)) {
+                uint32_t epoch = _epoch.load(std::memory_order_seq_cst);
+                if (optional<task> t = find_work(index)) {
+                    execute(*t, index);
+                    continue;
+                }
+                _sleepers.fetch_add(1, std::memory_order_seq_cst);
+                if (_epoch.load(std::memory_order_seq_cst) == epoch && !_stop.load(std::memory_order_seq_cst)) {
+                    _epoch.wait(epoch, std::memory_order_seq_cst);
+                }
+                _sleepers.fetch_sub(1, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    // Per-call tuning, passed last to every algorithm.
+    struct policy {
+        // Elements per chunk. 0 picks about eight chunks per thread, but never fewer
+        // than min_grain elements.
+        size_t grain = 0;
+        // Makes reduce and inclusive_scan return bit-identical results whatever the
+        // pool size: chunking no longer depends on the thread count (default_grain
+        // unless grain is set). Partial results are always combined in index order.
+        bool deterministic = false;
+        // nullptr runs on thread_pool::default_pool().
+        thread_pool* pool = nullptr;
+    };
+
+    inline constexpr size_t min_grain = 2048;
+    inline constexpr size_t default_grain = 16384;
+
+    namespace detail {
+        inline thread_pool& pool_of(const policy& p) {
+            return p.pool ? *p.pool : thread_pool::default_pool();
+        }
+
+        inline size_t grain_for(size_t n, const policy& p, size_t threads) {
+            if (p.grain) return p.grain;
+            if (p.deterministic) return default_grain;
+            return std::max(min_grain, (n + threads * 8 - 1) / (threads * 8));
+        }
+
+        inline size_t chunk_count(size_t n, size_t grain) {
+            return (n + grain - 1) / grain;
+        }
+
+        // Number of elements of a that come before position k of the stable merge of
+        // a and b (ties go to a).
+        template<typename T, typename Compare>
+        size_t merge_split(const T* a, size_t m, const T* b, size_t n, size_t k, Compare& comp) {
+            size_t lo = k > n ? k - n : 0;
+            size_t hi = std::min(k, m);
+            while (lo < hi) {
+                size_t i = lo + (hi - lo) / 2;
+                size_t j = k - i;
+                if (j > 0 && !comp(b[j - 1], a[i])) {
+                    lo = i + 1;
+                } else {
+                    hi = i;
+                }
+            }
+            return lo;
+        }
+    }
+
+    template<typename T, typename F>
+    void for_each(span<T> s, F f, policy p = {}) {
+        thread_pool& pool = detail::pool_of(p);
+        size_t grain = detail::grain_for(s.size(), p, pool.size());
+        pool.run(detail::chunk_count(s.size(), grain), [&](size_t chunk) {
+            for (T& x : s.subspan(chunk * grain, std::min(grain, s.size() - chunk * grain))) f(x);
+        });
+    }
+
+    // out[i] = f(in[i]). out may be in itself.
+    template<typename T, typename U, typename F>
+    void transform(span<T> in, span<U> out, F f, policy p = {}) {
+        if (out.size() < in.size()) [[unlikely]] {
+            throw std::length_error("Error: Output span is shorter than input");
+        }
+        thread_pool& pool = detail::pool_of(p);
+        size_t grain = detail::grain_for(in.size(), p, pool.size());
+        pool.run(detail::chunk_count(in.size(), grain), [&](size_t chunk) {
+            size_t begin = chunk * grain;
+            size_t end = std::min(begin + grain, in.size());
+            for (size_t i = begin; i < end; ++i) out[i] = f(in[i]);
+        });
+    }
+
+    // Folds s into init with op, which must be associative. Chunk results are combined
+    // in index order, so op need not be commutative.
+    template<typename T, typename V, typename Op>
+    V reduce(span<T> s, V init, Op op, policy p = {}) {
+        thread_pool& pool = detail::pool_of(p);
+        size_t grain = detail::grain_for(s.size(), p, pool.size());
+        size_t chunks = detail::chunk_count(s.size(), grain);
+        vector<optional<V>> partials;
+        partials.resize(chunks);
+        pool.run(chunks, [&](size_t chunk) {
+            span<T> part = s.subspan(chunk * grain, std::min(grain, s.size() - chunk * grain));
+            V acc = part[0];
+            for (size_t i = 1; i < part.size(); ++i) acc = op(std::move(acc), part[i]);
+            partials[chunk] = std::move(acc);
+        });
+        for (optional<V>& partial : partials) init = op(std::move(init), std::move(*partial));
+        return init;
+    }
+
+    template<typename T, typename V>
+    V reduce(span<T> s, V init, policy p = {}) {
+        return parallel::reduce(s, std::move(init), std::plus<>{}, p);
+    }
+
+    // out[i] = in[0] op ... op in[i]. Two passes: chunk totals in parallel, a serial
+    // scan over the totals, then every chunk rescans itself from its carry-in.
+    // out may be in itself.
+    template<typename T, typename U, typename Op>
+    void inclusive_scan(span<T> in, span<U> out, Op op, policy p = {}) {
+        if (out.size() < in.size()) [[unlikely]] {
+            throw std::length_error("Error: Output span is shorter than input");
+        }
+        thread_pool& pool = detail::pool_of(p);
+        size_t grain = detail::grain_for(in.size(), p, pool.size());
+        size_t chunks = detail::chunk_count(in.size(), grain);
+        vector<optional<U>> carry;
+        carry.resize(chunks);
+        // Totals of every chunk but the last, stored one slot to the right.
+        pool.run(chunks - (chunks > 0), [&](size_t chunk) {
+            span<T> part = in.subspan(chunk * grain, grain);
+            U acc = part[0];
+            for (size_t i = 1; i < part.size(); ++i) acc = op(std::move(acc), part[i]);
+            carry[chunk + 1] = std::move(acc);
+        });
+        for (size_t chunk = 2; chunk < chunks; ++chunk) {
+            carry[chunk] = op(*carry[chunk - 1], *carry[chunk]);
+        }
+        pool.run(chunks, [&](size_t chunk) {
+            size_t begin = chunk * grain;
+            size_t end = std::min(begin + grain, in.size());
+            U acc = carry[chunk] ? op(*carry[chunk], in[begin]) : in[begin];
+            out[begin] = acc;
+            for (size_t i = begin + 1; i < end; ++i) {
+                acc = op(std::move(acc), in[i]);
+                out[i] = acc;
+            }
+        });
+    }
+
+    template<typename T, typename U>
+    void inclusive_scan(span<T> in, span<U> out, policy p = {}) {
+        parallel::inclusive_scan(in, out, std::plus<>{}, p);
+    }
+
+    // Sorts runs of grain elements with std::sort, then merges pairs of runs in
+    // rounds, ping-ponging through one scratch buffer. Every round is split into
+    // grain-sized pieces of output (cut points found by binary search), so even the
+    // last merge keeps all threads busy. A one-thread pool just calls std::sort.
+    // Not stable; T must be default constructible for the scratch buffer.
+    template<typename T, typename Compare = std::less<>>
+    void sort(span<T> s, Compare comp = {}, policy p = {}) {
+        thread_pool& pool = detail::pool_of(p);
+        size_t n = s.size();
+        size_t grain = p.grain ? p.grain : std::max(min_grain, (n + pool.size() * 4 - 1) / (pool.size() * 4));
+        if (n <= grain || pool.size() == 1) {
+            std::sort(s.begin(), s.end(), comp);
+            return;
+        }
+        size_t pieces = detail::chunk_count(n, grain);
+        pool.run(pieces, [&](size_t piece) {
+            T* first = s.data() + piece * grain;
+            std::sort(first, first + std::min(grain, n - piece * grain), comp);
+        });
+
+        vector<T> scratch;
+        scratch.resize(n);
+        // Where each piece's output starts and ends in the left run. Found for all
+        // pieces before any of them moves elements out of src.
+        vector<size_t> cuts;
+        cuts.resize(2 * pieces);
+        T* src = s.data();
+        T* dst = scratch.data();
+        for (size_t width = grain; width < n; width *= 2) {
+            auto bounds = [&](size_t piece) {
+                size_t lo = piece * grain / (2 * width) * (2 * width);
+                return std::pair{lo, std::min(lo + width, n)};
+            };
+            pool.run(pieces, [&](size_t piece) {
+                auto [lo, mid] = bounds(piece);
+                size_t hi = std::min(lo + 2 * width, n);
+                size_t out_begin = piece * grain;
+                size_t out_end = std::min(out_begin + grain, n);
+                cuts[2 * piece] = detail::merge_split(src + lo, mid - lo, src + mid, hi - mid, out_begin - lo, comp);
+                cuts[2 * piece + 1] = detail::merge_split(src + lo, mid - lo, src + mid, hi - mid, out_end - lo, comp);
+            });
+            pool.run(pieces, [&](size_t piece) {
+                auto [lo, mid] = bounds(piece);
+                size_t out_begin = piece * grain;
+                size_t out_end = std::min(out_begin + grain, n);
+                size_t i0 = cuts[2 * piece];
+                size_t i1 = cuts[2 * piece + 1];
+                size_t j0 = out_begin - lo - i0;
+                size_t j1 = out_end - lo - i1;
+                std::merge(std::make_move_iterator(src + lo + i0), std::make_move_iterator(src + lo + i1),
+                           std::make_move_iterator(src + mid + j0), std::make_move_iterator(src + mid + j1),
+                           dst + out_begin, comp);
+            });
+            std::swap(src, dst);
+        }
+        if (src != s.data()) {
+            pool.run(pieces, [&](size_t piece) {
+                size_t begin = piece * grain;
+                std::move(src + begin, src + std::min(begin + grain, n), s.data() + begin);
+            });
+        }
+    }
+
+    template<typename T>
+    void sort(span<T> s, policy p) {
+        parallel::sort(s, std::less<>{}, p);
+    }
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace nstl {
+    namespace detail {
+        // One Cache per thread for an owner such as thread_cache_resource or
+        // object_pool, in front of the owner's Shared state. Shared must provide
+        // `void flush(Cache&) noexcept`, which hands back whatever a cache still holds;
+        // it is called under mutex() when a thread that used the owner exits.
+        //
+        // The owner calls shutdown() from its destructor, which must not race with other
+        // threads still using it. Caches of threads still running are deleted there,
+        // and those threads skip the dead owner when they exit.
+        template<typename Cache, typename Shared>
+        class per_thread_caches {
+            struct state : Shared {
+                using Shared::Shared;
+                std::mutex mutex;
+                std::vector<Cache*> caches;
+                bool alive = true;
+            };
+            struct entry {
+                uint64_t id;
+                std::shared_ptr<state> owner;
+                Cache* local;
+            };
+            // This thread's caches, one per owner it has used.
+            struct registry {
+                std::vector<entry> entries;
+
+                ~registry() {
+                    last_used = {0, nullptr};
+                    for (entry& e : entries) {
+                        std::lock_guard lock(e.owner->mutex);
+                        if (!e.owner->alive) continue;
+                        e.owner->flush(*e.local);
+                        std::erase(e.owner->caches, e.local);
+                        delete e.local;
+                    }
+                }
+            };
+            struct cache_ref {
+                uint64_t id;
+                Cache* local;
+            };
+            static inline thread_local cache_ref last_used{0, nullptr};
+
+        public:
+            template<typename... Args>
+            explicit per_thread_caches(Args&&... args)
+                : _state(std::make_shared<state>(std::forward<Args>(args)...)),
+                  _id(next_id().fetch_add(1, std::memory_order_relaxed)) {}
+
+            per_thread_caches(const per_thread_caches&) = delete;
+            per_thread_caches& operator=(const per_thread_caches&) = delete;
+
+            ~per_thread_caches() {
+                shutdown([](Shared&) noexcept {});
+            }
+
+            // Deletes every cache, then runs release on the shared state, all under the
+            // lock so no exiting thread can flush into it halfway. Later calls do nothing.
+            template<typename Release>
+            void shutdown(Release release) noexcept {
+                std::lock_guard lock(_state->mutex);
+                if (!_state->alive) return;
+                for (Cache* c : _state->caches) delete c;
+                _state->caches.clear();
+                _state->alive = false;
+                release(static_cast<Shared&>(*_state));
+            }
+
+            // This thread's cache, created on first use. Ids are never reused, so a
+            // matching id means the cache belongs to this live owner. The registry sits
+            // behind the check: its thread_local has a destructor and so an
+            // initialisation guard.
+            Cache& local() {
+                if (last_used.id == _id) [[likely]] return *last_used.local;
+                return find();
+            }
+            // local() for paths that must not throw: nullptr if the cache could not be
+            // created, and the caller then goes to the shared state under mutex().
+            Cache* try_local() noexcept {
+                if (last_used.id == _id) [[likely]] return last_used.local;
+                try {
+                    return &find();
+                } catch (...) {
+                    return nullptr;
+                }
+            }
+
+            Shared& shared() const noexcept { return *_state; }
+            std::mutex& mutex() const noexcept { return _state->mutex; }
+
+        private:
+            static std::atomic<uint64_t>& next_id() noexcept {
+                static std::atomic<uint64_t> id{1};
+                return id;
+            }
+
+            Cache& find() {
+                thread_local registry mine;
+                for (auto& e : mine.entries) {
+                    if (e.id == _id) {
+                        last_used = {_id, e.local};
+                        return *e.local;
+                    }
+                }
+                // Entries of owners that have since been destroyed are dropped here.
+                std::erase_if(mine.entries, [](entry& e) {
+                    std::lock_guard lock(e.owner->mutex);
+                    return !e.owner->alive;
+                });
+                mine.entries.reserve(mine.entries.size() + 1);
+                auto created = std::make_unique<Cache>();
+                {
+                    std::lock_guard lock(_state->mutex);
+                    _state->caches.push_back(created.get());
+                }
+                mine.entries.push_back({_id, _state, created.get()});
+                last_used = {_id, created.get()};
+                return *created.release();
+            }
+
+            std::shared_ptr<state> _state;
+            uint64_t _id;
+        };
+    }
+}
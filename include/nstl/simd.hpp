@@ -0,0 +1,572 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <nstl/span.hpp>
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define NSTL_SIMD_X86 1
+#else
+#define NSTL_SIMD_X86 0
+#endif
+
+namespace nstl::simd {
+    // Vectorized scans over spans of int32_t, int64_t, float and double.
+    //
+    // Every kernel is written once against GCC/Clang vector extensions and compiled
+    // three times on x86-64, for 16-byte (SSE2), 32-byte (AVX2) and 64-byte
+    // (AVX-512) vectors, each inside a function carrying the matching target
+    // attribute. The first call reads CPUID and picks the widest table the CPU and
+    // OS support; other compilers and architectures get the scalar table.
+    //
+    // Floating-point sum and dot add in a different order than a serial loop, so the
+    // last bits can differ from std::accumulate. min/max results are unspecified for
+    // spans holding NaN.
+
+    enum class isa {
+        scalar,
+        sse2,
+        avx2,
+        avx512,
+    };
+
+    enum class cmp { eq, ne, lt, le, gt, ge };
+
+    template<typename T>
+    concept element = std::same_as<T, int32_t> || std::same_as<T, int64_t> ||
+                      std::same_as<T, float> || std::same_as<T, double>;
+
+    // Integers are summed in 64 bits so a span of int cannot overflow the result.
+    template<typename T>
+    using sum_type = std::conditional_t<std::is_integral_v<T>, int64_t, T>;
+
+    template<typename T>
+    struct indexed {
+        T value;
+        size_t index;
+    };
+
+    template<typename T>
+    struct kernel_table {
+        size_t (*find)(const T*, size_t, T);
+        size_t (*count)(const T*, size_t, T);
+        indexed<T> (*min)(const T*, size_t);
+        indexed<T> (*max)(const T*, size_t);
+        sum_type<T> (*sum)(const T*, size_t);
+        sum_type<T> (*dot)(const T*, const T*, size_t);
+        size_t (*compare_mask)(const T*, size_t, cmp, T, uint64_t*);
+    };
+
+    namespace detail {
+        template<cmp Op, typename T>
+        constexpr bool compare(T a, T b) {
+            if constexpr (Op == cmp::eq) return a == b;
+            else if constexpr (Op == cmp::ne) return a != b;
+            else if constexpr (Op == cmp::lt) return a < b;
+            else if constexpr (Op == cmp::le) return a <= b;
+            else if constexpr (Op == cmp::gt) return a > b;
+            else return a >= b;
+        }
+
+        template<bool Max, typename T>
+        constexpr bool better(T candidate, T best) {
+            return Max ? candidate > best : candidate < best;
+        }
+
+        // Plain loops: the fallback table and the tails of the vector kernels.
+        namespace scalar {
+            template<typename T>
+            size_t find(const T* p, size_t n, T value) {
+                for (size_t i = 0; i < n; ++i) {
+                    if (p[i] == value) return i;
+                }
+                return n;
+            }
+
+            template<typename T>
+            size_t count(const T* p, size_t n, T value) {
+                size_t total = 0;
+                for (size_t i = 0; i < n; ++i) total += p[i] == value;
+                return total;
+            }
+
+            template<bool Max, typename T>
+            indexed<T> extreme(const T* p, size_t n) {
+                indexed<T> best{p[0], 0};
+                for (size_t i = 1; i < n; ++i) {
+                    if (better<Max>(p[i], best.value)) best = {p[i], i};
+                }
+                return best;
+            }
+            template<typename T>
+            indexed<T> min(const T* p, size_t n) { return extreme<false>(p, n); }
+            template<typename T>
+            indexed<T> max(const T* p, size_t n) { return extreme<true>(p, n); }
+
+            template<typename T>
+            sum_type<T> sum(const T* p, size_t n) {
+                sum_type<T> total{};
+                for (size_t i = 0; i < n; ++i) total += p[i];
+                return total;
+            }
+
+            template<typename T>
+            sum_type<T> dot(const T* a, const T* b, size_t n) {
+                sum_type<T> total{};
+                for (size_t i = 0; i < n; ++i) total += sum_type<T>(a[i]) * sum_type<T>(b[i]);
+                return total;
+            }
+
+            template<cmp Op, typename T>
+            size_t compare_mask(const T* p, size_t n, T threshold, uint64_t* bits) {
+                size_t total = 0;
+                for (size_t word = 0; word * 64 < n; ++word) {
+                    uint64_t w = 0;
+                    size_t end = std::min<size_t>(64, n - word * 64);
+                    for (size_t j = 0; j < end; ++j) {
+                        w |= uint64_t(compare<Op>(p[word * 64 + j], threshold)) << j;
+                    }
+                    bits[word] = w;
+                    total += std::popcount(w);
+                }
+                return total;
+            }
+
+            template<typename T>
+            size_t compare_mask(const T* p, size_t n, cmp op, T threshold, uint64_t* bits) {
+                switch (op) {
+                    case cmp::eq: return compare_mask<cmp::eq>(p, n, threshold, bits);
+                    case cmp::ne: return compare_mask<cmp::ne>(p, n, threshold, bits);
+                    case cmp::lt: return compare_mask<cmp::lt>(p, n, threshold, bits);
+                    case cmp::le: return compare_mask<cmp::le>(p, n, threshold, bits);
+                    case cmp::gt: return compare_mask<cmp::gt>(p, n, threshold, bits);
+                    case cmp::ge: return compare_mask<cmp::ge>(p, n, threshold, bits);
+                }
+                return 0;
+            }
+
+            template<typename T>
+            inline constexpr kernel_table<T> table = {
+                &find<T>, &count<T>, &min<T>, &max<T>, &sum<T>, &dot<T>, &compare_mask<T>,
+            };
+        }
+
+#if NSTL_SIMD_X86
+        // Width-generic kernels. They are always inlined into the per-ISA entry points
+        // below, which is where the vector width turns into real SSE/AVX registers.
+        // Vectors are only ever passed by reference so no call boundary depends on the
+        // vector ABI.
+        namespace generic {
+            template<typename T, size_t Bytes>
+            struct lanes {
+                typedef T vec __attribute__((vector_size(Bytes)));
+                using mask = decltype(vec{} == vec{});
+                using lane_int = std::conditional_t<sizeof(T) == 4, int32_t, int64_t>;
+                typedef int64_t wide __attribute__((vector_size(Bytes / sizeof(T) * 8)));
+                static constexpr size_t width = Bytes / sizeof(T);
+            };
+
+            template<typename V, typename T>
+            [[gnu::always_inline]] inline void load(V& v, const T* p) {
+                std::memcpy(&v, p, sizeof(V));
+            }
+
+            template<typename M>
+            [[gnu::always_inline]] inline bool any(const M& m) {
+                uint64_t words[sizeof(M) / 8];
+                std::memcpy(words, &m, sizeof(M));
+                uint64_t folded = 0;
+                for (uint64_t w : words) folded |= w;
+                return folded != 0;
+            }
+
+            template<cmp Op, typename M, typename V, typename T>
+            [[gnu::always_inline]] inline void compare(M& out, const V& a, T b) {
+                if constexpr (Op == cmp::eq) out = a == b;
+                else if constexpr (Op == cmp::ne) out = a != b;
+                else if constexpr (Op == cmp::lt) out = a < b;
+                else if constexpr (Op == cmp::le) out = a <= b;
+                else if constexpr (Op == cmp::gt) out = a > b;
+                else out = a >= b;
+            }
+
+            // One bit per lane, lane 0 in bit 0 (movemask without an intrinsic).
+            template<typename L>
+            [[gnu::always_inline]] inline uint64_t lane_bits(const typename L::mask& m) {
+                typename L::mask weights;
+                for (size_t l = 0; l < L::width; ++l) weights[l] = typename L::lane_int(1) << l;
+                // A select rather than m & weights: GCC 12 scalarizes the AND under AVX-512.
+                typename L::mask picked = m ? weights : typename L::mask{};
+                uint64_t bits = 0;
+                for (size_t l = 0; l < L::width; ++l) bits |= static_cast<uint64_t>(picked[l]);
+                return bits;
+            }
+
+            template<typename T, size_t Bytes>
+            [[gnu::always_inline]] inline size_t find(const T* p, size_t n, T value) {
+                using L = lanes<T, Bytes>;
+                constexpr size_t W = L::width;
+                size_t i = 0;
+                for (; i + 4 * W <= n; i += 4 * W) {
+                    typename L::vec a, b, c, d;
+                    load(a, p + i);
+                    load(b, p + i + W);
+                    load(c, p + i + 2 * W);
+                    load(d, p + i + 3 * W);
+                    // Lanes are 0 or -1, so the sum is nonzero iff any lane hit. (GCC 12
+                    // scalarizes an OR of compares inlined into AVX-512 code; a sum is fine.)
+                    typename L::mask hit = (a == value) + (b == value) + (c == value) + (d == value);
+                    if (any(hit)) break;
+                }
+                for (; i + W <= n; i += W) {
+                    typename L::vec a;
+                    load(a, p + i);
+                    typename L::mask hit = a == value;
+                    if (any(hit)) break;
+                }
+                return i + scalar::find(p + i, n - i, value);
+            }
+
+            template<typename T, size_t Bytes>
+            [[gnu::always_inline]] inline size_t count(const T* p, size_t n, T value) {
+                using L = lanes<T, Bytes>;
+                constexpr size_t W = L::width;
+                // Lane counters are flushed before they could overflow.
+                constexpr size_t block = size_t(1) << 30;
+                size_t total = 0;
+                size_t i = 0;
+                while (n - i >= W) {
+                    size_t end = i + std::min(block, (n - i) / W * W);
+                    typename L::mask hits{};
+                    for (; i < end; i += W) {
+                        typename L::vec a;
+                        load(a, p + i);
+                        hits -= (a == value);
+                    }
+                    for (size_t l = 0; l < W; ++l) total += static_cast<size_t>(hits[l]);
+                }
+                return total + scalar::count(p + i, n - i, value);
+            }
+
+            // Per-lane best value and index, then a cross-lane pass that breaks ties
+            // toward the lower index. Indices live in lanes as wide as T, so long spans
+            // are processed in blocks whose offsets fit.
+            template<bool Max, typename T, size_t Bytes>
+            [[gnu::always_inline]] inline indexed<T> extreme(const T* p, size_t n) {
+                using L = lanes<T, Bytes>;
+                using lane_int = typename L::lane_int;
+                constexpr size_t W = L::width;
+                constexpr size_t block = size_t(1) << (sizeof(T) == 4 ? 30 : 62);
+                indexed<T> result{p[0], 0};
+                for (size_t base = 0; base < n; base += block) {
+                    const T* q = p + base;
+                    size_t len = std::min(block, n - base);
+                    indexed<T> local;
+                    if (len < 2 * W) {
+                        local = scalar::extreme<Max>(q, len);
+                    } else {
+                        typename L::vec best;
+                        load(best, q);
+                        typename L::mask index, best_index;
+                        for (size_t l = 0; l < W; ++l) index[l] = static_cast<lane_int>(l);
+                        best_index = index;
+                        size_t i = W;
+                        for (; i + W <= len; i += W) {
+                            typename L::vec a;
+                            load(a, q + i);
+                            index += static_cast<lane_int>(W);
+                            typename L::mask take = Max ? a > best : a < best;
+                            best = take ? a : best;
+                            best_index = take ? index : best_index;
+                        }
+                        local = {best[0], static_cast<size_t>(best_index[0])};
+                        for (size_t l = 1; l < W; ++l) {
+                            T v = best[l];
+                            size_t at = static_cast<size_t>(best_index[l]);
+                            if (better<Max>(v, local.value) || (v == local.value && at < local.index)) local = {v, at};
+                        }
+                        if (i < len) {
+                            indexed<T> tail = scalar::extreme<Max>(q + i, len - i);
+                            if (better<Max>(tail.value, local.value)) local = {tail.value, i + tail.index};
+                        }
+                    }
+                    if (base == 0 || better<Max>(local.value, result.value)) {
+                        result = {local.value, base + local.index};
+                    }
+                }
+                return result;
+            }
+
+            template<typename T, size_t Bytes, typename Widened>
+            [[gnu::always_inline]] inline void widen(Widened& out, const typename lanes<T, Bytes>::vec& v) {
+                if constexpr (std::is_integral_v<T>) {
+                    out = __builtin_convertvector(v, Widened);
+                } else {
+                    out = v;
+                }
+            }
+
+            // Four independent accumulators hide the add latency.
+            template<typename T, size_t Bytes>
+            [[gnu::always_inline]] inline sum_type<T> sum(const T* p, size_t n) {
+                using L = lanes<T, Bytes>;
+                using acc_t = std::conditional_t<std::is_integral_v<T>, typename L::wide, typename L::vec>;
+                constexpr size_t W = L::width;
+                acc_t acc[4] = {};
+                size_t i = 0;
+                for (; i + 4 * W <= n; i += 4 * W) {
+                    for (size_t k = 0; k < 4; ++k) {
+                        typename L::vec a;
+                        load(a, p + i + k * W);
+                        acc_t w;
+                        widen<T, Bytes>(w, a);
+                        acc[k] += w;
+                    }
+                }
+                for (; i + W <= n; i += W) {
+                    typename L::vec a;
+                    load(a, p + i);
+                    acc_t w;
+                    widen<T, Bytes>(w, a);
+                    acc[0] += w;
+                }
+                acc_t folded = (acc[0] + acc[1]) + (acc[2] + acc[3]);
+                sum_type<T> total{};
+                for (size_t l = 0; l < W; ++l) total += folded[l];
+                return total + scalar::sum(p + i, n - i);
+            }
+
+            template<typename T, size_t Bytes>
+            [[gnu::always_inline]] inline sum_type<T> dot(const T* x, const T* y, size_t n) {
+                using L = lanes<T, Bytes>;
+                using acc_t = std::conditional_t<std::is_integral_v<T>, typename L::wide, typename L::vec>;
+                constexpr size_t W = L::width;
+                acc_t acc[4] = {};
+                size_t i = 0;
+                for (; i + 4 * W <= n; i += 4 * W) {
+                    for (size_t k = 0; k < 4; ++k) {
+                        typename L::vec a, b;
+                        load(a, x + i + k * W);
+                        load(b, y + i + k * W);
+                        acc_t wa, wb;
+                        widen<T, Bytes>(wa, a);
+                        widen<T, Bytes>(wb, b);
+                        acc[k] += wa * wb;
+                    }
+                }
+                for (; i + W <= n; i += W) {
+                    typename L::vec a, b;
+                    load(a, x + i);
+                    load(b, y + i);
+                    acc_t wa, wb;
+                    widen<T, Bytes>(wa, a);
+                    widen<T, Bytes>(wb, b);
+                    acc[0] += wa * wb;
+                }
+                acc_t folded = (acc[0] + acc[1]) + (acc[2] + acc[3]);
+                sum_type<T> total{};
+                for (size_t l = 0; l < W; ++l) total += folded[l];
+                return total + scalar::dot(x + i, y + i, n - i);
+            }
+
+            template<cmp Op, typename T, size_t Bytes>
+            [[gnu::always_inline]] inline size_t compare_mask(const T* p, size_t n, T threshold, uint64_t* bits) {
+                using L = lanes<T, Bytes>;
+                constexpr size_t W = L::width;
+                size_t total = 0;
+                size_t word = 0;
+                for (; (word + 1) * 64 <= n; ++word) {
+                    uint64_t w = 0;
+                    for (size_t k = 0; k < 64 / W; ++k) {
+                        typename L::vec a;
+                        load(a, p + word * 64 + k * W);
+                        typename L::mask m;
+                        compare<Op>(m, a, threshold);
+                        w |= lane_bits<L>(m) << (k * W);
+                    }
+                    bits[word] = w;
+                    total += std::popcount(w);
+                }
+                return total + scalar::compare_mask<Op>(p + word * 64, n - word * 64, threshold, bits + word);
+            }
+
+            template<typename T, size_t Bytes>
+            [[gnu::always_inline]] inline size_t compare_mask(const T* p, size_t n, cmp op, T threshold, uint64_t* bits) {
+                switch (op) {
+                    case cmp::eq: return compare_mask<cmp::eq, T, Bytes>(p, n, threshold, bits);
+                    case cmp::ne: return compare_mask<cmp::ne, T, Bytes>(p, n, threshold, bits);
+                    case cmp::lt: return compare_mask<cmp::lt, T, Bytes>(p, n, threshold, bits);
+                    case cmp::le: return compare_mask<cmp::le, T, Bytes>(p, n, threshold, bits);
+                    case cmp::gt: return compare_mask<cmp::gt, T, Bytes>(p, n, threshold, bits);
+                    case cmp::ge: return compare_mask<cmp::ge, T, Bytes>(p, n, threshold, bits);
+                }
+                return 0;
+            }
+        }
+
+        // Entry points. SSE2 is part of the x86-64 baseline and needs no attribute.
+        template<typename T>
+        struct sse2 {
+            static size_t find(const T* p, size_t n, T v) { return generic::find<T, 16>(p, n, v); }
+            static size_t count(const T* p, size_t n, T v) { return generic::count<T, 16>(p, n, v); }
+            static indexed<T> min(const T* p, size_t n) { return generic::extreme<false, T, 16>(p, n); }
+            static indexed<T> max(const T* p, size_t n) { return generic::extreme<true, T, 16>(p, n); }
+            static sum_type<T> sum(const T* p, size_t n) { return generic::sum<T, 16>(p, n); }
+            static sum_type<T> dot(const T* a, const T* b, size_t n) { return generic::dot<T, 16>(a, b, n); }
+            static size_t compare_mask(const T* p, size_t n, cmp op, T t, uint64_t* bits) {
+                return generic::compare_mask<T, 16>(p, n, op, t, bits);
+            }
+        };
+
+        template<typename T>
+        struct avx2 {
+            [[gnu::target("avx2")]] static size_t find(const T* p, size_t n, T v) { return generic::find<T, 32>(p, n, v); }
+            [[gnu::target("avx2")]] static size_t count(const T* p, size_t n, T v) { return generic::count<T, 32>(p, n, v); }
+            [[gnu::target("avx2")]] static indexed<T> min(const T* p, size_t n) { return generic::extreme<false, T, 32>(p, n); }
+            [[gnu::target("avx2")]] static indexed<T> max(const T* p, size_t n) { return generic::extreme<true, T, 32>(p, n); }
+            [[gnu::target("avx2")]] static sum_type<T> sum(const T* p, size_t n) { return generic::sum<T, 32>(p, n); }
+            [[gnu::target("avx2")]] static sum_type<T> dot(const T* a, const T* b, size_t n) { return generic::dot<T, 32>(a, b, n); }
+            [[gnu::target("avx2")]] static size_t compare_mask(const T* p, size_t n, cmp op, T t, uint64_t* bits) {
+                return generic::compare_mask<T, 32>(p, n, op, t, bits);
+            }
+        };
+
+#define NSTL_SIMD_AVX512 gnu::target("avx512f,avx512dq,avx512bw,avx512vl")
+        template<typename T>
+        struct avx512 {
+            [[NSTL_SIMD_AVX512]] static size_t find(const T* p, size_t n, T v) { return generic::find<T, 64>(p, n, v); }
+            [[NSTL_SIMD_AVX512]] static size_t count(const T* p, size_t n, T v) { return generic::count<T, 64>(p, n, v); }
+            [[NSTL_SIMD_AVX512]] static indexed<T> min(const T* p, size_t n) { return generic::extreme<false, T, 64>(p, n); }
+            [[NSTL_SIMD_AVX512]] static indexed<T> max(const T* p, size_t n) { return generic::extreme<true, T, 64>(p, n); }
+            [[NSTL_SIMD_AVX512]] static sum_type<T> sum(const T* p, size_t n) { return generic::sum<T, 64>(p, n); }
+            [[NSTL_SIMD_AVX512]] static sum_type<T> dot(const T* a, const T* b, size_t n) { return generic::dot<T, 64>(a, b, n); }
+            [[NSTL_SIMD_AVX512]] static size_t compare_mask(const T* p, size_t n, cmp op, T t, uint64_t* bits) {
+                return generic::compare_mask<T, 64>(p, n, op, t, bits);
+            }
+        };
+#undef NSTL_SIMD_AVX512
+
+        template<template<typename> class Isa, typename T>
+        inline constexpr kernel_table<T> table_of = {
+            &Isa<T>::find, &Isa<T>::count, &Isa<T>::min, &Isa<T>::max, &Isa<T>::sum, &Isa<T>::dot, &Isa<T>::compare_mask,
+        };
+#endif
+
+        inline isa detect() noexcept {
+#if NSTL_SIMD_X86
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq") &&
+                __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512vl")) {
+                return isa::avx512;
+            }
+            if (__builtin_cpu_supports("avx2")) return isa::avx2;
+            return isa::sse2;
+#else
+            return isa::scalar;
+#endif
+        }
+    }
+
+    // Widest instruction set this CPU supports; detected once.
+    inline isa active_isa() noexcept {
+        static const isa detected = detail::detect();
+        return detected;
+    }
+
+    inline bool supported(isa level) noexcept {
+        return level <= active_isa();
+    }
+
+    // Kernels for one instruction set, e.g. to compare code paths. Asking for one the
+    // CPU lacks returns the scalar table rather than code that would fault.
+    template<element T>
+    const kernel_table<T>& kernels(isa level) noexcept {
+#if NSTL_SIMD_X86
+        if (supported(level)) {
+            switch (level) {
+                case isa::avx512: return detail::table_of<detail::avx512, T>;
+                case isa::avx2: return detail::table_of<detail::avx2, T>;
+                case isa::sse2: return detail::table_of<detail::sse2, T>;
+                case isa::scalar: break;
+            }
+        }
+#endif
+        (void)level;
+        return detail::scalar::table<T>;
+    }
+
+    namespace detail {
+        template<typename T>
+        const kernel_table<T>& active() noexcept {
+            static const kernel_table<T>& table = kernels<T>(active_isa());
+            return table;
+        }
+    }
+
+    // Index of the first element equal to value, or s.size() if there is none.
+    template<typename T, size_t Extent>
+    requires element<std::remove_const_t<T>>
+    size_t find(span<T, Extent> s, std::type_identity_t<std::remove_const_t<T>> value) {
+        return detail::active<std::remove_const_t<T>>().find(s.data(), s.size(), value);
+    }
+
+    template<typename T, size_t Extent>
+    requires element<std::remove_const_t<T>>
+    size_t count(span<T, Extent> s, std::type_identity_t<std::remove_const_t<T>> value) {
+        return detail::active<std::remove_const_t<T>>().count(s.data(), s.size(), value);
+    }
+
+    // Smallest element and the index of its first occurrence.
+    template<typename T, size_t Extent>
+    requires element<std::remove_const_t<T>>
+    indexed<std::remove_const_t<T>> min(span<T, Extent> s) {
+        if (s.empty()) [[unlikely]] {
+            throw std::out_of_range("Error: Cannot take min of an empty span");
+        }
+        return detail::active<std::remove_const_t<T>>().min(s.data(), s.size());
+    }
+
+    // Largest element and the index of its first occurrence.
+    template<typename T, size_t Extent>
+    requires element<std::remove_const_t<T>>
+    indexed<std::remove_const_t<T>> max(span<T, Extent> s) {
+        if (s.empty()) [[unlikely]] {
+            throw std::out_of_range("Error: Cannot take max of an empty span");
+        }
+        return detail::active<std::remove_const_t<T>>().max(s.data(), s.size());
+    }
+
+    template<typename T, size_t Extent>
+    requires element<std::remove_const_t<T>>
+    sum_type<std::remove_const_t<T>> sum(span<T, Extent> s) {
+        return detail::active<std::remove_const_t<T>>().sum(s.data(), s.size());
+    }
+
+    template<typename T, size_t ExtentA, typename U, size_t ExtentB>
+    requires element<std::remove_const_t<T>> && std::same_as<std::remove_const_t<T>, std::remove_const_t<U>>
+    sum_type<std::remove_const_t<T>> dot(span<T, ExtentA> a, span<U, ExtentB> b) {
+        if (a.size() != b.size()) [[unlikely]] {
+            throw std::length_error("Error: dot of spans with different sizes");
+        }
+        return detail::active<std::remove_const_t<T>>().dot(a.data(), b.data(), a.size());
+    }
+
+    // Sets bit i of bits (bit i % 64 of word i / 64) when s[i] <op> threshold, clears
+    // the rest including the padding of the last word, and returns how many were set.
+    template<typename T, size_t Extent>
+    requires element<std::remove_const_t<T>>
+    size_t compare_mask(span<T, Extent> s, cmp op, std::type_identity_t<std::remove_const_t<T>> threshold,
+                        span<uint64_t> bits) {
+        if (bits.size() < (s.size() + 63) / 64) [[unlikely]] {
+            throw std::length_error("Error: Mask span is too short");
+        }
+        return detail::active<std::remove_const_t<T>>().compare_mask(s.data(), s.size(), op, threshold, bits.data());
+    }
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <nstl/vector.hpp>
+
+namespace nstl {
+    // vector that keeps its first N elements inside the object and only goes to
+    // Alloc once it outgrows them. Growth, copies and the trivially-copyable
+    // memcpy paths are shared with nstl::vector.
+    template<typename T, size_t N, typename Alloc = std::allocator<T>, typename Growth = growth::doubling>
+    class small_vector : public detail::vector_impl<T, Alloc, N, Growth> {
+        static_assert(N > 0, "small_vector needs at least one inline element; use nstl::vector instead");
+    public:
+        using detail::vector_impl<T, Alloc, N, Growth>::vector_impl;
+
+        static constexpr size_t inline_capacity() noexcept { return N; }
+    };
+}
@@ -0,0 +1,303 @@
+#pragma once
+
+#if defined(__linux__)
+
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <nstl/allocator.hpp>
+#include <nstl/span.hpp>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace nstl {
+    // Binary checkpoint of a span of trivially copyable records.
+    //
+    // A file is one 64-byte header followed by the raw elements:
+    //
+    //   magic "NSTLSNAP" | version | byte-order mark | sizeof(T) | alignof(T)
+    //   | count | checksum of the payload | reserved
+    //
+    // save_snapshot() writes header and payload with a single writev straight from
+    // the caller's memory. load_snapshot() checks the header against T, then either
+    // maps the file or reads it in one pass into a 64-byte aligned buffer, and hands
+    // the payload out as a span<const T>; elements are never copied one by one.
+    struct snapshot_header {
+        uint64_t magic;
+        uint32_t version;
+        uint32_t byte_order;
+        uint32_t element_size;
+        uint32_t element_alignment;
+        uint64_t count;
+        uint64_t checksum;
+        unsigned char reserved[24];
+
+        static constexpr uint64_t file_magic = 0x5041'4e53'4c54'534eull; // "NSTLSNAP"
+        static constexpr uint32_t current_version = 1;
+        static constexpr uint32_t byte_order_mark = 0x01020304;
+        // How the two read back on a machine of the other endianness.
+        static constexpr uint64_t swapped_file_magic = 0x4e53'544c'534e'4150ull;
+        static constexpr uint32_t swapped_byte_order_mark = 0x04030201;
+    };
+    static_assert(sizeof(snapshot_header) == 64);
+
+    namespace detail {
+        inline uint64_t read_u64(const unsigned char* p) noexcept {
+            uint64_t v;
+            std::memcpy(&v, p, sizeof v);
+            return v;
+        }
+
+        // Payload checksum: four independent multiply-rotate lanes over 8-byte words
+        // (the xxHash64 round), so it runs at memory speed instead of a byte at a time.
+        inline uint64_t snapshot_checksum(const void* data, size_t bytes) noexcept {
+            constexpr uint64_t p1 = 0x9E3779B185EBCA87ull;
+            constexpr uint64_t p2 = 0xC2B2AE3D27D4EB4Full;
+            auto round = [](uint64_t acc, uint64_t word) {
+                return std::rotl(acc + word * p2, 31) * p1;
+            };
+
+            const auto* p = static_cast<const unsigned char*>(data);
+            uint64_t lanes[4] = {p1 + p2, p2, 0, 0 - p1};
+            size_t i = 0;
+            for (; i + 32 <= bytes; i += 32) {
+                for (int lane = 0; lane < 4; ++lane) {
+                    lanes[lane] = round(lanes[lane], read_u64(p + i + 8 * lane));
+                }
+            }
+            uint64_t h = std::rotl(lanes[0], 1) + std::rotl(lanes[1], 7) + std::rotl(lanes[2], 12) + std::rotl(lanes[3], 18);
+            h ^= bytes;
+            for (; i + 8 <= bytes; i += 8) h = std::rotl(h ^ round(0, read_u64(p + i)), 27) * p1;
+            for (; i < bytes; ++i) h = std::rotl(h ^ (p[i] * p1), 11) * p2;
+
+            h ^= h >> 33;
+            h *= p2;
+            h ^= h >> 29;
+            return h;
+        }
+
+        inline void write_fully(int fd, iovec* iov, int count, const std::string& path) {
+            while (count > 0) {
+                ssize_t written = ::writev(fd, iov, count);
+                if (written < 0) {
+                    if (errno == EINTR) continue;
+                    throw std::system_error(errno, std::generic_category(), "snapshot: cannot write " + path);
+                }
+                // Short write: skip what went out and resume mid-buffer.
+                auto left = static_cast<size_t>(written);
+                while (count > 0 && left >= iov->iov_len) {
+                    left -= iov->iov_len;
+                    ++iov;
+                    --count;
+                }
+                if (count > 0) {
+                    iov->iov_base = static_cast<char*>(iov->iov_base) + left;
+                    iov->iov_len -= left;
+                }
+            }
+        }
+    }
+
+    enum class snapshot_load {
+        map,  // mmap the file: pages are read lazily, nothing is copied
+        read, // read the file into an aligned heap buffer
+    };
+
+    template<typename T>
+    class snapshot;
+
+    // Opens and validates a snapshot of T. verify = false skips the checksum pass,
+    // which would otherwise touch every page of a mapped file up front.
+    template<typename T>
+    snapshot<T> load_snapshot(const std::string& path, snapshot_load mode = snapshot_load::map, bool verify = true);
+
+    // Read-only view of a loaded snapshot. Owns the mapping or buffer, so the span
+    // from view() is valid as long as the snapshot is.
+    template<typename T>
+    class snapshot {
+        static_assert(std::is_trivially_copyable_v<T>, "snapshots store raw bytes; T must be trivially copyable");
+        static_assert(alignof(T) <= sizeof(snapshot_header), "snapshot payloads are only aligned to 64 bytes");
+
+        using buffer_allocator = aligned_allocator<std::byte, cache_line_size>;
+
+    public:
+        using value_type = T;
+
+        snapshot(const snapshot&) = delete;
+        snapshot& operator=(const snapshot&) = delete;
+        snapshot(snapshot&& other) noexcept
+            : _base(std::exchange(other._base, nullptr)), _bytes(std::exchange(other._bytes, 0)), _mapped(other._mapped) {}
+        snapshot& operator=(snapshot&& other) noexcept {
+            if (this == &other) return *this;
+            release();
+            _base = std::exchange(other._base, nullptr);
+            _bytes = std::exchange(other._bytes, 0);
+            _mapped = other._mapped;
+            return *this;
+        }
+        ~snapshot() {
+            release();
+        }
+
+        const snapshot_header& header() const noexcept { return *reinterpret_cast<const snapshot_header*>(_base); }
+        const T* data() const noexcept { return reinterpret_cast<const T*>(_base + sizeof(snapshot_header)); }
+        size_t size() const noexcept { return header().count; }
+        bool empty() const noexcept { return size() == 0; }
+        span<const T> view() const noexcept { return span<const T>(data(), size()); }
+
+        const T& operator[](size_t idx) const noexcept { return data()[idx]; }
+        const T* begin() const noexcept { return data(); }
+        const T* end() const noexcept { return data() + size(); }
+
+    private:
+        template<typename U>
+        friend snapshot<U> load_snapshot(const std::string& path, snapshot_load mode, bool verify);
+
+        std::byte* _base = nullptr;
+        size_t _bytes = 0;
+        bool _mapped = false;
+
+        snapshot() noexcept = default;
+
+        void release() noexcept {
+            if (!_base) return;
+            if (_mapped) {
+                ::munmap(_base, _bytes);
+            } else {
+                buffer_allocator().deallocate(_base, _bytes);
+            }
+            _base = nullptr;
+        }
+
+        void validate(const std::string& path, bool verify) const {
+            auto fail = [&](const char* problem) {
+                throw std::runtime_error("snapshot: " + path + problem);
+            };
+            if (_bytes < sizeof(snapshot_header)) fail(" is too short for a header");
+            const snapshot_header& h = header();
+            // Checked before the magic, which a foreign writer stored byte-swapped too.
+            if (h.magic == snapshot_header::swapped_file_magic &&
+                h.byte_order == snapshot_header::swapped_byte_order_mark) {
+                fail(" was written with a different byte order");
+            }
+            if (h.magic != snapshot_header::file_magic || h.byte_order != snapshot_header::byte_order_mark) {
+                fail(" is not a snapshot file");
+            }
+            if (h.version != snapshot_header::current_version) fail(" has an unsupported version");
+            if (h.element_size != sizeof(T)) fail(" holds elements of a different size");
+            if (h.element_alignment != alignof(T)) fail(" holds elements of a different alignment");
+            if (h.count != (_bytes - sizeof(snapshot_header)) / sizeof(T) ||
+                (_bytes - sizeof(snapshot_header)) % sizeof(T) != 0) {
+                fail(" does not match the element count in its header");
+            }
+            if (verify && h.checksum != detail::snapshot_checksum(data(), h.count * sizeof(T))) {
+                fail(" is corrupt (checksum mismatch)");
+            }
+        }
+    };
+
+    // Writes values to path. The file is written under path + ".tmp" and renamed into
+    // place, so a crash never leaves a half-written snapshot behind; durable also
+    // fsyncs it before the rename.
+    template<typename T>
+    void save_snapshot(const std::string& path, span<const T> values, bool durable = false) {
+        static_assert(std::is_trivially_copyable_v<T>, "snapshots store raw bytes; T must be trivially copyable");
+
+        snapshot_header h{};
+        h.magic = snapshot_header::file_magic;
+        h.version = snapshot_header::current_version;
+        h.byte_order = snapshot_header::byte_order_mark;
+        h.element_size = sizeof(T);
+        h.element_alignment = alignof(T);
+        h.count = values.size();
+        h.checksum = detail::snapshot_checksum(values.data(), values.size_bytes());
+
+        std::string tmp = path + ".tmp";
+        int fd = ::open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            throw std::system_error(errno, std::generic_category(), "snapshot: cannot create " + tmp);
+        }
+        try {
+            iovec iov[2] = {
+                {&h, sizeof h},
+                {const_cast<T*>(values.data()), values.size_bytes()},
+            };
+            detail::write_fully(fd, iov, values.empty() ? 1 : 2, tmp);
+            if (durable && ::fsync(fd) != 0) {
+                throw std::system_error(errno, std::generic_category(), "snapshot: cannot sync " + tmp);
+            }
+        } catch (...) {
+            ::close(fd);
+            ::unlink(tmp.c_str());
+            throw;
+        }
+        ::close(fd);
+        if (::rename(tmp.c_str(), path.c_str()) != 0) {
+            int error = errno;
+            ::unlink(tmp.c_str());
+            throw std::system_error(error, std::generic_category(), "snapshot: cannot rename to " + path);
+        }
+    }
+
+    template<typename T>
+    snapshot<T> load_snapshot(const std::string& path, snapshot_load mode, bool verify) {
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            throw std::system_error(errno, std::generic_category(), "snapshot: cannot open " + path);
+        }
+        snapshot<T> result;
+        try {
+            struct stat st;
+            if (::fstat(fd, &st) != 0) {
+                throw std::system_error(errno, std::generic_category(), "snapshot: cannot stat " + path);
+            }
+            size_t bytes = static_cast<size_t>(st.st_size);
+            if (bytes < sizeof(snapshot_header)) {
+                throw std::runtime_error("snapshot: " + path + " is too short for a header");
+            }
+
+            if (mode == snapshot_load::map) {
+                void* p = ::mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (p == MAP_FAILED) {
+                    throw std::system_error(errno, std::generic_category(), "snapshot: cannot map " + path);
+                }
+                result._base = static_cast<std::byte*>(p);
+                result._mapped = true;
+            } else {
+                result._base = typename snapshot<T>::buffer_allocator().allocate(bytes);
+                result._mapped = false;
+            }
+            result._bytes = bytes;
+
+            for (size_t done = 0; mode == snapshot_load::read && done < bytes;) {
+                ssize_t got = ::read(fd, result._base + done, bytes - done);
+                if (got < 0) {
+                    if (errno == EINTR) continue;
+                    throw std::system_error(errno, std::generic_category(), "snapshot: cannot read " + path);
+                }
+                if (got == 0) throw std::runtime_error("snapshot: " + path + " shrank while being read");
+                done += static_cast<size_t>(got);
+            }
+            result.validate(path, verify);
+        } catch (...) {
+            ::close(fd);
+            throw;
+        }
+        ::close(fd);
+        return result;
+    }
+}
+
+#endif
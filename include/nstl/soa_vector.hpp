@@ -0,0 +1,382 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <compare>
+#include <nstl/type_traits.hpp>
+#include <nstl/allocator.hpp>
+#include <nstl/span.hpp>
+
+namespace nstl {
+    // Structure-of-arrays vector: one contiguous column per field, all sharing a
+    // single length and capacity. The columns are carved out of one block, each
+    // starting on a cache line, so a scan over one field only streams that field.
+    //
+    // Rows are tuples; operator[] and the iterators hand out tuples of references
+    // (proxies), which work with structured bindings:
+    //
+    //     for (auto [bid, ask] : quotes) spread += ask - bid;
+    //
+    // column<I>() is the fast path: an aligned_span over field I.
+    template<typename... Fields>
+    class soa_vector {
+        static_assert(sizeof...(Fields) > 0, "soa_vector needs at least one field");
+        static_assert((std::is_object_v<Fields> && ...), "soa_vector fields must be object types");
+
+        static constexpr size_t column_alignment = 64;
+        static_assert(((alignof(Fields) <= column_alignment) && ...), "soa_vector fields cannot be over-aligned");
+
+        using block_allocator = aligned_allocator<std::byte, column_alignment>;
+        using columns_type = std::tuple<Fields*...>;
+        using indices = std::index_sequence_for<Fields...>;
+
+        // Growth moves rows with nothrow moves, or copies them all if a field could throw.
+        static constexpr bool nothrow_transfer =
+            ((is_trivially_relocatable_v<Fields> || std::is_nothrow_move_constructible_v<Fields>) && ...);
+
+        template<bool Const>
+        class basic_iterator {
+            using owner_type = std::conditional_t<Const, const soa_vector, soa_vector>;
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = std::tuple<Fields...>;
+            using difference_type = std::ptrdiff_t;
+            using reference = std::conditional_t<Const, std::tuple<const Fields&...>, std::tuple<Fields&...>>;
+            using pointer = void;
+
+            basic_iterator() noexcept = default;
+            basic_iterator(owner_type* owner, size_t idx) noexcept : _owner(owner), _idx(idx) {}
+            operator basic_iterator<true>() const noexcept { return {_owner, _idx}; }
+
+            reference operator*() const noexcept { return (*_owner)[_idx]; }
+            reference operator[](difference_type n) const noexcept { return (*_owner)[_idx + n]; }
+
+            basic_iterator& operator++() noexcept { ++_idx; return *this; }
+            basic_iterator operator++(int) noexcept { auto tmp = *this; ++_idx; return tmp; }
+            basic_iterator& operator--() noexcept { --_idx; return *this; }
+            basic_iterator operator--(int) noexcept { auto tmp = *this; --_idx; return tmp; }
+            basic_iterator& operator+=(difference_type n) noexcept { _idx += n; return *this; }
+            basic_iterator& operator-=(difference_type n) noexcept { _idx -= n; return *this; }
+
+            friend basic_iterator operator+(basic_iterator it, difference_type n) noexcept { return it += n; }
+            friend basic_iterator operator+(difference_type n, basic_iterator it) noexcept { return it += n; }
+            friend basic_iterator operator-(basic_iterator it, difference_type n) noexcept { return it -= n; }
+            friend difference_type operator-(const basic_iterator& a, const basic_iterator& b) noexcept {
+                return static_cast<difference_type>(a._idx) - static_cast<difference_type>(b._idx);
+            }
+            friend bool operator==(const basic_iterator& a, const basic_iterator& b) noexcept { return a._idx == b._idx; }
+            friend auto operator<=>(const basic_iterator& a, const basic_iterator& b) noexcept { return a._idx <=> b._idx; }
+
+        private:
+            owner_type* _owner = nullptr;
+            size_t _idx = 0;
+        };
+
+    public:
+        using value_type = std::tuple<Fields...>;
+        using reference = std::tuple<Fields&...>;
+        using const_reference = std::tuple<const Fields&...>;
+        using iterator = basic_iterator<false>;
+        using const_iterator = basic_iterator<true>;
+        template<size_t I>
+        using field_type = std::tuple_element_t<I, value_type>;
+
+        soa_vector() noexcept = default;
+        ~soa_vector() {
+            release();
+        }
+        soa_vector(const soa_vector& other) {
+            if (other._length == 0) return;
+            std::byte* block = allocate_block(other._length);
+            columns_type columns = carve(block, other._length);
+            try {
+                for_each_column(
+                    [&](auto i) { copy_column(std::get<i>(other._columns), std::get<i>(columns), other._length); },
+                    [&](auto i) { std::destroy_n(std::get<i>(columns), other._length); });
+            } catch (...) {
+                deallocate_block(block, other._length);
+                throw;
+            }
+            _block = block;
+            _columns = columns;
+            _capacity = _length = other._length;
+        }
+        soa_vector(soa_vector&& other) noexcept {
+            steal(other);
+        }
+        soa_vector& operator=(const soa_vector& other) {
+            if (this == &other) return *this;
+            soa_vector copy(other);
+            swap(copy);
+            return *this;
+        }
+        soa_vector& operator=(soa_vector&& other) noexcept {
+            if (this == &other) return *this;
+            release();
+            steal(other);
+            return *this;
+        }
+
+        void swap(soa_vector& other) noexcept {
+            std::swap(_block, other._block);
+            std::swap(_columns, other._columns);
+            std::swap(_capacity, other._capacity);
+            std::swap(_length, other._length);
+        }
+        friend void swap(soa_vector& a, soa_vector& b) noexcept { a.swap(b); }
+
+        void push_back(const value_type& row) {
+            std::apply([this](const Fields&... fields) { emplace_back(fields...); }, row);
+        }
+        void push_back(value_type&& row) {
+            std::apply([this](Fields&... fields) { emplace_back(std::move(fields)...); }, row);
+        }
+
+        // Takes one constructor argument per field.
+        template<typename... Args>
+        requires (sizeof...(Args) == sizeof...(Fields))
+        reference emplace_back(Args&&... args) {
+            if (_length == _capacity) [[unlikely]] {
+                return emplace_back_slow(std::forward<Args>(args)...);
+            }
+            construct_row(_columns, _length, std::forward<Args>(args)...);
+            return (*this)[_length++];
+        }
+
+        void pop_back() {
+            if (_length == 0) [[unlikely]] {
+                throw std::out_of_range("Error: Cannot pop_back when Vector is Empty");
+            }
+            _length--;
+            destroy_rows(_columns, _length, _length + 1);
+        }
+
+        void clear() noexcept {
+            destroy_rows(_columns, 0, _length);
+            _length = 0;
+        }
+
+        reference operator[](size_t idx) noexcept {
+            return std::apply([idx](Fields*... columns) { return reference(columns[idx]...); }, _columns);
+        }
+        const_reference operator[](size_t idx) const noexcept {
+            return std::apply([idx](Fields*... columns) { return const_reference(columns[idx]...); }, _columns);
+        }
+
+        reference at(size_t idx) {
+            if (idx >= _length) [[unlikely]] {
+                throw std::out_of_range("Error: Index out of bounds");
+            }
+            return (*this)[idx];
+        }
+        const_reference at(size_t idx) const {
+            if (idx >= _length) [[unlikely]] {
+                throw std::out_of_range("Error: Index out of bounds");
+            }
+            return (*this)[idx];
+        }
+
+        // Field I of every row. Columns start on a cache line and are padded to one,
+        // so SIMD kernels can use padded_size() (see aligned_span).
+        template<size_t I>
+        aligned_span<field_type<I>, column_alignment> column() noexcept {
+            return aligned_span<field_type<I>, column_alignment>(std::get<I>(_columns), _length);
+        }
+        template<size_t I>
+        aligned_span<const field_type<I>, column_alignment> column() const noexcept {
+            return aligned_span<const field_type<I>, column_alignment>(std::get<I>(_columns), _length);
+        }
+
+        size_t size() const noexcept { return _length; }
+        bool empty() const noexcept { return _length == 0; }
+        size_t capacity() const noexcept { return _capacity; }
+
+        void reserve(size_t new_capacity) {
+            if (new_capacity <= _capacity) return;
+            reallocate(new_capacity);
+        }
+
+        void shrink_to_fit() {
+            if (_length == _capacity) return;
+            if (_length == 0) {
+                release();
+                return;
+            }
+            reallocate(_length);
+        }
+
+        iterator begin() noexcept { return {this, 0}; }
+        iterator end() noexcept { return {this, _length}; }
+        const_iterator begin() const noexcept { return {this, 0}; }
+        const_iterator end() const noexcept { return {this, _length}; }
+        const_iterator cbegin() const noexcept { return {this, 0}; }
+        const_iterator cend() const noexcept { return {this, _length}; }
+
+    private:
+        std::byte* _block = nullptr;
+        columns_type _columns{};
+        size_t _capacity = 0;
+        size_t _length = 0;
+
+        static constexpr size_t column_bytes(size_t capacity, size_t element_size) noexcept {
+            return (capacity * element_size + column_alignment - 1) & ~(column_alignment - 1);
+        }
+
+        static std::byte* allocate_block(size_t capacity) {
+            return block_allocator().allocate((column_bytes(capacity, sizeof(Fields)) + ...));
+        }
+        static void deallocate_block(std::byte* block, size_t capacity) noexcept {
+            if (block) block_allocator().deallocate(block, (column_bytes(capacity, sizeof(Fields)) + ...));
+        }
+
+        // Lays the columns out back to back, each rounded up to a cache line.
+        static columns_type carve(std::byte* block, size_t capacity) noexcept {
+            size_t offset = 0;
+            auto next = [&]<typename F>(std::type_identity<F>) {
+                F* column = reinterpret_cast<F*>(block + offset);
+                offset += column_bytes(capacity, sizeof(F));
+                return column;
+            };
+            return columns_type{next(std::type_identity<Fields>{})...};
+        }
+
+        // Calls step(i) for every column index i; if one throws, undo(i) runs for the
+        // columns that had already finished before the exception propagates.
+        template<typename Step, typename Undo>
+        static void for_each_column(Step&& step, Undo&& undo) {
+            [&]<size_t... I>(std::index_sequence<I...>) {
+                size_t done = 0;
+                try {
+                    ((step(std::integral_constant<size_t, I>{}), ++done), ...);
+                } catch (...) {
+                    ((I < done ? undo(std::integral_constant<size_t, I>{}) : void()), ...);
+                    throw;
+                }
+            }(indices{});
+        }
+
+        template<typename... Args>
+        static void construct_row(const columns_type& columns, size_t idx, Args&&... args) {
+            auto forwarded = std::forward_as_tuple(std::forward<Args>(args)...);
+            for_each_column(
+                [&](auto i) { std::construct_at(std::get<i>(columns) + idx, std::get<i>(std::move(forwarded))); },
+                [&](auto i) { std::destroy_at(std::get<i>(columns) + idx); });
+        }
+
+        static void destroy_rows(const columns_type& columns, size_t first, size_t last) noexcept {
+            std::apply([=](Fields*... column) { (std::destroy(column + first, column + last), ...); }, columns);
+        }
+
+        template<typename F>
+        static void copy_column(const F* from, F* to, size_t count) {
+            if constexpr (std::is_trivially_copyable_v<F>) {
+                if (count > 0) std::memcpy(static_cast<void*>(to), static_cast<const void*>(from), count * sizeof(F));
+            } else {
+                std::uninitialized_copy_n(from, count, to);
+            }
+        }
+
+        // Builds the first count rows of from in to. Sources stay intact until
+        // finish_transfer(), so a throwing copy leaves the container unchanged.
+        static void transfer(const columns_type& from, const columns_type& to, size_t count) {
+            for_each_column(
+                [&](auto i) {
+                    using F = field_type<i>;
+                    F* src = std::get<i>(from);
+                    F* dst = std::get<i>(to);
+                    if constexpr (is_trivially_relocatable_v<F>) {
+                        if (count > 0) std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src), count * sizeof(F));
+                    } else if constexpr (nothrow_transfer) {
+                        std::uninitialized_move_n(src, count, dst);
+                    } else {
+                        std::uninitialized_copy_n(src, count, dst);
+                    }
+                },
+                [&](auto i) {
+                    // memcpy'd columns own nothing yet; the sources still do.
+                    if constexpr (!is_trivially_relocatable_v<field_type<i>>) {
+                        std::destroy_n(std::get<i>(to), count);
+                    }
+                });
+        }
+
+        // Ends the life of the transferred rows in the old columns, except where
+        // memcpy already handed them over.
+        static void finish_transfer(const columns_type& from, size_t count) noexcept {
+            [&]<size_t... I>(std::index_sequence<I...>) {
+                auto destroy = [count]<typename F>(F* column) {
+                    if constexpr (!is_trivially_relocatable_v<F>) std::destroy_n(column, count);
+                };
+                (destroy(std::get<I>(from)), ...);
+            }(indices{});
+        }
+
+        void adopt(std::byte* block, const columns_type& columns, size_t capacity) noexcept {
+            finish_transfer(_columns, _length);
+            deallocate_block(_block, _capacity);
+            _block = block;
+            _columns = columns;
+            _capacity = capacity;
+        }
+
+        void reallocate(size_t new_capacity) {
+            std::byte* block = allocate_block(new_capacity);
+            columns_type columns = carve(block, new_capacity);
+            try {
+                transfer(_columns, columns, _length);
+            } catch (...) {
+                deallocate_block(block, new_capacity);
+                throw;
+            }
+            adopt(block, columns, new_capacity);
+        }
+
+        template<typename... Args>
+        reference emplace_back_slow(Args&&... args) {
+            size_t new_capacity = _capacity ? _capacity * 2 : 8;
+            std::byte* block = allocate_block(new_capacity);
+            columns_type columns = carve(block, new_capacity);
+            try {
+                // The new row goes first: args may refer to a row that is about to move.
+                construct_row(columns, _length, std::forward<Args>(args)...);
+                try {
+                    transfer(_columns, columns, _length);
+                } catch (...) {
+                    destroy_rows(columns, _length, _length + 1);
+                    throw;
+                }
+            } catch (...) {
+                deallocate_block(block, new_capacity);
+                throw;
+            }
+            adopt(block, columns, new_capacity);
+            return (*this)[_length++];
+        }
+
+        void release() noexcept {
+            destroy_rows(_columns, 0, _length);
+            deallocate_block(_block, _capacity);
+            _block = nullptr;
+            _columns = columns_type{};
+            _capacity = 0;
+            _length = 0;
+        }
+
+        void steal(soa_vector& other) noexcept {
+            _block = std::exchange(other._block, nullptr);
+            _columns = std::exchange(other._columns, columns_type{});
+            _capacity = std::exchange(other._capacity, 0);
+            _length = std::exchange(other._length, 0);
+        }
+    };
+
+    // The columns live in a heap block that does not point back at the object.
+    template<typename... Fields>
+    struct is_trivially_relocatable<soa_vector<Fields...>> : std::true_type {};
+}
@@ -1,12 +1,40 @@
+#pragma once
+
 #include <cstddef>
 #include <stdexcept>
 #include <limits>
 #include <iterator>
-#include <nstl/vector.hpp>
+#include <concepts>
+#include <type_traits>
+#include <memory>
 
 namespace nstl {
     inline constexpr size_t dynamic_extent = std::numeric_limits<size_t>::max();
 
+    template <typename T, size_t Extent>
+    class span;
+
+    namespace detail {
+        // Any nstl container that owns a contiguous block: vector, small_vector, ...
+        template <typename Container, typename T>
+        concept contiguous_container_of =
+            !std::is_same_v<std::remove_cv_t<Container>, span<T, dynamic_extent>> &&
+            requires(Container& c) {
+                { c.data() } -> std::convertible_to<T*>;
+                { c.size() } -> std::convertible_to<size_t>;
+                { c.empty() } -> std::convertible_to<bool>;
+            };
+
+        // Containers whose storage always comes from an allocator that guarantees
+        // Alignment (see nstl::aligned_allocator); rules out small_vector's inline buffer.
+        template <typename Container, typename T, size_t Alignment>
+        concept aligned_container_of =
+            contiguous_container_of<Container, T> &&
+            requires { { std::remove_cv_t<Container>::allocator_type::alignment } -> std::convertible_to<size_t>; } &&
+            (std::remove_cv_t<Container>::allocator_type::alignment >= Alignment) &&
+            !requires { std::remove_cv_t<Container>::inline_capacity(); };
+    }
+
     template <typename T, size_t Extent = dynamic_extent>
     class span {
     public:
@@ -17,10 +45,9 @@ namespace nstl {
 
         template <size_t N>
         explicit constexpr span(T (&arr)[N]) noexcept : span(arr, N) {}
-        template <typename Alloc>
-        constexpr span(nstl::vector<T, Alloc>& vec) noexcept : span(vec.empty() ? nullptr : &vec[0], vec.size()) {}
-        template <typename Alloc>
-        constexpr span(const nstl::vector<T, Alloc>& vec) noexcept : span(vec.empty() ? nullptr : &vec[0], vec.size()) {}
+        template <typename Container>
+        requires detail::contiguous_container_of<Container, T>
+        constexpr span(Container& c) noexcept : span(c.empty() ? nullptr : c.data(), c.size()) {}
 
         constexpr span& operator=(const span&) noexcept = default;
         constexpr span& operator=(span&&) noexcept = default;
@@ -84,7 +111,7 @@ namespace nstl {
 
     template <typename T, size_t Extent>
     requires (Extent != dynamic_extent)
-    class span {
+    class span<T, Extent> {
     public:
         constexpr span() noexcept : _ptr(nullptr) {}
         explicit constexpr span(T* ptr) noexcept : _ptr(ptr) {}
@@ -173,4 +200,27 @@ namespace nstl {
     private:
         T* _ptr;
     };
-}
\ No newline at end of file
+
+    // Dynamic span that also carries the alignment of its data: data() is
+    // Alignment-aligned (and tells the compiler so), and the storage stays
+    // accessible up to padded_size() elements, so a kernel can process whole
+    // Alignment-wide chunks without a scalar tail. Elements past size() have
+    // unspecified values.
+    template <typename T, size_t Alignment>
+    class aligned_span : public span<T> {
+    public:
+        static constexpr size_t alignment = Alignment;
+
+        constexpr aligned_span() noexcept = default;
+        // ptr must be Alignment-aligned with storage for padded_size() elements.
+        explicit constexpr aligned_span(T* ptr, size_t count) noexcept : span<T>(ptr, count) {}
+        template <typename Container>
+        requires detail::aligned_container_of<Container, T, Alignment>
+        constexpr aligned_span(Container& c) noexcept : span<T>(c) {}
+
+        constexpr T* data() const noexcept { return std::assume_aligned<Alignment>(span<T>::data()); }
+        constexpr size_t padded_size() const noexcept {
+            return ((this->size() * sizeof(T) + Alignment - 1) & ~(Alignment - 1)) / sizeof(T);
+        }
+    };
+}
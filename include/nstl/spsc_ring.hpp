@@ -0,0 +1,160 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <algorithm>
+#include <nstl/allocator.hpp>
+#include <nstl/span.hpp>
+
+namespace nstl {
+    // Lock-free ring buffer for exactly one producer thread and one consumer thread.
+    //
+    // head (next slot to read) and tail (next slot to write) sit on their own cache
+    // lines and only ever grow; slot = index & (Capacity - 1). Each side also keeps a
+    // private copy of the other side's index and only reloads it (one coherence miss)
+    // when the copy says the ring is full or empty.
+    //
+    // The span overloads move a whole batch with two index updates, and memcpy it
+    // (in at most two pieces around the wrap) when T is trivially copyable.
+    //
+    // The storage is inline, so a large ring should live on the heap.
+    template<typename T, size_t Capacity>
+    class spsc_ring {
+        static_assert(std::has_single_bit(Capacity), "Capacity must be a power of two");
+
+        static constexpr size_t mask = Capacity - 1;
+
+    public:
+        using value_type = T;
+
+        spsc_ring() noexcept = default;
+        spsc_ring(const spsc_ring&) = delete;
+        spsc_ring& operator=(const spsc_ring&) = delete;
+        ~spsc_ring() {
+            if constexpr (!std::is_trivially_destructible_v<T>) {
+                size_t tail = _tail.load(std::memory_order_relaxed);
+                for (size_t i = _head.load(std::memory_order_relaxed); i != tail; ++i) {
+                    std::destroy_at(slot(i));
+                }
+            }
+        }
+
+        // Producer side.
+
+        bool try_push(const T& value) { return try_emplace(value); }
+        bool try_push(T&& value) { return try_emplace(std::move(value)); }
+
+        template<typename... Args>
+        bool try_emplace(Args&&... args) {
+            size_t tail = _tail.load(std::memory_order_relaxed);
+            if (tail - _cached_head == Capacity) {
+                _cached_head = _head.load(std::memory_order_acquire);
+                if (tail - _cached_head == Capacity) [[unlikely]] {
+                    return false;
+                }
+            }
+            std::construct_at(slot(tail), std::forward<Args>(args)...);
+            _tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Pushes as many leading elements of values as fit; returns how many.
+        size_t try_push(span<const T> values) {
+            size_t tail = _tail.load(std::memory_order_relaxed);
+            size_t room = Capacity - (tail - _cached_head);
+            if (room < values.size()) {
+                _cached_head = _head.load(std::memory_order_acquire);
+                room = Capacity - (tail - _cached_head);
+            }
+            size_t count = std::min(room, values.size());
+            if (count == 0) return 0;
+
+            if constexpr (std::is_trivially_copyable_v<T>) {
+                size_t first = std::min(count, Capacity - (tail & mask));
+                std::memcpy(static_cast<void*>(slot(tail)), values.data(), first * sizeof(T));
+                std::memcpy(static_cast<void*>(slot(0)), values.data() + first, (count - first) * sizeof(T));
+            } else {
+                for (size_t i = 0; i < count; ++i) {
+                    try {
+                        std::construct_at(slot(tail + i), values[i]);
+                    } catch (...) {
+                        // Keep the copies that were made; the caller sees the exception.
+                        _tail.store(tail + i, std::memory_order_release);
+                        throw;
+                    }
+                }
+            }
+            _tail.store(tail + count, std::memory_order_release);
+            return count;
+        }
+
+        // Consumer side.
+
+        bool try_pop(T& out) {
+            size_t head = _head.load(std::memory_order_relaxed);
+            if (head == _cached_tail) {
+                _cached_tail = _tail.load(std::memory_order_acquire);
+                if (head == _cached_tail) [[unlikely]] {
+                    return false;
+                }
+            }
+            T* item = slot(head);
+            out = std::move(*item);
+            std::destroy_at(item);
+            _head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Pops up to out.size() elements into out; returns how many.
+        size_t try_pop(span<T> out) {
+            size_t head = _head.load(std::memory_order_relaxed);
+            size_t available = _cached_tail - head;
+            if (available < out.size()) {
+                _cached_tail = _tail.load(std::memory_order_acquire);
+                available = _cached_tail - head;
+            }
+            size_t count = std::min(available, out.size());
+            if (count == 0) return 0;
+
+            if constexpr (std::is_trivially_copyable_v<T>) {
+                size_t first = std::min(count, Capacity - (head & mask));
+                std::memcpy(static_cast<void*>(out.data()), slot(head), first * sizeof(T));
+                std::memcpy(static_cast<void*>(out.data() + first), slot(0), (count - first) * sizeof(T));
+            } else {
+                for (size_t i = 0; i < count; ++i) {
+                    T* item = slot(head + i);
+                    out[i] = std::move(*item);
+                    std::destroy_at(item);
+                }
+            }
+            _head.store(head + count, std::memory_order_release);
+            return count;
+        }
+
+        // Either side. Exact only while the other side is idle.
+        size_t size_approx() const noexcept {
+            return _tail.load(std::memory_order_acquire) - _head.load(std::memory_order_acquire);
+        }
+        bool empty() const noexcept { return size_approx() == 0; }
+        static constexpr size_t capacity() noexcept { return Capacity; }
+
+    private:
+        // Consumer-owned line.
+        alignas(cache_line_size) std::atomic<size_t> _head{0};
+        size_t _cached_tail = 0;
+        // Producer-owned line.
+        alignas(cache_line_size) std::atomic<size_t> _tail{0};
+        size_t _cached_head = 0;
+
+        alignas(cache_line_size) alignas(T) unsigned char _storage[Capacity * sizeof(T)];
+
+        T* slot(size_t index) noexcept {
+            return reinterpret_cast<T*>(_storage) + (index & mask);
+        }
+    };
+}
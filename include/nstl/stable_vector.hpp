@@ -0,0 +1,274 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <algorithm>
+#include <compare>
+#include <bit>
+#include <nstl/type_traits.hpp>
+#include <nstl/span.hpp>
+#include <nstl/vector.hpp>
+
+namespace nstl {
+    namespace detail {
+        // About a page worth of elements, rounded down to a power of two.
+        template<typename T>
+        inline constexpr size_t default_chunk_size = std::bit_floor(std::max<size_t>(4096 / sizeof(T), 16));
+    }
+
+    // Segmented vector: elements live in fixed-size chunks of ChunkSize (a power of
+    // two) and a small index of chunk pointers. Appending allocates a new chunk when
+    // the last one is full and never moves an element, so pointers and references
+    // stay valid until the element is erased. operator[] is one shift, one mask and
+    // two loads.
+    //
+    // chunk(i) exposes each chunk as a span for vectorised passes:
+    //
+    //     for (size_t c = 0; c < v.chunk_count(); ++c) process(v.chunk(c));
+    template<typename T, size_t ChunkSize = detail::default_chunk_size<T>, typename Alloc = std::allocator<T>>
+    class stable_vector {
+        static_assert(std::has_single_bit(ChunkSize), "ChunkSize must be a power of two");
+
+        using alloc_traits = std::allocator_traits<Alloc>;
+        using index_type = vector<T*, typename alloc_traits::template rebind_alloc<T*>>;
+
+        static constexpr size_t chunk_shift = std::countr_zero(ChunkSize);
+        static constexpr size_t chunk_mask = ChunkSize - 1;
+
+        template<bool Const>
+        class basic_iterator {
+            using owner_type = std::conditional_t<Const, const stable_vector, stable_vector>;
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using reference = std::conditional_t<Const, const T&, T&>;
+            using pointer = std::conditional_t<Const, const T*, T*>;
+
+            basic_iterator() noexcept = default;
+            basic_iterator(owner_type* owner, size_t idx) noexcept : _owner(owner), _idx(idx) {}
+            operator basic_iterator<true>() const noexcept { return {_owner, _idx}; }
+
+            reference operator*() const noexcept { return (*_owner)[_idx]; }
+            pointer operator->() const noexcept { return &(*_owner)[_idx]; }
+            reference operator[](difference_type n) const noexcept { return (*_owner)[_idx + n]; }
+
+            basic_iterator& operator++() noexcept { ++_idx; return *this; }
+            basic_iterator operator++(int) noexcept { auto tmp = *this; ++_idx; return tmp; }
+            basic_iterator& operator--() noexcept { --_idx; return *this; }
+            basic_iterator operator--(int) noexcept { auto tmp = *this; --_idx; return tmp; }
+            basic_iterator& operator+=(difference_type n) noexcept { _idx += n; return *this; }
+            basic_iterator& operator-=(difference_type n) noexcept { _idx -= n; return *this; }
+
+            friend basic_iterator operator+(basic_iterator it, difference_type n) noexcept { return it += n; }
+            friend basic_iterator operator+(difference_type n, basic_iterator it) noexcept { return it += n; }
+            friend basic_iterator operator-(basic_iterator it, difference_type n) noexcept { return it -= n; }
+            friend difference_type operator-(const basic_iterator& a, const basic_iterator& b) noexcept {
+                return static_cast<difference_type>(a._idx) - static_cast<difference_type>(b._idx);
+            }
+            friend bool operator==(const basic_iterator& a, const basic_iterator& b) noexcept { return a._idx == b._idx; }
+            friend auto operator<=>(const basic_iterator& a, const basic_iterator& b) noexcept { return a._idx <=> b._idx; }
+
+        private:
+            owner_type* _owner = nullptr;
+            size_t _idx = 0;
+        };
+
+    public:
+        using value_type = T;
+        using allocator_type = Alloc;
+        using iterator = basic_iterator<false>;
+        using const_iterator = basic_iterator<true>;
+
+        static constexpr size_t chunk_size = ChunkSize;
+
+        stable_vector() noexcept(noexcept(Alloc())) = default;
+        explicit stable_vector(const Alloc& alloc) noexcept : _allocator(alloc), _chunks(alloc) {}
+        ~stable_vector() {
+            release();
+        }
+        stable_vector(const stable_vector& other)
+            : _allocator(alloc_traits::select_on_container_copy_construction(other._allocator)), _chunks(_allocator) {
+            try {
+                reserve(other._length);
+                for (const T& value : other) emplace_back(value);
+            } catch (...) {
+                release();
+                throw;
+            }
+        }
+        stable_vector(stable_vector&& other) noexcept
+            : _allocator(std::move(other._allocator)), _chunks(std::move(other._chunks)), _length(std::exchange(other._length, 0)),
+              _next(std::exchange(other._next, nullptr)), _chunk_end(std::exchange(other._chunk_end, nullptr)) {}
+        stable_vector& operator=(const stable_vector& other) {
+            if (this == &other) return *this;
+            clear();
+            if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+                if (_allocator != other._allocator) release();
+                _allocator = other._allocator;
+            }
+            reserve(other._length);
+            for (const T& value : other) emplace_back(value);
+            return *this;
+        }
+        stable_vector& operator=(stable_vector&& other) noexcept {
+            static_assert(alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value,
+                          "stable_vector move assignment needs a propagating or always-equal allocator");
+            if (this == &other) return *this;
+            release();
+            if constexpr (alloc_traits::propagate_on_container_move_assignment::value) {
+                _allocator = std::move(other._allocator);
+            }
+            _chunks = std::move(other._chunks);
+            _length = std::exchange(other._length, 0);
+            _next = std::exchange(other._next, nullptr);
+            _chunk_end = std::exchange(other._chunk_end, nullptr);
+            return *this;
+        }
+
+        allocator_type get_allocator() const noexcept { return _allocator; }
+
+        void push_back(const T& value) { emplace_back(value); }
+        void push_back(T&& value) { emplace_back(std::move(value)); }
+
+        template<typename... Args>
+        T& emplace_back(Args&&... args) {
+            if (_next == _chunk_end) [[unlikely]] {
+                next_chunk();
+            }
+            // Nothing moves on growth, so args that refer to an element stay valid.
+            T* slot = _next;
+            alloc_traits::construct(_allocator, slot, std::forward<Args>(args)...);
+            _next++;
+            _length++;
+            return *slot;
+        }
+
+        void pop_back() {
+            if (_length == 0) [[unlikely]] {
+                throw std::out_of_range("Error: Cannot pop_back when Vector is Empty");
+            }
+            _length--;
+            alloc_traits::destroy(_allocator, &(*this)[_length]);
+            sync_tail();
+        }
+
+        // Destroys the elements but keeps the chunks for reuse.
+        void clear() noexcept {
+            if constexpr (!std::is_trivially_destructible_v<T>) {
+                for (size_t i = 0; i < _length; ++i) {
+                    alloc_traits::destroy(_allocator, &(*this)[i]);
+                }
+            }
+            _length = 0;
+            sync_tail();
+        }
+
+        const T& operator[](size_t idx) const noexcept {
+            return _chunks[idx >> chunk_shift][idx & chunk_mask];
+        }
+        T& operator[](size_t idx) noexcept {
+            return _chunks[idx >> chunk_shift][idx & chunk_mask];
+        }
+
+        const T& at(size_t idx) const {
+            if (idx >= _length) [[unlikely]] {
+                throw std::out_of_range("Error: Index out of bounds");
+            }
+            return (*this)[idx];
+        }
+        T& at(size_t idx) {
+            if (idx >= _length) [[unlikely]] {
+                throw std::out_of_range("Error: Index out of bounds");
+            }
+            return (*this)[idx];
+        }
+
+        size_t size() const noexcept { return _length; }
+        bool empty() const noexcept { return _length == 0; }
+        size_t capacity() const noexcept { return _chunks.size() << chunk_shift; }
+
+        // Number of chunks holding at least one element.
+        size_t chunk_count() const noexcept { return (_length + chunk_mask) >> chunk_shift; }
+        // The elements stored in chunk i; only the last chunk can be partial.
+        span<T> chunk(size_t i) noexcept {
+            return span<T>(_chunks[i], std::min(ChunkSize, _length - (i << chunk_shift)));
+        }
+        span<const T> chunk(size_t i) const noexcept {
+            return span<const T>(_chunks[i], std::min(ChunkSize, _length - (i << chunk_shift)));
+        }
+
+        void reserve(size_t new_capacity) {
+            size_t chunks = (new_capacity + chunk_mask) >> chunk_shift;
+            _chunks.reserve(chunks);
+            while (_chunks.size() < chunks) add_chunk();
+        }
+
+        // Frees the chunks past the last element.
+        void shrink_to_fit() noexcept {
+            while (_chunks.size() > chunk_count()) {
+                alloc_traits::deallocate(_allocator, _chunks[_chunks.size() - 1], ChunkSize);
+                _chunks.pop_back();
+            }
+        }
+
+        iterator begin() noexcept { return {this, 0}; }
+        iterator end() noexcept { return {this, _length}; }
+        const_iterator begin() const noexcept { return {this, 0}; }
+        const_iterator end() const noexcept { return {this, _length}; }
+        const_iterator cbegin() const noexcept { return {this, 0}; }
+        const_iterator cend() const noexcept { return {this, _length}; }
+
+    private:
+        [[no_unique_address]] Alloc _allocator;
+        index_type _chunks;
+        size_t _length = 0;
+        // Next free slot and the end of its chunk; equal (or null) when the next
+        // append has to move on to another chunk.
+        T* _next = nullptr;
+        T* _chunk_end = nullptr;
+
+        void next_chunk() {
+            size_t chunk = _length >> chunk_shift;
+            if (chunk == _chunks.size()) add_chunk();
+            _next = _chunks[chunk];
+            _chunk_end = _next + ChunkSize;
+        }
+
+        void sync_tail() noexcept {
+            if ((_length & chunk_mask) == 0) {
+                _next = _chunk_end = nullptr;
+            } else {
+                _chunk_end = _chunks[_length >> chunk_shift] + ChunkSize;
+                _next = _chunk_end - ChunkSize + (_length & chunk_mask);
+            }
+        }
+
+        void add_chunk() {
+            T* chunk = alloc_traits::allocate(_allocator, ChunkSize);
+            try {
+                _chunks.push_back(chunk);
+            } catch (...) {
+                alloc_traits::deallocate(_allocator, chunk, ChunkSize);
+                throw;
+            }
+        }
+
+        void release() noexcept {
+            clear();
+            for (T* chunk : _chunks) {
+                alloc_traits::deallocate(_allocator, chunk, ChunkSize);
+            }
+            _chunks.clear();
+            _chunks.shrink_to_fit();
+        }
+    };
+
+    // Only the chunk index lives in the object, and it is a relocatable vector.
+    template<typename T, size_t ChunkSize, typename Alloc>
+    struct is_trivially_relocatable<stable_vector<T, ChunkSize, Alloc>> : is_trivially_relocatable<Alloc> {};
+}
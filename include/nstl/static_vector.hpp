@@ -0,0 +1,188 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <nstl/type_traits.hpp>
+
+namespace nstl {
+    // What static_vector does when push_back/emplace_back find it full. Whatever the
+    // policy, try_push_back/try_emplace_back report a full vector through their
+    // return value instead.
+    namespace overflow {
+        // Throws std::length_error. The default.
+        struct throw_exception {
+            [[noreturn]] static void on_overflow() {
+                throw std::length_error("Error: static_vector capacity exceeded");
+            }
+        };
+
+        // assert()s in debug builds; with NDEBUG the check compiles away and
+        // overflowing is undefined behaviour, as with operator[].
+        struct assert_in_debug {
+            static void on_overflow() noexcept {
+                assert(false && "static_vector capacity exceeded");
+            }
+        };
+    }
+
+    namespace detail {
+        // Element slots for static_vector. Trivial types use a plain array, which is
+        // usable in constant expressions. Anything else sits in a union so no element
+        // is constructed up front; the union is trivially copyable and destructible
+        // whenever T is, so static_vector stays trivially copyable for trivially
+        // copyable T that is not trivial (a default member initializer, say).
+        template<typename T, size_t N, bool = std::is_trivial_v<T>>
+        struct static_storage {
+            T elems[N];
+        };
+        template<typename T, size_t N>
+        struct static_storage<T, N, false> {
+            union { T elems[N]; };
+            constexpr static_storage() noexcept {}
+            constexpr ~static_storage() requires std::is_trivially_destructible_v<T> = default;
+            constexpr ~static_storage() {}
+        };
+    }
+
+    // vector with a fixed capacity of N elements stored inside the object. It never
+    // allocates, so it is safe in signal handlers and on threads that must not touch
+    // the heap. Trivially copyable when T is, and usable in constexpr when T is trivial.
+    template<typename T, size_t N, typename Overflow = overflow::throw_exception>
+    class static_vector {
+        static_assert(N > 0, "static_vector needs a capacity of at least one element");
+
+    public:
+        using value_type = T;
+        using iterator = T*;
+        using const_iterator = const T*;
+
+        constexpr static_vector() noexcept {}
+
+        constexpr static_vector(const static_vector&) requires std::is_trivially_copy_constructible_v<T> = default;
+        constexpr static_vector(const static_vector& other) : static_vector() {
+            for (; _length < other._length; ++_length) {
+                std::construct_at(&_storage.elems[_length], other._storage.elems[_length]);
+            }
+        }
+        constexpr static_vector(static_vector&&) requires std::is_trivially_move_constructible_v<T> = default;
+        constexpr static_vector(static_vector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) : static_vector() {
+            for (; _length < other._length; ++_length) {
+                std::construct_at(&_storage.elems[_length], std::move(other._storage.elems[_length]));
+            }
+        }
+
+        constexpr static_vector& operator=(const static_vector&) requires std::is_trivially_copy_assignable_v<T> = default;
+        constexpr static_vector& operator=(const static_vector& other) {
+            if (this == &other) return *this;
+            clear();
+            for (; _length < other._length; ++_length) {
+                std::construct_at(&_storage.elems[_length], other._storage.elems[_length]);
+            }
+            return *this;
+        }
+        constexpr static_vector& operator=(static_vector&&) requires std::is_trivially_move_assignable_v<T> = default;
+        constexpr static_vector& operator=(static_vector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+            if (this == &other) return *this;
+            clear();
+            for (; _length < other._length; ++_length) {
+                std::construct_at(&_storage.elems[_length], std::move(other._storage.elems[_length]));
+            }
+            return *this;
+        }
+
+        constexpr ~static_vector() requires std::is_trivially_destructible_v<T> = default;
+        constexpr ~static_vector() {
+            clear();
+        }
+
+        constexpr void push_back(const T& value) { emplace_back(value); }
+        constexpr void push_back(T&& value) { emplace_back(std::move(value)); }
+
+        template<typename... Args>
+        constexpr T& emplace_back(Args&&... args) {
+            if (_length == N) [[unlikely]] {
+                Overflow::on_overflow();
+            }
+            T* slot = std::construct_at(&_storage.elems[_length], std::forward<Args>(args)...);
+            _length++;
+            return *slot;
+        }
+
+        // Return false (nullptr) instead of invoking the overflow policy when full.
+        constexpr bool try_push_back(const T& value) { return try_emplace_back(value) != nullptr; }
+        constexpr bool try_push_back(T&& value) { return try_emplace_back(std::move(value)) != nullptr; }
+
+        template<typename... Args>
+        constexpr T* try_emplace_back(Args&&... args) {
+            if (_length == N) [[unlikely]] {
+                return nullptr;
+            }
+            T* slot = std::construct_at(&_storage.elems[_length], std::forward<Args>(args)...);
+            _length++;
+            return slot;
+        }
+
+        constexpr void pop_back() {
+            if (_length == 0) [[unlikely]] {
+                throw std::out_of_range("Error: Cannot pop_back when Vector is Empty");
+            }
+            _length--;
+            std::destroy_at(&_storage.elems[_length]);
+        }
+
+        constexpr void clear() noexcept {
+            if constexpr (!std::is_trivially_destructible_v<T>) {
+                std::destroy(begin(), end());
+            }
+            _length = 0;
+        }
+
+        constexpr const T& operator[](size_t idx) const noexcept {
+            return _storage.elems[idx];
+        }
+        constexpr T& operator[](size_t idx) noexcept {
+            return _storage.elems[idx];
+        }
+
+        constexpr const T& at(size_t idx) const {
+            if (idx >= _length) [[unlikely]] {
+                throw std::out_of_range("Error: Index out of bounds");
+            }
+            return _storage.elems[idx];
+        }
+        constexpr T& at(size_t idx) {
+            if (idx >= _length) [[unlikely]] {
+                throw std::out_of_range("Error: Index out of bounds");
+            }
+            return _storage.elems[idx];
+        }
+
+        constexpr T* data() noexcept { return _storage.elems; }
+        constexpr const T* data() const noexcept { return _storage.elems; }
+
+        constexpr size_t size() const noexcept { return _length; }
+        constexpr bool empty() const noexcept { return _length == 0; }
+        constexpr bool full() const noexcept { return _length == N; }
+        static constexpr size_t capacity() noexcept { return N; }
+        static constexpr size_t max_size() noexcept { return N; }
+
+        constexpr T* begin() noexcept { return _storage.elems; }
+        constexpr T* end() noexcept { return _storage.elems + _length; }
+        constexpr const T* begin() const noexcept { return _storage.elems; }
+        constexpr const T* end() const noexcept { return _storage.elems + _length; }
+        constexpr const T* cbegin() const noexcept { return _storage.elems; }
+        constexpr const T* cend() const noexcept { return _storage.elems + _length; }
+
+    private:
+        size_t _length = 0;
+        detail::static_storage<T, N> _storage;
+    };
+
+    // The elements live in the object itself, so it relocates exactly when they do.
+    template<typename T, size_t N, typename Overflow>
+    struct is_trivially_relocatable<static_vector<T, N, Overflow>> : is_trivially_relocatable<T> {};
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <memory>
+#include <type_traits>
+
+namespace nstl {
+    // A type is trivially relocatable when moving it to a new address and ending the
+    // old object's lifetime is equivalent to copying its bytes. Containers use this to
+    // grow, insert and erase with memcpy/memmove instead of move-construct + destroy.
+    //
+    // Trivially copyable types qualify automatically. Other types opt in by
+    // specialising the trait; that is only correct for types that hold no pointers
+    // into themselves (libstdc++'s std::string does, for instance):
+    //
+    //     template<> struct nstl::is_trivially_relocatable<Order> : std::true_type {};
+    template<typename T>
+    struct is_trivially_relocatable : std::bool_constant<std::is_trivially_copyable_v<T>> {};
+
+    template<typename T>
+    struct is_trivially_relocatable<const T> : is_trivially_relocatable<T> {};
+
+    // Stateless, but its user-provided copy constructor hides that from the default.
+    template<typename T>
+    struct is_trivially_relocatable<std::allocator<T>> : std::true_type {};
+
+    template<typename T>
+    inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+    // A type is trivially hashable when equal values always have identical bytes, so
+    // hashing the object representation hashes the value. Types without padding
+    // qualify automatically; floating point does not (0.0 == -0.0). Types that keep
+    // their padding zeroed can opt in like is_trivially_relocatable.
+    template<typename T>
+    struct is_trivially_hashable : std::bool_constant<std::has_unique_object_representations_v<T>> {};
+
+    template<typename T>
+    inline constexpr bool is_trivially_hashable_v = is_trivially_hashable<std::remove_cv_t<T>>::value;
+}
@@ -1,3 +1,5 @@
+#pragma once
+
 #include <cstddef>
 #include <stdexcept>
 #include <memory>
@@ -7,6 +9,7 @@
 #include <type_traits>
 #include <algorithm>
 #include <compare>
+#include <nstl/type_traits.hpp>
 
 namespace nstl {
 
@@ -31,19 +34,23 @@ namespace nstl {
         unique_ptr(const unique_ptr&) = delete;
         unique_ptr& operator=(const unique_ptr&) = delete;
 
-        unique_ptr(unique_ptr&& other) noexcept: _ptr(other._ptr) {
+        // The deleter moves with the pointer: a stateful one knows how to free it.
+        unique_ptr(unique_ptr&& other) noexcept: _ptr(other._ptr), _deleter(std::move(other._deleter)) {
             other._ptr = nullptr;
         }
         unique_ptr& operator=(unique_ptr&& other) noexcept {
             if (this != &other){
                 if (_ptr) _deleter(_ptr);
                 _ptr = other._ptr;
+                _deleter = std::move(other._deleter);
                 other._ptr = nullptr;
             }
             return *this;
         }
 
         T* get() const {return _ptr;}
+        Deleter& get_deleter() noexcept {return _deleter;}
+        const Deleter& get_deleter() const noexcept {return _deleter;}
         T* operator->() const {return _ptr;}
         T& operator*() {return *_ptr;}
         const T& operator*() const {return *_ptr;}
@@ -79,19 +86,22 @@ namespace nstl {
         unique_ptr(const unique_ptr&) = delete;
         unique_ptr& operator=(const unique_ptr&) = delete;
 
-        unique_ptr(unique_ptr&& other) noexcept: _ptr(other._ptr) {
+        unique_ptr(unique_ptr&& other) noexcept: _ptr(other._ptr), _deleter(std::move(other._deleter)) {
             other._ptr = nullptr;
         }
         unique_ptr& operator=(unique_ptr&& other) noexcept {
             if (this != &other){
                 if (_ptr) _deleter(_ptr);
                 _ptr = other._ptr;
+                _deleter = std::move(other._deleter);
                 other._ptr = nullptr;
             }
             return *this;
         }
 
         T* get() const {return _ptr;}
+        Deleter& get_deleter() noexcept {return _deleter;}
+        const Deleter& get_deleter() const noexcept {return _deleter;}
         T& operator[](size_t idx) {return _ptr[idx];}
         const T& operator[](size_t idx) const {return _ptr[idx];}
 
@@ -116,6 +126,10 @@ namespace nstl {
         [[no_unique_address]] Deleter _deleter;
     };
 
+    // unique_ptr is a pointer plus its deleter, so it relocates exactly when the deleter does.
+    template<typename T, typename Deleter>
+    struct is_trivially_relocatable<unique_ptr<T, Deleter>> : is_trivially_relocatable<Deleter> {};
+
     template<typename T>
     concept Scalar = !std::is_array_v<T>;
 
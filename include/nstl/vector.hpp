@@ -1,233 +1,831 @@
+#pragma once
+
 #include <cstddef>
 #include <stdexcept>
 #include <memory>
+#include <memory_resource>
 #include <iostream>
 #include <utility>
 #include <cstring>
 #include <type_traits>
 #include <algorithm>
 #include <concepts>
+#include <nstl/type_traits.hpp>
+#include <nstl/allocator.hpp>
+#include <nstl/growth_policy.hpp>
+#include <nstl/span.hpp>
+#include <iterator>
+#include <ranges>
+#include <functional>
 
 namespace nstl {
-    template<typename T>
-    class vector{
-    public:
-        using iterator = T*;
-        using const_iterator = const T*;
-        //using reference = T&;
-        //using const_reference = const T&;
-        
-        constexpr vector() noexcept : _capacity(0), _length(0), _data(nullptr) {}
-        constexpr explicit vector(size_t initial_capacity) {
-            if (initial_capacity > 0) [[likely]] {
-                _capacity = initial_capacity;
-                _length = 0;
-                _data = _allocator.allocate(_capacity);
-            } else {
-                _capacity = 0;
+    // What reserve_hot() does to the reserved storage beyond size().
+    enum class reserve_flags : unsigned {
+        none = 0,
+        prefault = 1 << 0,   // touch every page now instead of faulting in push_back
+        lock = 1 << 1,       // mlock the pages so they cannot be swapped out
+        huge_pages = 1 << 2, // madvise(MADV_HUGEPAGE) before the pages are touched
+    };
+    constexpr reserve_flags operator|(reserve_flags a, reserve_flags b) noexcept {
+        return static_cast<reserve_flags>(static_cast<unsigned>(a) | static_cast<unsigned>(b));
+    }
+    constexpr bool operator&(reserve_flags a, reserve_flags b) noexcept {
+        return (static_cast<unsigned>(a) & static_cast<unsigned>(b)) != 0;
+    }
+
+    namespace detail {
+        // Element storage embedded in the container object. The N == 0 case is empty
+        // so that a plain vector pays nothing for it.
+        template<typename T, size_t N>
+        struct inline_storage {
+            alignas(T) unsigned char bytes[N * sizeof(T)];
+            T* ptr() noexcept { return reinterpret_cast<T*>(bytes); }
+            const T* ptr() const noexcept { return reinterpret_cast<const T*>(bytes); }
+        };
+        template<typename T>
+        struct inline_storage<T, 0> {};
+
+        // Allocators that can resize a block they handed out, ideally without moving
+        // it (see nstl/allocator.hpp).
+        template<typename Alloc, typename T>
+        concept reallocating_allocator = requires(Alloc& a, T* p, size_t n) {
+            { a.reallocate(p, n, n) } -> std::same_as<T*>;
+        };
+
+        // Shared implementation of vector (InlineCapacity == 0) and small_vector.
+        // While the elements fit in InlineCapacity they live in the object itself
+        // and the allocator is never touched. Growth picks each new capacity
+        // (see nstl/growth_policy.hpp).
+        template<typename T, typename Alloc, size_t InlineCapacity, typename Growth>
+        class vector_impl{
+            using alloc_traits = std::allocator_traits<Alloc>;
+            static constexpr bool propagate_on_copy = alloc_traits::propagate_on_container_copy_assignment::value;
+            static constexpr bool propagate_on_move = alloc_traits::propagate_on_container_move_assignment::value;
+            static constexpr bool propagate_on_swap = alloc_traits::propagate_on_container_swap::value;
+            static constexpr bool grows_in_place = reallocating_allocator<Alloc, T> && is_trivially_relocatable_v<T>;
+            static constexpr bool nothrow_steal =
+                InlineCapacity == 0 || is_trivially_relocatable_v<T> || std::is_nothrow_move_constructible_v<T>;
+
+        public:
+            using value_type = T;
+            using allocator_type = Alloc;
+            using iterator = T*;
+            using const_iterator = const T*;
+            //using reference = T&;
+            //using const_reference = const T&;
+
+            constexpr vector_impl() noexcept(noexcept(Alloc()))
+                : _capacity(InlineCapacity), _length(0), _data(inline_data()) {}
+            constexpr explicit vector_impl(const Alloc& alloc) noexcept
+                : _allocator(alloc), _capacity(InlineCapacity), _length(0), _data(inline_data()) {}
+            constexpr explicit vector_impl(size_t initial_capacity, const Alloc& alloc = Alloc()) : _allocator(alloc), _length(0) {
+                acquire(initial_capacity);
+            }
+            constexpr ~vector_impl(){
+                clear();
+                deallocate_storage();
+            }
+            constexpr vector_impl(const vector_impl& other)
+                : vector_impl(other, alloc_traits::select_on_container_copy_construction(other._allocator)) {}
+            constexpr vector_impl(const vector_impl& other, const Alloc& alloc)
+                : _allocator(alloc), _length(0) {
+                acquire(other._capacity);
+                copy_construct_from(other._data, other._length);
+            }
+            constexpr vector_impl(vector_impl&& other) noexcept(nothrow_steal)
+                : _allocator(std::move(other._allocator)), _length(0) {
+                if (other.is_inline()) {
+                    acquire(0);
+                    relocate_from(other);
+                } else {
+                    steal(other);
+                }
+            }
+            constexpr vector_impl(vector_impl&& other, const Alloc& alloc)
+                : _allocator(alloc), _length(0) {
+                if (_allocator == other._allocator && !other.is_inline()) {
+                    steal(other);
+                } else {
+                    // Storage cannot change hands between unequal allocators, so the elements move instead.
+                    acquire(other._length);
+                    relocate_from(other);
+                }
+            }
+            constexpr vector_impl& operator=(const vector_impl& other) {
+                if (this == &other) return *this;
+
+                if constexpr (propagate_on_copy) {
+                    if (_allocator != other._allocator) {
+                        release();
+                    }
+                    _allocator = other._allocator;
+                }
+
+                if (other._length > _capacity) {
+                    release();
+                    acquire(other._length);
+                } else {
+                    clear();
+                }
+
+                copy_construct_from(other._data, other._length);
+                return *this;
+            }
+            constexpr vector_impl& operator=(vector_impl&& other)
+                noexcept(nothrow_steal && (propagate_on_move || alloc_traits::is_always_equal::value)) {
+                if (this == &other) return *this;
+
+                if constexpr (propagate_on_move) {
+                    release();
+                    _allocator = std::move(other._allocator);
+                    if (!other.is_inline()) {
+                        steal(other);
+                        return *this;
+                    }
+                } else if (_allocator == other._allocator && !other.is_inline()) {
+                    release();
+                    steal(other);
+                    return *this;
+                }
+
+                if (other._length > _capacity) {
+                    release();
+                    acquire(other._length);
+                } else {
+                    clear();
+                }
+                relocate_from(other);
+                return *this;
+            }
+
+            constexpr void swap(vector_impl& other) noexcept(nothrow_steal) {
+                if constexpr (InlineCapacity > 0) {
+                    if (is_inline() || other.is_inline()) {
+                        vector_impl tmp(std::move(other));
+                        other = std::move(*this);
+                        *this = std::move(tmp);
+                        return;
+                    }
+                }
+                if constexpr (propagate_on_swap) {
+                    using std::swap;
+                    swap(_allocator, other._allocator);
+                }
+                std::swap(_capacity, other._capacity);
+                std::swap(_length, other._length);
+                std::swap(_data, other._data);
+            }
+            friend constexpr void swap(vector_impl& a, vector_impl& b) noexcept(nothrow_steal) { a.swap(b); }
+
+            constexpr allocator_type get_allocator() const noexcept { return _allocator; }
+
+            // value may be an element of this vector, so growth builds the new
+            // element before the old block is released.
+            constexpr void push_back(const T& value){
+                if (_length == _capacity) [[unlikely]] {
+                    emplace_back_slow(value);
+                    return;
+                }
+                alloc_traits::construct(_allocator, &_data[_length], value);
+                _length++;
+            }
+            constexpr void push_back(T&& value) {
+                if (_length == _capacity) [[unlikely]] {
+                    emplace_back_slow(std::move(value));
+                    return;
+                }
+                alloc_traits::construct(_allocator, &_data[_length], std::move(value));
+                _length++;
+            }
+
+            template <typename... Args>
+            constexpr T& emplace_back(Args&&... args) {
+                if (_length == _capacity) [[unlikely]] {
+                    return emplace_back_slow(std::forward<Args>(args)...);
+                }
+                T* ptr = &_data[_length];
+                alloc_traits::construct(_allocator, ptr, std::forward<Args>(args)...);
+                _length++;
+                return *ptr;
+            }
+
+            // Inserts a single element before pos. args may refer to an element of this
+            // vector: the new element is built on the side before anything moves.
+            template <typename... Args>
+            constexpr iterator emplace(const_iterator pos, Args&&... args) {
+                size_t index = static_cast<size_t>(pos - _data);
+                if (index == _length) {
+                    emplace_back(std::forward<Args>(args)...);
+                    return _data + index;
+                }
+                if (std::is_constant_evaluated()) {
+                    T value(std::forward<Args>(args)...);
+                    grow_for(_length + 1);
+                    open_gap(index, 1);
+                    alloc_traits::construct(_allocator, &_data[index], std::move(value));
+                } else {
+                    alignas(T) unsigned char slot[sizeof(T)];
+                    T* pending = reinterpret_cast<T*>(slot);
+                    alloc_traits::construct(_allocator, pending, std::forward<Args>(args)...);
+                    try {
+                        grow_for(_length + 1);
+                    } catch (...) {
+                        alloc_traits::destroy(_allocator, pending);
+                        throw;
+                    }
+                    open_gap(index, 1);
+                    relocate(pending, 1, &_data[index]);
+                }
+                _length++;
+                return _data + index;
+            }
+            constexpr iterator insert(const_iterator pos, const T& value) { return emplace(pos, value); }
+            constexpr iterator insert(const_iterator pos, T&& value) { return emplace(pos, std::move(value)); }
+
+            constexpr iterator erase(const_iterator pos) {
+                return erase(pos, pos + 1);
+            }
+            // Removes [first, last) and closes the gap; memmove for trivially relocatable types.
+            constexpr iterator erase(const_iterator first, const_iterator last) {
+                size_t index = static_cast<size_t>(first - _data);
+                size_t count = static_cast<size_t>(last - first);
+                if (count == 0) return _data + index;
+
+                if constexpr (!std::is_trivially_destructible_v<T>) {
+                    for (size_t i = index; i < index + count; ++i) {
+                        alloc_traits::destroy(_allocator, &_data[i]);
+                    }
+                }
+                close_gap(index, count);
+                _length -= count;
+                return _data + index;
+            }
+
+            // O(1) erase that moves the last element into pos instead of shifting the
+            // tail. Does not preserve order.
+            constexpr iterator unordered_erase(const_iterator pos) {
+                size_t index = static_cast<size_t>(pos - _data);
+                _length--;
+                alloc_traits::destroy(_allocator, &_data[index]);
+                if (index != _length) {
+                    relocate(&_data[_length], 1, &_data[index]);
+                }
+                return _data + index;
+            }
+
+            // Single-pass compaction: removes every element matching pred and returns how
+            // many went. Trivially relocatable survivors are moved down with memcpy.
+            template <typename Pred>
+            constexpr size_t erase_if(Pred pred) {
+                size_t old_length = _length;
+                if constexpr (is_trivially_relocatable_v<T>) {
+                    size_t out = 0;
+                    size_t in = 0;
+                    try {
+                        for (; in < _length; ++in) {
+                            if (pred(_data[in])) {
+                                alloc_traits::destroy(_allocator, &_data[in]);
+                            } else {
+                                if (out != in) relocate(&_data[in], 1, &_data[out]);
+                                ++out;
+                            }
+                        }
+                    } catch (...) {
+                        // Keep the vector whole: the unvisited elements follow the survivors.
+                        close_gap(out, in - out);
+                        _length -= in - out;
+                        throw;
+                    }
+                    _length = out;
+                } else {
+                    destroy_tail(static_cast<size_t>(std::remove_if(_data, _data + _length, std::ref(pred)) - _data));
+                }
+                return old_length - _length;
+            }
+
+            constexpr void clear() noexcept {
+                if constexpr (!std::is_trivially_destructible_v<T>){
+                    for (size_t i = 0; i < _length; i++){
+                        alloc_traits::destroy(_allocator, &_data[i]);
+                    }
+                }
                 _length = 0;
-                _data = nullptr;
-            }
-        }
-        constexpr ~vector(){
-            clear();
-            if (_data){
-                _allocator.deallocate(_data, _capacity);
-            }
-        }
-        constexpr vector(const vector& other): _capacity(other._capacity), _length(other._length) {
-            _data = _allocator.allocate(_capacity);
-            std::copy(other._data, other._data + other._length, _data);
-        }
-        constexpr vector(vector&& other) noexcept : _capacity(other._capacity), _length(other._length), _data(other._data) {
-            other._capacity = 0;
-            other._length = 0;
-            other._data = nullptr;
-        }
-        constexpr vector& operator=(const vector& other) {
-            if (this == &other) return *this;
-            
-            if (other._length > _capacity) {
+            }
+
+            constexpr void pop_back(){
+                if (_length == 0) [[unlikely]] {
+                    throw std::out_of_range("Error: Cannot pop_back when Vector is Empty");
+                }
+                _length--;
+                alloc_traits::destroy(_allocator, &_data[_length]);
+            }
+
+            constexpr const T& operator[](size_t idx) const noexcept {
+                return _data[idx];
+            }
+            T& operator[](size_t idx) noexcept {
+                return _data[idx];
+            }
+
+            constexpr const T& at(size_t idx) const {
+                if (idx >= _length) [[unlikely]] {
+                    throw std::out_of_range("Error: Index out of bounds");
+                }
+                return _data[idx];
+            }
+            constexpr T& at(size_t idx){
+                if (idx >= _length) [[unlikely]] {
+                    throw std::out_of_range("Error: Index out of bounds");
+                }
+                return _data[idx];
+            }
+
+            constexpr T* data() noexcept { return _data; }
+            constexpr const T* data() const noexcept { return _data; }
+
+            constexpr size_t size() const noexcept {return _length;}
+            constexpr bool empty() const noexcept {return _length == 0;}
+            constexpr size_t capacity() const noexcept {return _capacity;}
+
+            // True while the elements live in the object's inline buffer.
+            constexpr bool is_inline() const noexcept {
+                if constexpr (InlineCapacity > 0) {
+                    return _data == _inline.ptr();
+                } else {
+                    return false;
+                }
+            }
+
+            constexpr void reserve(size_t new_capacity){
+                if (new_capacity <= _capacity){
+                    return;
+                }
+                reallocate(new_capacity);
+                return;
+            }
+
+            // reserve() for latency-critical paths: the storage past size() is also made
+            // ready for writing, so later push_back/emplace_back calls never page fault.
+            // Returns false if locking or huge-page advice was refused by the kernel.
+            bool reserve_hot(size_t new_capacity, reserve_flags flags = reserve_flags::prefault) {
+                reserve(new_capacity);
+                T* tail = _data + _length;
+                size_t bytes = (_capacity - _length) * sizeof(T);
+
+                bool ok = true;
+                if (flags & reserve_flags::huge_pages) ok = advise_huge_pages(tail, bytes) && ok;
+                if (flags & reserve_flags::lock) ok = lock_pages(tail, bytes) && ok;
+                if (flags & reserve_flags::prefault) prefault_pages(tail, bytes);
+                return ok;
+            }
+
+            constexpr void shrink_to_fit(){
+                if (_length == _capacity || is_inline()) [[unlikely]] {
+                    return;
+                }
+                reallocate(_length);
+                return;
+            }
+
+            // Changes the number of elements; new ones are value-initialized (or copies of value).
+            constexpr void resize(size_t count) {
+                if (count <= _length) {
+                    destroy_tail(count);
+                    return;
+                }
+                grow_for(count);
+                for (; _length < count; ++_length) {
+                    alloc_traits::construct(_allocator, &_data[_length]);
+                }
+            }
+            constexpr void resize(size_t count, const T& value) {
+                if (count <= _length) {
+                    destroy_tail(count);
+                    return;
+                }
+                size_t offset = offset_of(&value);
+                grow_for(count);
+                const T& source = offset < _length ? _data[offset] : value;
+                for (; _length < count; ++_length) {
+                    alloc_traits::construct(_allocator, &_data[_length], source);
+                }
+            }
+            // resize() that default-initializes the new elements, which leaves trivial
+            // types uninitialized so a decoder can write straight into data().
+            constexpr void resize_for_overwrite(size_t count) {
+                if (count <= _length) {
+                    destroy_tail(count);
+                    return;
+                }
+                grow_for(count);
+                if constexpr (std::is_trivially_default_constructible_v<T>) {
+                    _length = count;
+                } else {
+                    for (; _length < count; ++_length) {
+                        alloc_traits::construct(_allocator, &_data[_length]);
+                    }
+                }
+            }
+
+            // Appends a block of elements with a single capacity check; trivially
+            // copyable elements are memcpy'd. values may point into this vector.
+            constexpr void append(span<const T> values) {
+                append_n(values.data(), values.size());
+            }
+
+            template<std::ranges::input_range R>
+            constexpr void append_range(R&& range) {
+                using Value = std::remove_cv_t<std::ranges::range_value_t<R>>;
+                if constexpr (std::ranges::contiguous_range<R> && std::ranges::sized_range<R> && std::same_as<Value, T>) {
+                    append_n(std::ranges::data(range), std::ranges::size(range));
+                } else if constexpr (std::ranges::forward_range<R>) {
+                    grow_for(_length + static_cast<size_t>(std::ranges::distance(range)));
+                    for (auto&& value : range) {
+                        alloc_traits::construct(_allocator, &_data[_length], std::forward<decltype(value)>(value));
+                        _length++;
+                    }
+                } else {
+                    for (auto&& value : range) {
+                        emplace_back(std::forward<decltype(value)>(value));
+                    }
+                }
+            }
+
+            // Inserts [first, last) before pos, growing at most once; a contiguous range of
+            // trivially copyable T is memcpy'd. The range must not come from this vector.
+            template<std::input_iterator InputIt>
+            constexpr iterator insert(const_iterator pos, InputIt first, InputIt last) {
+                size_t index = static_cast<size_t>(pos - _data);
+                if constexpr (std::forward_iterator<InputIt>) {
+                    size_t count = static_cast<size_t>(std::distance(first, last));
+                    if (count == 0) return _data + index;
+                    grow_for(_length + count);
+                    open_gap(index, count);
+                    T* dest = _data + index;
+                    if constexpr (std::is_trivially_copyable_v<T> && std::contiguous_iterator<InputIt> &&
+                                  std::same_as<std::iter_value_t<InputIt>, T>) {
+                        if (!std::is_constant_evaluated()) {
+                            std::memcpy(static_cast<void*>(dest), std::to_address(first), count * sizeof(T));
+                            _length += count;
+                            return dest;
+                        }
+                    }
+                    size_t built = 0;
+                    try {
+                        for (; first != last; ++first, ++built) {
+                            alloc_traits::construct(_allocator, dest + built, *first);
+                        }
+                    } catch (...) {
+                        // Shut the gap again so no raw slot is left inside [0, size()).
+                        for (size_t i = 0; i < built; ++i) alloc_traits::destroy(_allocator, dest + i);
+                        _length += count;
+                        close_gap(index, count);
+                        _length -= count;
+                        throw;
+                    }
+                    _length += count;
+                } else {
+                    size_t old_length = _length;
+                    for (; first != last; ++first) {
+                        emplace_back(*first);
+                    }
+                    std::rotate(_data + index, _data + old_length, _data + _length);
+                }
+                return _data + index;
+            }
+
+            // Replaces the contents with [first, last), which must not come from this vector.
+            template<std::input_iterator InputIt>
+            constexpr void assign(InputIt first, InputIt last) {
                 clear();
-                if (_data) _allocator.deallocate(_data, _capacity);
-                _capacity = other._length;
-                _data = _allocator.allocate(_capacity);
-            } else {
+                append_range(std::ranges::subrange(first, last));
+            }
+            template<std::ranges::input_range R>
+            constexpr void assign_range(R&& range) {
                 clear();
+                append_range(std::forward<R>(range));
+            }
+
+            constexpr iterator begin() noexcept { return _data; }
+            constexpr iterator end() noexcept { return _data + _length; }
+            constexpr const_iterator begin() const noexcept { return _data; }
+            constexpr const_iterator end() const noexcept { return _data + _length; }
+            constexpr const_iterator cbegin() const noexcept { return _data; }
+            constexpr const_iterator cend() const noexcept { return _data + _length; }
+
+        private:
+            [[no_unique_address]] Alloc _allocator;
+            size_t _capacity;
+            size_t _length;
+            T* _data;
+            [[no_unique_address]] inline_storage<T, InlineCapacity> _inline;
+
+            constexpr T* inline_data() noexcept {
+                if constexpr (InlineCapacity > 0) {
+                    return _inline.ptr();
+                } else {
+                    return nullptr;
+                }
+            }
+
+            // Returns storage for at least new_capacity elements: the inline buffer
+            // when they fit (rounding new_capacity up to it), the allocator otherwise.
+            constexpr T* allocate_storage(size_t& new_capacity) {
+                if constexpr (InlineCapacity > 0) {
+                    if (new_capacity <= InlineCapacity) {
+                        new_capacity = InlineCapacity;
+                        return inline_data();
+                    }
+                }
+                return new_capacity ? alloc_traits::allocate(_allocator, new_capacity) : nullptr;
+            }
+
+            constexpr void deallocate_storage() noexcept {
+                if (_data && !is_inline()) {
+                    alloc_traits::deallocate(_allocator, _data, _capacity);
+                }
+            }
+
+            // Points an empty vector without storage at room for count elements.
+            constexpr void acquire(size_t count) {
+                _data = allocate_storage(count);
+                _capacity = count;
+            }
+
+            // Moves the elements to a block of new_capacity. If allocation or an element
+            // copy throws, the vector is left as it was.
+            constexpr void reallocate(size_t new_capacity) {
+                if constexpr (grows_in_place) {
+                    if (try_reallocate(new_capacity)) return;
+                }
+
+                T* new_data = allocate_storage(new_capacity);
+                if (new_data == _data) {
+                    return;
+                }
+                try {
+                    move_into(new_data);
+                } catch (...) {
+                    free_block(new_data, new_capacity);
+                    throw;
+                }
+                deallocate_storage();
+
+                _data = new_data;
+                _capacity = new_capacity;
+            }
+
+            // Fills new_data with the elements and ends them here. When T's move may
+            // throw, the new block is built completely (copying if T is copyable) before
+            // the old elements are touched, and a throw destroys what was built.
+            constexpr void move_into(T* new_data) {
+                if constexpr (is_trivially_relocatable_v<T> || std::is_nothrow_move_constructible_v<T>) {
+                    relocate(_data, _length, new_data);
+                } else {
+                    size_t built = 0;
+                    try {
+                        for (; built < _length; ++built) {
+                            alloc_traits::construct(_allocator, &new_data[built], std::move_if_noexcept(_data[built]));
+                        }
+                    } catch (...) {
+                        for (size_t i = 0; i < built; ++i) alloc_traits::destroy(_allocator, &new_data[i]);
+                        throw;
+                    }
+                    for (size_t i = 0; i < _length; ++i) alloc_traits::destroy(_allocator, &_data[i]);
+                }
+            }
+
+            // Returns a block from allocate_storage() that was never adopted.
+            constexpr void free_block(T* block, size_t capacity) noexcept {
+                if (block && block != inline_data()) alloc_traits::deallocate(_allocator, block, capacity);
+            }
+
+            // Makes room for at least count elements. Bulk operations grow straight to
+            // count when the growth policy's next step would not be enough.
+            constexpr void grow_for(size_t count) {
+                if (count > _capacity) {
+                    reallocate(std::max(Growth::next_capacity(_capacity, sizeof(T)), count));
+                }
+            }
+
+            // Index of p if it points at one of this vector's elements, size() otherwise.
+            constexpr size_t offset_of(const T* p) const noexcept {
+                if (std::less_equal<const T*>{}(_data, p) && std::less<const T*>{}(p, _data + _length)) {
+                    return static_cast<size_t>(p - _data);
+                }
+                return _length;
+            }
+
+            constexpr void append_n(const T* src, size_t count) {
+                if (count == 0) return;
+                // src may be our own storage, which growing would free.
+                size_t offset = offset_of(src);
+                grow_for(_length + count);
+                if (offset < _length) src = _data + offset;
+
+                T* dest = _data + _length;
+                if constexpr (std::is_trivially_copyable_v<T>) {
+                    if (std::is_constant_evaluated()) {
+                        std::copy(src, src + count, dest);
+                    } else {
+                        std::memcpy(dest, src, count * sizeof(T));
+                    }
+                    _length += count;
+                } else {
+                    for (size_t i = 0; i < count; ++i, ++_length) {
+                        alloc_traits::construct(_allocator, &dest[i], src[i]);
+                    }
+                }
+            }
+
+            // Shifts [index, size()) up by count, leaving [index, index + count) as raw
+            // storage. The caller guarantees the capacity.
+            constexpr void open_gap(size_t index, size_t count) {
+                T* first = _data + index;
+                size_t tail = _length - index;
+                if constexpr (is_trivially_relocatable_v<T>) {
+                    if (!std::is_constant_evaluated()) {
+                        if (tail > 0) std::memmove(static_cast<void*>(first + count), static_cast<const void*>(first), tail * sizeof(T));
+                        return;
+                    }
+                }
+                for (size_t i = tail; i-- > 0;) {
+                    alloc_traits::construct(_allocator, &first[i + count], std::move(first[i]));
+                    alloc_traits::destroy(_allocator, &first[i]);
+                }
+            }
+
+            // Moves [index + count, size()) down onto the raw storage at index.
+            constexpr void close_gap(size_t index, size_t count) {
+                T* first = _data + index;
+                size_t tail = _length - index - count;
+                if constexpr (is_trivially_relocatable_v<T>) {
+                    if (!std::is_constant_evaluated()) {
+                        if (tail > 0) std::memmove(static_cast<void*>(first), static_cast<const void*>(first + count), tail * sizeof(T));
+                        return;
+                    }
+                }
+                for (size_t i = 0; i < tail; ++i) {
+                    alloc_traits::construct(_allocator, &first[i], std::move(first[i + count]));
+                    alloc_traits::destroy(_allocator, &first[i + count]);
+                }
             }
 
-            _length = other._length;
-            if constexpr (std::is_trivially_copyable_v<T>) {
-                 if (std::is_constant_evaluated()) {
-                     std::copy(other._data, other._data + _length, _data);
-                 } else {
-                     if (_length > 0) std::memcpy(_data, other._data, _length * sizeof(T));
-                 }
-            } else {
-                std::uninitialized_copy(other._data, other._data + _length, _data);
-            }
-            return *this;
-        }
-        constexpr vector& operator=(vector&& other) noexcept {
-            if (this != &other){
+            constexpr void destroy_tail(size_t new_length) noexcept {
+                if constexpr (!std::is_trivially_destructible_v<T>) {
+                    for (size_t i = new_length; i < _length; ++i) {
+                        alloc_traits::destroy(_allocator, &_data[i]);
+                    }
+                }
+                _length = new_length;
+            }
+
+            // Destroys the elements and hands the storage back to the allocator.
+            constexpr void release() noexcept {
                 clear();
-                if (_data) _allocator.deallocate(_data, _capacity);
+                deallocate_storage();
+                _data = inline_data();
+                _capacity = InlineCapacity;
+            }
+
+            // Takes over other's heap block; other is left empty.
+            constexpr void steal(vector_impl& other) noexcept {
                 _data = other._data;
                 _length = other._length;
                 _capacity = other._capacity;
-                other._data = nullptr;
+                other._data = other.inline_data();
                 other._length = 0;
-                other._capacity = 0;
-            }
-            return *this;
-        }
-
-        constexpr void push_back(const T& value){
-            if (_length == _capacity) {
-                size_t new_capacity = _capacity ? _capacity * 2 : 8;
-                resize(new_capacity);
-            }
-            std::construct_at(&_data[_length], value);
-            _length++;
-        }
-        constexpr void push_back(T&& value) noexcept {
-            if (_length == _capacity) {
-                size_t new_capacity = _capacity ? _capacity * 2 : 8;
-                resize(new_capacity);
-            }
-            std::construct_at(&_data[_length], std::move(value));
-            _length++;
-        }
-
-        template <typename... Args>
-        constexpr T& emplace_back(Args&&... args) {
-            if (_length == _capacity) [[unlikely]] {
-                return emplace_back_slow(std::forward<Args>(args)...);
-            }
-            T* ptr = std::construct_at(&_data[_length], std::forward<Args>(args)...);
-            _length++;
-            return *ptr;
-        }
-
-        constexpr void pop_back(){
-            if (_length == 0) [[unlikely]] {
-                throw std::out_of_range("Error: Cannot pop_back when Vector is Empty");
-            }
-            _length--;
-            std::destroy_at(&_data[_length]);
-        }
-
-        constexpr const T& operator[](size_t idx) const noexcept {
-            return _data[idx];
-        }
-        T& operator[](size_t idx) noexcept {
-            return _data[idx];
-        }
-
-        constexpr const T& at(size_t idx) const {
-            if (idx >= _length) [[unlikely]] {
-                throw std::out_of_range("Error: Index out of bounds");
-            }
-            return _data[idx];
-        }
-        constexpr T& at(size_t idx){
-            if (idx >= _length) [[unlikely]] {
-                throw std::out_of_range("Error: Index out of bounds");
-            }
-            return _data[idx];
-        }
-
-        constexpr size_t size() const noexcept {return _length;}
-        constexpr bool empty() const noexcept {return _length == 0;}
-        constexpr size_t capacity() const noexcept {return _capacity;}
-
-        constexpr void reserve(size_t new_capacity){
-            if (new_capacity <= _capacity){
-                return;
+                other._capacity = InlineCapacity;
             }
-            resize(new_capacity);
-            return;
-        }
 
-        constexpr void shrink_to_fit(){
-            if (_length == _capacity) [[unlikely]] {
-                return;
-            }
-            resize(_length);
-            return;
-        }
-
-        constexpr iterator begin() noexcept { return _data; }
-        constexpr iterator end() noexcept { return _data + _length; }
-        constexpr const_iterator begin() const noexcept { return _data; }
-        constexpr const_iterator end() const noexcept { return _data + _length; }
-        constexpr const_iterator cbegin() const noexcept { return _data; }
-        constexpr const_iterator cend() const noexcept { return _data + _length; }
-
-    private:
-        [[no_unique_address]] std::allocator<T> _allocator;
-        size_t _capacity;
-        size_t _length;
-        T* _data;
-        
-        constexpr void resize(size_t new_capacity) noexcept {
-            T* new_data = _allocator.allocate(new_capacity);
-
-            if constexpr (std::is_trivially_copyable_v<T>) {
-                if (std::is_constant_evaluated()){
-                    std::copy(_data, _data + _length, new_data);
+            // Expects an empty vector with room for count elements.
+            constexpr void copy_construct_from(const T* src, size_t count) {
+                if constexpr (std::is_trivially_copyable_v<T>) {
+                    if (std::is_constant_evaluated()) {
+                        std::copy(src, src + count, _data);
+                    } else {
+                        if (count > 0) std::memcpy(_data, src, count * sizeof(T));
+                    }
+                    _length = count;
                 } else {
-                    if (_length > 0) std::memcpy(new_data, _data, _length * sizeof(T));
+                    for (; _length < count; ++_length) {
+                        alloc_traits::construct(_allocator, &_data[_length], src[_length]);
+                    }
                 }
-            } else {
-                std::uninitialized_move(_data, _data + _length, new_data);
-                std::destroy(_data, _data + _length);
             }
 
-            if (_data) [[likely]] {
-                _allocator.deallocate(_data, _capacity);
+            // Moves count elements from first into uninitialized dest and ends their
+            // lifetime at the source. Trivially relocatable types are a plain memcpy.
+            constexpr void relocate(T* first, size_t count, T* dest) {
+                if constexpr (is_trivially_relocatable_v<T>) {
+                    if (!std::is_constant_evaluated()) {
+                        if (count > 0) std::memcpy(static_cast<void*>(dest), static_cast<const void*>(first), count * sizeof(T));
+                        return;
+                    }
+                }
+                for (size_t i = 0; i < count; ++i) {
+                    alloc_traits::construct(_allocator, &dest[i], std::move(first[i]));
+                    alloc_traits::destroy(_allocator, &first[i]);
+                }
             }
 
-            _data = new_data;
-            _capacity = new_capacity;
-        }
-
-        constexpr void clear() noexcept {
-            if constexpr (!std::is_trivially_destructible_v<T>){
-                for (size_t i = 0; i < _length; i++){
-                    std::destroy_at(&_data[i]);
+            // Resizes the current heap block through the allocator, which may extend it
+            // in place. Returns false when there is no block to resize.
+            constexpr bool try_reallocate(size_t new_capacity) {
+                if (std::is_constant_evaluated() || !_data || is_inline() || new_capacity <= InlineCapacity) {
+                    return false;
                 }
+                _data = _allocator.reallocate(_data, _capacity, new_capacity);
+                _capacity = new_capacity;
+                return true;
             }
-            _length = 0;
-        }
 
-        template <typename... Args>
-        //__attribute__((noinline, cold))
-        constexpr T& emplace_back_slow(Args&&... args) {
-            size_t new_capacity = _capacity ? _capacity * 2 : 8;
-            T* new_data = _allocator.allocate(new_capacity);
+            // Relocates other's elements into this empty vector; other is left empty.
+            constexpr void relocate_from(vector_impl& other) {
+                relocate(other._data, other._length, _data);
+                _length = other._length;
+                other._length = 0;
+            }
 
-            T* new_element = std::construct_at(&new_data[_length], std::forward<Args>(args)...);
+            template <typename... Args>
+            //__attribute__((noinline, cold))
+            constexpr T& emplace_back_slow(Args&&... args) {
+                size_t new_capacity = Growth::next_capacity(_capacity, sizeof(T));
 
-            if constexpr (std::is_trivially_copyable_v<T>) {
-                if (std::is_constant_evaluated()){
-                    std::copy(_data, _data + _length, new_data);
-                } else {
-                    if (_length > 0) std::memcpy(new_data, _data, _length * sizeof(T));
+                if constexpr (grows_in_place) {
+                    if (!std::is_constant_evaluated() && _data && !is_inline()) {
+                        // args may point into the block that reallocate is about to move,
+                        // so the element is built on the side and relocated in afterwards.
+                        alignas(T) unsigned char slot[sizeof(T)];
+                        T* pending = reinterpret_cast<T*>(slot);
+                        alloc_traits::construct(_allocator, pending, std::forward<Args>(args)...);
+                        try {
+                            try_reallocate(new_capacity);
+                        } catch (...) {
+                            alloc_traits::destroy(_allocator, pending);
+                            throw;
+                        }
+                        relocate(pending, 1, &_data[_length]);
+                        return _data[_length++];
+                    }
+                }
+
+                T* new_data = allocate_storage(new_capacity);
+
+                T* new_element = &new_data[_length];
+                try {
+                    alloc_traits::construct(_allocator, new_element, std::forward<Args>(args)...);
+                } catch (...) {
+                    free_block(new_data, new_capacity);
+                    throw;
                 }
-            } else {
-                for (size_t i = 0; i < _length; ++i) {
-                    std::construct_at(&new_data[i], std::move(_data[i]));
-                    std::destroy_at(&_data[i]);
+                try {
+                    move_into(new_data);
+                } catch (...) {
+                    alloc_traits::destroy(_allocator, new_element);
+                    free_block(new_data, new_capacity);
+                    throw;
                 }
+                deallocate_storage();
+
+                _data = new_data;
+                _capacity = new_capacity;
+                _length++;
+                return *new_element;
             }
+        };
+    }
 
-            if (_data) _allocator.deallocate(_data, _capacity);
+    // std::erase / std::erase_if counterparts for vector and small_vector.
+    template<typename T, typename Alloc, size_t N, typename Growth, typename Pred>
+    constexpr size_t erase_if(detail::vector_impl<T, Alloc, N, Growth>& c, Pred pred) {
+        return c.erase_if(pred);
+    }
+    template<typename T, typename Alloc, size_t N, typename Growth, typename U>
+    constexpr size_t erase(detail::vector_impl<T, Alloc, N, Growth>& c, const U& value) {
+        return c.erase_if([&value](const T& element) { return element == value; });
+    }
 
-            _data = new_data;
-            _capacity = new_capacity;
-            _length++;
-            return *new_element;
-        }
+    template<typename T, typename Alloc = std::allocator<T>, typename Growth = growth::doubling>
+    class vector : public detail::vector_impl<T, Alloc, 0, Growth> {
+    public:
+        using detail::vector_impl<T, Alloc, 0, Growth>::vector_impl;
     };
-}
\ No newline at end of file
+
+    // vector holds no pointers into itself, so it can be moved with memcpy
+    // whenever its allocator can. small_vector cannot while it is inline.
+    template<typename T, typename Alloc, typename Growth>
+    struct is_trivially_relocatable<vector<T, Alloc, Growth>> : is_trivially_relocatable<Alloc> {};
+
+    // vector whose data() is Alignment-aligned and padded to whole Alignment-sized
+    // chunks; converts to nstl::aligned_span<T, Alignment>.
+    template<typename T, size_t Alignment = 64, typename Growth = growth::doubling>
+    using aligned_vector = vector<T, aligned_allocator<T, Alignment>, Growth>;
+
+    namespace pmr {
+        // Vector whose storage comes from a std::pmr::memory_resource, e.g. a per-tick
+        // std::pmr::monotonic_buffer_resource that is released wholesale.
+        template<typename T>
+        using vector = nstl::vector<T, std::pmr::polymorphic_allocator<T>>;
+    }
+}
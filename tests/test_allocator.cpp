@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <nstl/allocator.hpp>
+#include <nstl/vector.hpp>
+#include <nstl/span.hpp>
+
+namespace {
+
+// malloc_allocator that records how often the vector asked it to resize in place.
+template <typename T>
+struct RecordingAlloc : nstl::malloc_allocator<T> {
+    static int reallocations;
+
+    RecordingAlloc() = default;
+    template <typename U>
+    RecordingAlloc(const RecordingAlloc<U>&) noexcept {}
+
+    T* reallocate(T* p, size_t old_n, size_t new_n) {
+        ++reallocations;
+        return nstl::malloc_allocator<T>::reallocate(p, old_n, new_n);
+    }
+};
+template <typename T>
+int RecordingAlloc<T>::reallocations = 0;
+
+}
+
+TEST(MallocAllocatorTest, GrowthReallocatesInsteadOfCopying) {
+    RecordingAlloc<int>::reallocations = 0;
+    nstl::vector<int, RecordingAlloc<int>> v;
+    for (int i = 0; i < 1000; ++i) v.push_back(i);
+
+    // 8 -> 16 -> ... -> 1024: the first block is allocated, the other seven are resized.
+    EXPECT_EQ(RecordingAlloc<int>::reallocations, 7);
+    for (int i = 0; i < 1000; ++i) ASSERT_EQ(v[i], i);
+}
+
+TEST(MallocAllocatorTest, NonRelocatableTypesStillCopy) {
+    RecordingAlloc<std::string>::reallocations = 0;
+    nstl::vector<std::string, RecordingAlloc<std::string>> v;
+    for (int i = 0; i < 100; ++i) v.push_back(std::to_string(i));
+
+    EXPECT_EQ(RecordingAlloc<std::string>::reallocations, 0);
+    EXPECT_EQ(v[99], "99");
+}
+
+TEST(MallocAllocatorTest, EmplaceFromOwnElementDuringGrowth) {
+    nstl::vector<long, nstl::malloc_allocator<long>> v;
+    for (long i = 0; i < 8; ++i) v.push_back(i + 1);
+
+    // The argument aliases the block that is about to be resized.
+    v.emplace_back(v[3]);
+    EXPECT_EQ(v.size(), 9);
+    EXPECT_EQ(v[8], 4);
+}
+
+TEST(MallocAllocatorTest, ShrinkToFit) {
+    nstl::vector<int, nstl::malloc_allocator<int>> v;
+    for (int i = 0; i < 100; ++i) v.push_back(i);
+    v.shrink_to_fit();
+    EXPECT_EQ(v.capacity(), 100);
+    EXPECT_EQ(v[99], 99);
+}
+
+#if defined(__linux__)
+TEST(PageAllocatorTest, GrowsLargeBufferWithMremap) {
+    nstl::vector<double, nstl::page_allocator<double>> v;
+    const size_t n = 4 << 20; // 32 MB of doubles
+    for (size_t i = 0; i < n; ++i) v.push_back(static_cast<double>(i));
+
+    EXPECT_EQ(v.size(), n);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(v.data()) % nstl::page_allocator<double>::page_size(), 0u);
+    for (size_t i = 0; i < n; i += 4099) ASSERT_EQ(v[i], static_cast<double>(i));
+    EXPECT_EQ(v[n - 1], static_cast<double>(n - 1));
+}
+#endif
+
+TEST(AlignedAllocatorTest, StorageIsAlignedAndPadded) {
+    static_assert(nstl::aligned_allocator<float, 64>::padded_bytes(1) == 64);
+    static_assert(nstl::aligned_allocator<float, 64>::padded_bytes(16) == 64);
+    static_assert(nstl::aligned_allocator<float, 64>::padded_bytes(17) == 128);
+
+    nstl::aligned_vector<double, 128> v;
+    for (int i = 0; i < 1000; ++i) {
+        v.push_back(i);
+        ASSERT_EQ(reinterpret_cast<uintptr_t>(v.data()) % 128, 0u);
+    }
+    v.shrink_to_fit();
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(v.data()) % 128, 0u);
+    EXPECT_EQ(v[999], 999.0);
+}
+
+TEST(AlignedAllocatorTest, AlignedSpanCoversPadding) {
+    nstl::aligned_vector<float> v;
+    v.resize(13, 2.0f);
+
+    nstl::aligned_span<float, 64> s = v;
+    EXPECT_EQ(s.data(), v.data());
+    EXPECT_EQ(s.size(), 13u);
+    EXPECT_EQ(s.padded_size(), 16u);
+    // The padding belongs to the allocation, so a full-width pass may touch it.
+    for (size_t i = 0; i < s.padded_size(); ++i) s.data()[i] = 3.0f;
+    EXPECT_EQ(v[12], 3.0f);
+
+    nstl::span<float> plain = s;
+    EXPECT_EQ(plain.size(), 13u);
+
+    static_assert(std::is_constructible_v<nstl::aligned_span<float, 32>, nstl::aligned_vector<float, 64>&>);
+    static_assert(!std::is_constructible_v<nstl::aligned_span<float, 128>, nstl::aligned_vector<float, 64>&>);
+    static_assert(!std::is_constructible_v<nstl::aligned_span<float, 64>, nstl::vector<float>&>);
+}
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include <nstl/concurrent_vector.hpp>
+
+namespace {
+
+struct Event {
+    int producer;
+    int sequence;
+};
+
+}
+
+TEST(ConcurrentVectorTest, SingleThreadAppendAndIndex) {
+    nstl::concurrent_vector<int> v;
+    int* first = &v.push_back(0);
+    for (int i = 1; i < 10000; ++i) v.push_back(i);
+
+    EXPECT_EQ(v.size(), 10000);
+    EXPECT_EQ(v.reserved(), 10000);
+    EXPECT_EQ(first, &v[0]); // elements never move
+    for (int i = 0; i < 10000; ++i) ASSERT_EQ(v[i], i);
+    EXPECT_THROW(v.at(10000), std::out_of_range);
+    EXPECT_EQ(std::count_if(v.begin(), v.end(), [](int x) { return x % 2 == 0; }), 5000);
+}
+
+TEST(ConcurrentVectorTest, ProducersLoseNothing) {
+    constexpr int producers = 8;
+    constexpr int per_producer = 20000;
+    nstl::concurrent_vector<Event> v;
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&v, p] {
+            for (int i = 0; i < per_producer; ++i) v.push_back({p, i});
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    ASSERT_EQ(v.size(), size_t(producers) * per_producer);
+    // Each producer's events appear in its own program order.
+    std::vector<int> next(producers, 0);
+    for (const Event& e : v) {
+        ASSERT_EQ(e.sequence, next[e.producer]);
+        next[e.producer]++;
+    }
+    for (int n : next) EXPECT_EQ(n, per_producer);
+}
+
+TEST(ConcurrentVectorTest, ReadersSeeOnlyConstructedPrefix) {
+    nstl::concurrent_vector<std::string> v;
+    std::atomic<bool> done{false};
+
+    std::thread reader([&] {
+        while (!done.load()) {
+            size_t n = v.size();
+            for (size_t i = 0; i < n; ++i) {
+                ASSERT_EQ(v[i], "Long string to defeat Small String Optimization");
+            }
+        }
+    });
+    std::vector<std::thread> writers;
+    for (int w = 0; w < 4; ++w) {
+        writers.emplace_back([&] {
+            for (int i = 0; i < 2000; ++i) {
+                v.emplace_back("Long string to defeat Small String Optimization");
+            }
+        });
+    }
+    for (auto& t : writers) t.join();
+    done = true;
+    reader.join();
+    EXPECT_EQ(v.size(), 8000);
+}
+
+TEST(ConcurrentVectorTest, CopyMoveAndReserve) {
+    nstl::concurrent_vector<int> v;
+    v.reserve(1000);
+    EXPECT_TRUE(v.empty());
+    for (int i = 0; i < 1000; ++i) v.push_back(i);
+
+    nstl::concurrent_vector<int> copy = v;
+    EXPECT_TRUE(std::equal(v.begin(), v.end(), copy.begin(), copy.end()));
+
+    nstl::concurrent_vector<int> moved = std::move(v);
+    EXPECT_TRUE(v.empty());
+    EXPECT_EQ(moved[999], 999);
+
+    copy = moved;
+    EXPECT_EQ(copy.size(), 1000);
+}
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include <functional>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <nstl/flat_map.hpp>
+#include <nstl/vector.hpp>
+
+TEST(FlatMapTest, BulkConstructionSortsColumnsTogether) {
+    nstl::vector<int> keys;
+    nstl::vector<std::string> values;
+    for (int k : {30, 10, 20, 10}) {
+        keys.push_back(k);
+        values.push_back("v" + std::to_string(k) + "_" + std::to_string(values.size()));
+    }
+    nstl::flat_map<int, std::string> map(std::move(keys), std::move(values));
+    ASSERT_EQ(map.size(), 3u);
+    EXPECT_TRUE(std::ranges::equal(map.keys(), std::vector<int>{10, 20, 30}));
+    // The first of duplicate keys wins.
+    EXPECT_EQ(map.at(10), "v10_1");
+    EXPECT_EQ(map.at(30), "v30_0");
+
+    nstl::vector<int> k2;
+    nstl::vector<std::string> v2;
+    k2.push_back(1);
+    EXPECT_THROW((nstl::flat_map<int, std::string>(std::move(k2), std::move(v2))), std::length_error);
+
+    std::vector<std::pair<int, double>> rows{{3, 0.3}, {1, 0.1}, {2, 0.2}};
+    nstl::flat_map<int, double> from_pairs(rows);
+    EXPECT_EQ(from_pairs.begin()->first, 1);
+    EXPECT_EQ(from_pairs.values()[2], 0.3);
+}
+
+TEST(FlatMapTest, InsertLookupAndErase) {
+    nstl::flat_map<int, int> map;
+    EXPECT_TRUE(map.try_emplace(5, 50).second);
+    EXPECT_TRUE(map.insert({1, 10}).second);
+    EXPECT_FALSE(map.emplace(5, 99).second);
+    EXPECT_EQ(map[5], 50);
+    map[3] = 30;
+    EXPECT_FALSE(map.insert_or_assign(1, 11).second);
+    EXPECT_EQ(map.at(1), 11);
+    EXPECT_THROW(map.at(2), std::out_of_range);
+
+    int sum = 0;
+    for (auto [key, value] : map) {
+        value += 1;
+        sum += key;
+    }
+    EXPECT_EQ(sum, 9);
+    EXPECT_EQ(map.at(3), 31);
+
+    auto it = map.find(3);
+    ASSERT_NE(it, map.end());
+    it->second = 7;
+    EXPECT_EQ(map.at(3), 7);
+    EXPECT_EQ(map.find(4), map.end());
+    EXPECT_EQ(map.lower_bound(4)->first, 5);
+    EXPECT_EQ(map.upper_bound(5), map.end());
+
+    EXPECT_EQ(map.erase(1), 1u);
+    EXPECT_EQ(map.erase(map.find(3))->first, 5);
+    EXPECT_EQ(map.size(), 1u);
+    map.erase(map.begin(), map.end());
+    EXPECT_TRUE(map.empty());
+}
+
+TEST(FlatMapTest, InsertRangeMatchesStdMap) {
+    std::mt19937 rng(5);
+    nstl::flat_map<int, int> map;
+    std::map<int, int> expected;
+    for (int round = 0; round < 50; ++round) {
+        std::vector<std::pair<int, int>> batch;
+        for (int i = 0; i < 40; ++i) {
+            int key = static_cast<int>(rng() % 300) + (round % 4 == 0 ? 1000 * round : 0);
+            batch.emplace_back(key, round * 100 + i);
+        }
+        map.insert_range(batch);
+        for (auto& [k, v] : batch) expected.emplace(k, v);
+        ASSERT_EQ(map.size(), expected.size());
+        auto e = expected.begin();
+        for (auto [k, v] : map) {
+            ASSERT_EQ(k, e->first);
+            ASSERT_EQ(v, e->second);
+            ++e;
+        }
+    }
+}
+
+TEST(FlatMapTest, HeterogeneousLookup) {
+    nstl::flat_map<std::string, int, std::less<>> book;
+    book["MSFT"] = 1;
+    book["AAPL"] = 2;
+    std::string_view key = "AAPL";
+    EXPECT_TRUE(book.contains(key));
+    EXPECT_EQ(book.at(key), 2);
+    EXPECT_EQ(book.find(std::string_view("MSFT"))->second, 1);
+    EXPECT_EQ(book.count(std::string_view("NVDA")), 0u);
+    EXPECT_EQ(book.erase(std::string_view("MSFT")), 1u);
+
+    const auto& view = book;
+    EXPECT_EQ(view.find(key).value(), 2);
+    EXPECT_EQ(view.values()[0], 2);
+}
@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <set>
+#include <string>
+#include <string_view>
+#include <nstl/flat_set.hpp>
+#include <nstl/vector.hpp>
+
+TEST(FlatSetTest, BulkConstructionSortsAndDedupes) {
+    nstl::vector<int> keys;
+    for (int k : {5, 1, 9, 1, 3, 5, 7}) keys.push_back(k);
+    nstl::flat_set<int> set(std::move(keys));
+    ASSERT_EQ(set.size(), 5u);
+    EXPECT_TRUE(std::ranges::equal(set.keys(), std::vector<int>{1, 3, 5, 7, 9}));
+
+    nstl::vector<int> sorted;
+    for (int k : {2, 4, 6}) sorted.push_back(k);
+    nstl::flat_set<int> trusted(nstl::sorted_unique, std::move(sorted));
+    EXPECT_TRUE(trusted.contains(4));
+
+    std::vector<int> from_std{3, 3, 2};
+    nstl::flat_set<int, std::greater<int>> descending(from_std);
+    EXPECT_EQ(*descending.begin(), 3);
+    EXPECT_EQ(descending.size(), 2u);
+}
+
+TEST(FlatSetTest, InsertAndEraseKeepOrder) {
+    nstl::flat_set<int> set;
+    EXPECT_TRUE(set.insert(10).second);
+    EXPECT_TRUE(set.insert(5).second);
+    EXPECT_TRUE(set.emplace(7).second);
+    auto [it, inserted] = set.insert(5);
+    EXPECT_FALSE(inserted);
+    EXPECT_EQ(*it, 5);
+    EXPECT_TRUE(std::ranges::equal(set, std::vector<int>{5, 7, 10}));
+
+    EXPECT_EQ(set.erase(7), 1u);
+    EXPECT_EQ(set.erase(7), 0u);
+    EXPECT_EQ(*set.erase(set.begin()), 10);
+    EXPECT_EQ(set.size(), 1u);
+    EXPECT_EQ(set.lower_bound(3), set.begin());
+    EXPECT_EQ(set.upper_bound(10), set.end());
+}
+
+TEST(FlatSetTest, InsertRangeMatchesStdSet) {
+    std::mt19937 rng(11);
+    nstl::flat_set<int> set;
+    std::set<int> expected;
+    for (int round = 0; round < 50; ++round) {
+        std::vector<int> batch;
+        for (int i = 0; i < 40; ++i) batch.push_back(static_cast<int>(rng() % 500) + (round % 3 == 0 ? 1000 * round : 0));
+        set.insert_range(batch);
+        expected.insert(batch.begin(), batch.end());
+        ASSERT_TRUE(std::ranges::equal(set, expected)) << round;
+    }
+    for (int probe = -5; probe < 1200; ++probe) {
+        ASSERT_EQ(set.contains(probe), expected.count(probe) == 1);
+        ASSERT_EQ(*set.lower_bound(probe) == *expected.lower_bound(probe) || set.lower_bound(probe) == set.end(), true);
+    }
+}
+
+TEST(FlatSetTest, HeterogeneousLookup) {
+    nstl::vector<std::string> symbols;
+    for (const char* s : {"MSFT", "AAPL", "NVDA"}) symbols.emplace_back(s);
+    nstl::flat_set<std::string, std::less<>> set(std::move(symbols));
+    std::string_view aapl = "AAPL";
+    EXPECT_TRUE(set.contains(aapl));
+    EXPECT_EQ(set.find(std::string_view("NVDA")) - set.begin(), 2);
+    EXPECT_EQ(set.count(std::string_view("TSLA")), 0u);
+    EXPECT_EQ(set.erase(std::string_view("MSFT")), 1u);
+    EXPECT_EQ(set.size(), 2u);
+
+    nstl::vector<std::string> keys = std::move(set).extract();
+    EXPECT_EQ(keys.size(), 2u);
+}
@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <nstl/hash.hpp>
+#include <nstl/hash_map.hpp>
+#include <nstl/span.hpp>
+#include <nstl/vector.hpp>
+
+namespace {
+
+nstl::span<const std::byte> bytes_of(std::string_view s) {
+    return nstl::span<const std::byte>(reinterpret_cast<const std::byte*>(s.data()), s.size());
+}
+
+struct Header {
+    uint32_t sequence;
+    uint16_t type;
+    uint16_t length;
+};
+
+}
+
+TEST(HashTest, KnownAnswers) {
+    // wyhash's reference vectors: message i is hashed with seed i.
+    struct Vector {
+        std::string_view message;
+        uint64_t expected;
+    };
+    const Vector vectors[] = {
+        {"", 0x0409638ee2bde459ull},
+        {"a", 0xa8412d091b5fe0a9ull},
+        {"abc", 0x32dd92e4b2915153ull},
+        {"message digest", 0x8619124089a3a16bull},
+        {"abcdefghijklmnopqrstuvwxyz", 0x7a43afb61d7f5f40ull},
+        {"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789", 0xff42329b90e50d58ull},
+        {"12345678901234567890123456789012345678901234567890123456789012345678901234567890", 0xc39cab13b115aad3ull},
+    };
+    for (uint64_t seed = 0; seed < std::size(vectors); ++seed) {
+        EXPECT_EQ(nstl::hash_bytes(bytes_of(vectors[seed].message), seed), vectors[seed].expected) << seed;
+    }
+}
+
+TEST(HashTest, DeterministicAndSeeded) {
+    std::string text(300, 'x');
+    for (size_t i = 0; i < text.size(); ++i) text[i] = static_cast<char>('a' + (i * 7) % 26);
+    std::unordered_set<uint64_t> seen;
+    for (size_t len = 0; len <= text.size(); ++len) {
+        uint64_t h = nstl::hash_bytes(bytes_of(std::string_view(text).substr(0, len)));
+        EXPECT_EQ(h, nstl::hash_bytes(bytes_of(std::string(text, 0, len))));
+        EXPECT_NE(h, nstl::hash_bytes(bytes_of(std::string_view(text).substr(0, len)), 1));
+        // Every prefix hashes differently, including around the 3/4/16/48 byte paths.
+        EXPECT_TRUE(seen.insert(h).second) << len;
+    }
+}
+
+TEST(HashTest, EveryInputBitMatters) {
+    // Flipping one input bit flips about half of the output bits.
+    for (size_t len : {1, 3, 4, 8, 13, 16, 17, 48, 49, 100}) {
+        nstl::vector<std::byte> key;
+        for (size_t i = 0; i < len; ++i) key.push_back(static_cast<std::byte>(i * 31 + 5));
+        uint64_t base = nstl::hash_bytes(nstl::span<const std::byte>(key));
+        int total = 0;
+        for (size_t bit = 0; bit < len * 8; ++bit) {
+            key[bit / 8] ^= static_cast<std::byte>(1 << (bit % 8));
+            int flipped = std::popcount(base ^ nstl::hash_bytes(nstl::span<const std::byte>(key)));
+            key[bit / 8] ^= static_cast<std::byte>(1 << (bit % 8));
+            ASSERT_GT(flipped, 8) << len << " " << bit;
+            total += flipped;
+        }
+        double mean = static_cast<double>(total) / static_cast<double>(len * 8);
+        EXPECT_GT(mean, 28.0) << len;
+        EXPECT_LT(mean, 36.0) << len;
+    }
+}
+
+TEST(HashTest, TypedAndFixedExtentMatchBytes) {
+    uint64_t ids[5] = {1, 2, 3, 4, 5};
+    auto raw = nstl::span<const std::byte>(reinterpret_cast<const std::byte*>(ids), sizeof(ids));
+    uint64_t expected = nstl::hash_bytes(raw, 9);
+    EXPECT_EQ(nstl::hash_bytes(nstl::span<uint64_t>(ids, 5), 9), expected);
+    EXPECT_EQ(nstl::hash_bytes(nstl::span<uint64_t, 5>(static_cast<uint64_t*>(ids)), 9), expected);
+    for (size_t n = 0; n <= 5; ++n) {
+        EXPECT_EQ(nstl::hash_bytes(nstl::span<const uint64_t>(ids, n)), nstl::hash_bytes(raw.first(n * 8)));
+    }
+    EXPECT_EQ(nstl::hash_bytes(nstl::span<uint64_t, 1>(ids)), nstl::hash_bytes(raw.first(8)));
+    EXPECT_EQ(nstl::hash_bytes(nstl::span<uint64_t, 2>(ids)), nstl::hash_bytes(raw.first(16)));
+    EXPECT_EQ(nstl::hash_bytes(nstl::span<uint64_t, 3>(ids)), nstl::hash_bytes(raw.first(24)));
+
+    Header header{7, 2, 64};
+    EXPECT_EQ(nstl::hash_bytes(nstl::span<Header, 1>(&header)), nstl::hash_bytes(nstl::span<const Header>(&header, 1)));
+    static_assert(nstl::is_trivially_hashable_v<Header>);
+    static_assert(!nstl::is_trivially_hashable_v<double>);
+}
+
+TEST(HashTest, ByteHashPlugsIntoHashMap) {
+    nstl::byte_hash hasher;
+    std::string symbol = "AAPL";
+    EXPECT_EQ(hasher(symbol), hasher(std::string_view("AAPL")));
+    EXPECT_EQ(hasher("AAPL"), hasher(symbol));
+    uint64_t id = 42;
+    EXPECT_EQ(hasher(id), nstl::hash_bytes(nstl::span<uint64_t, 1>(&id)));
+
+    nstl::hash_map<std::string, int, nstl::byte_hash, std::equal_to<>> prices;
+    prices["MSFT"] = 1;
+    prices["AAPL"] = 2;
+    EXPECT_EQ(prices.at(std::string_view("AAPL")), 2);
+
+    nstl::hash_map<uint64_t, int, nstl::byte_hash> by_id;
+    for (uint64_t i = 0; i < 1000; ++i) by_id.emplace(i << 20, static_cast<int>(i));
+    EXPECT_EQ(by_id.at(uint64_t{999} << 20), 999);
+}
@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <nstl/hash_map.hpp>
+
+namespace {
+
+struct string_hash {
+    using is_transparent = void;
+    size_t operator()(std::string_view s) const noexcept { return std::hash<std::string_view>{}(s); }
+};
+
+// Sends every key to the same group, so probes run across many groups.
+struct constant_hash {
+    size_t operator()(uint64_t) const noexcept { return 0; }
+};
+
+}
+
+TEST(HashMapTest, InsertFindErase) {
+    nstl::hash_map<uint64_t, int> map;
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.find(1), map.end());
+    EXPECT_EQ(map.begin(), map.end());
+    EXPECT_EQ(map.erase(1), 0u);
+
+    EXPECT_TRUE(map.try_emplace(1, 10).second);
+    EXPECT_FALSE(map.emplace(1, 99).second);
+    EXPECT_TRUE(map.insert({2, 20}).second);
+    map[3] = 30;
+    EXPECT_FALSE(map.insert_or_assign(2, 22).second);
+    EXPECT_EQ(map.size(), 3u);
+    EXPECT_EQ(map.at(1), 10);
+    EXPECT_EQ(map.at(2), 22);
+    EXPECT_THROW(map.at(4), std::out_of_range);
+    EXPECT_TRUE(map.contains(3));
+
+    auto it = map.find(3);
+    it->second += 1;
+    EXPECT_EQ(map[3], 31);
+    map.erase(it);
+    EXPECT_FALSE(map.contains(3));
+    EXPECT_EQ(map.erase(1), 1u);
+    EXPECT_EQ(map.size(), 1u);
+
+    int visited = 0;
+    for (auto [key, value] : map) {
+        EXPECT_EQ(key, 2u);
+        EXPECT_EQ(value, 22);
+        ++visited;
+    }
+    EXPECT_EQ(visited, 1);
+}
+
+TEST(HashMapTest, MatchesUnorderedMapUnderChurn) {
+    std::mt19937_64 rng(3);
+    nstl::hash_map<uint64_t, uint64_t> map;
+    std::unordered_map<uint64_t, uint64_t> expected;
+    for (int i = 0; i < 200000; ++i) {
+        uint64_t key = rng() % 5000;
+        switch (rng() % 3) {
+        case 0:
+            map.insert_or_assign(key, i);
+            expected[key] = i;
+            break;
+        case 1:
+            ASSERT_EQ(map.erase(key), expected.erase(key));
+            break;
+        default:
+            ASSERT_EQ(map.contains(key), expected.count(key) == 1);
+        }
+    }
+    ASSERT_EQ(map.size(), expected.size());
+    for (auto& [key, value] : expected) ASSERT_EQ(map.at(key), value);
+    size_t seen = 0;
+    for (auto [key, value] : map) {
+        ASSERT_EQ(expected.at(key), value);
+        ++seen;
+    }
+    EXPECT_EQ(seen, expected.size());
+    // Churn over a bounded key set must not grow the table without bound.
+    EXPECT_LE(map.capacity(), 16384u);
+}
+
+TEST(HashMapTest, ReserveAvoidsRehash) {
+    nstl::hash_map<uint64_t, uint64_t> map(1000);
+    size_t capacity = map.capacity();
+    EXPECT_GE(capacity, 1000u);
+    for (uint64_t k = 0; k < 1000; ++k) map.emplace(k, k);
+    EXPECT_EQ(map.capacity(), capacity);
+    EXPECT_LE(map.load_factor(), 0.875f);
+
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.capacity(), capacity);
+    EXPECT_FALSE(map.contains(5));
+}
+
+TEST(HashMapTest, CollidingKeysAndTombstones) {
+    nstl::hash_map<uint64_t, uint64_t, constant_hash> map;
+    for (uint64_t k = 0; k < 100; ++k) map.emplace(k, k * 2);
+    for (uint64_t k = 0; k < 100; k += 2) EXPECT_EQ(map.erase(k), 1u);
+    for (uint64_t k = 0; k < 100; ++k) ASSERT_EQ(map.contains(k), k % 2 == 1) << k;
+    for (uint64_t k = 0; k < 100; k += 2) map.emplace(k, k);
+    EXPECT_EQ(map.size(), 100u);
+    for (uint64_t k = 0; k < 100; ++k) ASSERT_EQ(map.at(k), k % 2 == 1 ? k * 2 : k);
+}
+
+TEST(HashMapTest, OwningValuesCopyAndMove) {
+    nstl::hash_map<std::string, std::unique_ptr<int>, string_hash, std::equal_to<>> owners;
+    for (int i = 0; i < 100; ++i) owners.emplace("key" + std::to_string(i), std::make_unique<int>(i));
+    std::string_view probe = "key42";
+    EXPECT_EQ(*owners.at(probe), 42);
+    EXPECT_EQ(*owners.find(probe)->second, 42);
+    EXPECT_EQ(owners.erase(probe), 1u);
+
+    auto moved = std::move(owners);
+    EXPECT_EQ(moved.size(), 99u);
+    EXPECT_TRUE(owners.empty());
+    owners = std::move(moved);
+    EXPECT_EQ(*owners.at("key7"), 7);
+
+    nstl::hash_map<std::string, std::string> names;
+    for (int i = 0; i < 50; ++i) names["n" + std::to_string(i)] = std::string(40, static_cast<char>('a' + i % 26));
+    auto copy = names;
+    names.clear();
+    EXPECT_EQ(copy.size(), 50u);
+    EXPECT_EQ(copy.at("n27"), std::string(40, 'b'));
+    const auto& alias = copy;
+    copy = alias;
+    EXPECT_EQ(copy.size(), 50u);
+}
+
+TEST(HashMapTest, PolymorphicAllocatorsStayPut) {
+    using PmrMap = nstl::hash_map<uint64_t, std::string, std::hash<uint64_t>, std::equal_to<uint64_t>,
+                                  std::pmr::polymorphic_allocator<std::byte>>;
+    std::pmr::monotonic_buffer_resource left_arena, right_arena;
+    PmrMap left(0, {}, {}, &left_arena);
+    PmrMap right(0, {}, {}, &right_arena);
+    for (uint64_t i = 0; i < 100; ++i) left.emplace(i, "left " + std::to_string(i));
+    for (uint64_t i = 0; i < 10; ++i) right.emplace(i + 1000, "right");
+
+    // polymorphic_allocator never propagates: each map keeps its own resource.
+    right = left;
+    EXPECT_EQ(right.get_allocator().resource(), &right_arena);
+    ASSERT_EQ(right.size(), 100u);
+    EXPECT_EQ(right.at(42), "left 42");
+    EXPECT_FALSE(right.contains(1000));
+
+    // Unequal resources: the elements move one by one into right's storage.
+    right.clear();
+    right = std::move(left);
+    EXPECT_EQ(right.get_allocator().resource(), &right_arena);
+    EXPECT_EQ(right.size(), 100u);
+    EXPECT_EQ(right.at(7), "left 7");
+    EXPECT_TRUE(left.empty());
+
+    PmrMap other(0, {}, {}, &right_arena);
+    other.emplace(1, "one");
+    swap(right, other);
+    EXPECT_EQ(right.size(), 1u);
+    EXPECT_EQ(other.at(99), "left 99");
+
+    PmrMap same(0, {}, {}, &right_arena);
+    same = std::move(other); // equal resources: the block is taken over
+    EXPECT_EQ(same.size(), 100u);
+    EXPECT_EQ(other.size(), 0u);
+}
@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <nstl/incremental_vector.hpp>
+
+TEST(IncrementalVectorTest, IndexingDuringMigration) {
+    nstl::incremental_vector<int> v;
+    for (int i = 0; i < 8; ++i) v.push_back(i);
+    v.push_back(8); // grows to 16; 8 elements left behind
+
+    EXPECT_EQ(v.capacity(), 16);
+    EXPECT_EQ(v.pending(), 8 - nstl::incremental_vector<int>::migration_step);
+    for (int i = 0; i < 9; ++i) EXPECT_EQ(v[i], i);
+
+    v[0] = 100; // still in the old block
+    EXPECT_EQ(v.at(0), 100);
+}
+
+TEST(IncrementalVectorTest, MigrationFinishesBeforeNextGrowth) {
+    nstl::incremental_vector<int> v;
+    for (int i = 0; i < 1000; ++i) {
+        v.push_back(i);
+        if (v.size() == v.capacity()) {
+            EXPECT_EQ(v.pending(), 0) << "at size " << v.size();
+        }
+    }
+    for (int i = 0; i < 1000; ++i) ASSERT_EQ(v[i], i);
+}
+
+TEST(IncrementalVectorTest, NonTrivialElements) {
+    nstl::incremental_vector<std::string> v;
+    for (int i = 0; i < 100; ++i) {
+        v.emplace_back("Long string to defeat Small String Optimization " + std::to_string(i));
+    }
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_EQ(v[i], "Long string to defeat Small String Optimization " + std::to_string(i));
+    }
+}
+
+TEST(IncrementalVectorTest, EmplaceFromPendingElement) {
+    nstl::incremental_vector<std::string> v;
+    for (int i = 0; i < 8; ++i) v.push_back("Long string to defeat Small String Optimization");
+    v.emplace_back(v[0]);
+    for (const auto& s : v) EXPECT_EQ(s, "Long string to defeat Small String Optimization");
+}
+
+TEST(IncrementalVectorTest, PopBackIntoOldBlock) {
+    nstl::incremental_vector<int> v;
+    for (int i = 0; i < 9; ++i) v.push_back(i);
+    while (v.size() > 3) v.pop_back();
+
+    EXPECT_LE(v.pending(), 3);
+    EXPECT_EQ(v[2], 2);
+    v.push_back(42);
+    EXPECT_EQ(v[3], 42);
+}
+
+TEST(IncrementalVectorTest, DataFinishesMigration) {
+    nstl::incremental_vector<int> v;
+    for (int i = 0; i < 9; ++i) v.push_back(i);
+    ASSERT_GT(v.pending(), 0);
+
+    int* p = v.data();
+    EXPECT_EQ(v.pending(), 0);
+    EXPECT_EQ(std::accumulate(p, p + v.size(), 0), 36);
+}
+
+TEST(IncrementalVectorTest, IteratorsAndCopy) {
+    nstl::incremental_vector<int> v;
+    for (int i = 0; i < 20; ++i) v.push_back(20 - i);
+
+    nstl::incremental_vector<int> copy = v;
+    EXPECT_EQ(copy.pending(), 0);
+    EXPECT_TRUE(std::equal(v.begin(), v.end(), copy.begin(), copy.end()));
+    EXPECT_EQ(*std::max_element(v.begin(), v.end()), 20);
+
+    nstl::incremental_vector<int> moved = std::move(v);
+    EXPECT_TRUE(v.empty());
+    EXPECT_EQ(moved[19], 1);
+}
@@ -0,0 +1,219 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <stdexcept>
+#include <thread>
+#include <nstl/memory_resource.hpp>
+#include <nstl/vector.hpp>
+
+namespace {
+
+// Upstream that counts what passes through it.
+struct counting_resource : std::pmr::memory_resource {
+    size_t allocations = 0;
+    size_t deallocations = 0;
+    size_t outstanding = 0;
+
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        ++allocations;
+        outstanding += bytes;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+        ++deallocations;
+        outstanding -= bytes;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+struct Order {
+    uint64_t id;
+    int quantity;
+    static inline int live = 0;
+    Order(uint64_t i, int q) : id(i), quantity(q) { ++live; }
+    ~Order() { --live; }
+};
+
+struct Throws {
+    explicit Throws(int) { throw std::runtime_error("boom"); }
+};
+
+}
+
+TEST(MemoryResourceTest, ArenaRewindReusesMemory) {
+    counting_resource upstream;
+    {
+        nstl::monotonic_arena arena(4096, &upstream);
+        void* first = arena.allocate(64, 8);
+        auto start = arena.mark();
+        for (int event = 0; event < 100; ++event) {
+            nstl::arena_scope scope(arena);
+            // Enough per event to spill into further chunks.
+            for (int i = 0; i < 200; ++i) {
+                void* p = arena.allocate(100, 16);
+                ASSERT_EQ(reinterpret_cast<uintptr_t>(p) % 16, 0u);
+            }
+            auto* wide = arena.allocate(32, 64);
+            ASSERT_EQ(reinterpret_cast<uintptr_t>(wide) % 64, 0u);
+        }
+        // Chunks from the first event were reused by every later one.
+        size_t chunks = upstream.allocations;
+        EXPECT_LE(chunks, 4u);
+        arena.rewind(start);
+        EXPECT_NE(arena.allocate(8, 8), first);
+
+        arena.release();
+        EXPECT_EQ(arena.allocate(64, 8), first);
+        EXPECT_EQ(upstream.allocations, chunks);
+
+        arena.release();
+        arena.shrink_to_fit();
+        EXPECT_EQ(upstream.outstanding, 0u);
+        EXPECT_EQ(arena.capacity(), 0u);
+        EXPECT_NE(arena.allocate(1 << 20, 8), nullptr); // bigger than any chunk so far
+        EXPECT_GE(arena.capacity(), size_t(1) << 20);
+    }
+    EXPECT_EQ(upstream.outstanding, 0u);
+
+    // An external buffer is used first and never handed to upstream.
+    alignas(16) std::byte buffer[1024];
+    {
+        size_t before = upstream.allocations;
+        nstl::monotonic_arena arena(buffer, sizeof(buffer), &upstream);
+        auto* p = static_cast<std::byte*>(arena.allocate(256, 8));
+        EXPECT_GE(p, buffer);
+        EXPECT_LT(p, buffer + sizeof(buffer));
+        EXPECT_EQ(upstream.allocations, before);
+        EXPECT_NE(arena.allocate(4096, 8), nullptr);
+        EXPECT_EQ(upstream.allocations, before + 1);
+        arena.release();
+        EXPECT_EQ(arena.allocate(256, 8), p);
+    }
+    EXPECT_EQ(upstream.outstanding, 0u);
+}
+
+TEST(MemoryResourceTest, PoolRecyclesBlocksBySizeClass) {
+    counting_resource upstream;
+    {
+        nstl::pool_resource pool(256, &upstream);
+        EXPECT_EQ(pool.max_block(), 256u);
+        void* a = pool.allocate(24, 8);
+        void* b = pool.allocate(32, 8); // same 32-byte class
+        pool.deallocate(a, 24, 8);
+        EXPECT_EQ(pool.allocate(30, 8), a);
+        pool.deallocate(b, 32, 8);
+
+        for (size_t size : {1u, 8u, 9u, 64u, 100u, 256u}) {
+            void* p = pool.allocate(size, 8);
+            EXPECT_EQ(reinterpret_cast<uintptr_t>(p) % std::min<size_t>(std::bit_ceil(std::max<size_t>(size, 8)), 64), 0u);
+            pool.deallocate(p, size, 8);
+        }
+        size_t chunks = upstream.allocations;
+        for (int round = 0; round < 1000; ++round) {
+            void* p = pool.allocate(48, 16);
+            pool.deallocate(p, 48, 16);
+        }
+        EXPECT_EQ(upstream.allocations, chunks);
+
+        // Past max_block goes straight to upstream and comes straight back.
+        void* big = pool.allocate(4096, 8);
+        EXPECT_EQ(upstream.allocations, chunks + 1);
+        pool.deallocate(big, 4096, 8);
+        EXPECT_EQ(upstream.deallocations, 1u);
+    }
+    EXPECT_EQ(upstream.outstanding, 0u);
+}
+
+TEST(MemoryResourceTest, ThreadCacheAcrossThreads) {
+    counting_resource upstream;
+    {
+        nstl::thread_cache_resource cache(1024, 32, &upstream);
+        constexpr int per_thread = 20000;
+        // Producers allocate, the consumer frees: blocks cross threads.
+        nstl::vector<void*> handoff[2];
+        std::thread producers[2];
+        for (int t = 0; t < 2; ++t) {
+            producers[t] = std::thread([&, t] {
+                for (int i = 0; i < per_thread; ++i) {
+                    size_t size = 8u << (i % 6);
+                    void* p = cache.allocate(size, 8);
+                    static_cast<std::byte*>(p)[size - 1] = std::byte{1};
+                    if (i % 4 == 0) handoff[t].push_back(p);
+                    else cache.deallocate(p, size, 8);
+                }
+            });
+        }
+        for (auto& t : producers) t.join();
+        std::thread consumer([&] {
+            for (int t = 0; t < 2; ++t) {
+                for (size_t i = 0; i < handoff[t].size(); ++i) {
+                    cache.deallocate(handoff[t][i], 8u << ((i * 4) % 6), 8);
+                }
+            }
+        });
+        consumer.join();
+
+        // The exited threads gave their blocks back, so this thread reuses them.
+        size_t chunks = upstream.allocations;
+        nstl::vector<void*> again;
+        for (int i = 0; i < 1000; ++i) again.push_back(cache.allocate(64, 8));
+        for (void* p : again) cache.deallocate(p, 64, 8);
+        EXPECT_EQ(upstream.allocations, chunks);
+    }
+    EXPECT_EQ(upstream.outstanding, 0u);
+
+    // A thread that outlives the resource does not touch it on exit.
+    std::atomic<bool> used{false}, done{false};
+    std::thread late;
+    {
+        nstl::thread_cache_resource cache;
+        late = std::thread([&] {
+            cache.deallocate(cache.allocate(16, 8), 16, 8);
+            used = true;
+            while (!done) std::this_thread::yield();
+        });
+        while (!used) std::this_thread::yield();
+    }
+    done = true;
+    late.join();
+}
+
+TEST(MemoryResourceTest, PlugsIntoVectorAndAllocateUnique) {
+    nstl::monotonic_arena arena;
+    nstl::pool_resource pool;
+    nstl::thread_cache_resource cache;
+    for (nstl::memory_resource* r : {static_cast<nstl::memory_resource*>(&arena), static_cast<nstl::memory_resource*>(&pool),
+                                     static_cast<nstl::memory_resource*>(&cache)}) {
+        nstl::pmr::vector<int> v{std::pmr::polymorphic_allocator<int>(r)};
+        for (int i = 0; i < 1000; ++i) v.push_back(i);
+        EXPECT_EQ(v[999], 999);
+
+        {
+            auto order = nstl::allocate_unique<Order>(r, 7u, 100);
+            static_assert(sizeof(order) == 2 * sizeof(void*));
+            EXPECT_EQ(order->quantity, 100);
+            EXPECT_EQ(Order::live, 1);
+            EXPECT_EQ(order.get_deleter().resource, r);
+            // Moving carries the deleter, so the right resource frees the order.
+            auto moved = std::move(order);
+            EXPECT_EQ(moved.get_deleter().resource, r);
+            nstl::unique_ptr<Order, nstl::resource_deleter<Order>> assigned;
+            assigned = std::move(moved);
+            EXPECT_EQ(assigned->id, 7u);
+        }
+        EXPECT_EQ(Order::live, 0);
+        EXPECT_THROW(nstl::allocate_unique<Throws>(r, 1), std::runtime_error);
+    }
+
+    // One event's worth of objects, freed together by rewinding.
+    {
+        nstl::arena_scope event(arena);
+        nstl::pmr::vector<uint64_t> ids{std::pmr::polymorphic_allocator<uint64_t>(&arena)};
+        for (uint64_t i = 0; i < 64; ++i) ids.push_back(i);
+        EXPECT_EQ(ids[63], 63u);
+    }
+}
@@ -0,0 +1,163 @@
+#include <gtest/gtest.h>
+
+#if defined(__linux__)
+
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+#include <nstl/mmap_vector.hpp>
+
+namespace {
+
+struct Tick {
+    uint64_t time;
+    double price;
+};
+
+// Unique file under the temp directory, removed when the test ends.
+struct TempFile {
+    std::string path;
+    TempFile() {
+        auto* info = ::testing::UnitTest::GetInstance()->current_test_info();
+        path = (std::filesystem::temp_directory_path() /
+                (std::string("nstl_") + info->name() + "_" + std::to_string(::getpid()) + ".bin")).string();
+        std::filesystem::remove(path);
+    }
+    ~TempFile() { std::filesystem::remove(path); }
+};
+
+}
+
+TEST(MmapVectorTest, PushBackGrowsAndReads) {
+    TempFile file;
+    nstl::mmap_vector<int> v(file.path);
+    EXPECT_TRUE(v.empty());
+
+    for (int i = 0; i < 10000; ++i) v.push_back(i);
+    EXPECT_EQ(v.size(), 10000);
+    EXPECT_GE(v.capacity(), 10000);
+    EXPECT_EQ(v[1234], 1234);
+    EXPECT_EQ(v.at(9999), 9999);
+    EXPECT_THROW(v.at(10000), std::out_of_range);
+    EXPECT_EQ(std::accumulate(v.begin(), v.end(), 0LL), 9999LL * 10000 / 2);
+
+    v.pop_back();
+    EXPECT_EQ(v.view().size(), 9999);
+    EXPECT_EQ(v.view().back(), 9998);
+
+    v.resize(10005);
+    EXPECT_EQ(v[10004], 0);
+    v.clear();
+    EXPECT_TRUE(v.empty());
+    EXPECT_THROW(v.pop_back(), std::out_of_range);
+}
+
+TEST(MmapVectorTest, ReopenSeesContentsWithoutCopying) {
+    TempFile file;
+    std::vector<Tick> ticks;
+    for (uint64_t i = 0; i < 5000; ++i) ticks.push_back({i, 100.0 + static_cast<double>(i) / 4});
+    {
+        nstl::mmap_vector<Tick> v(file.path);
+        v.append(nstl::span<const Tick>(ticks.data(), ticks.size()));
+        v.push_back({9999, 1.5});
+        v.flush();
+    }
+    // Spare capacity is trimmed on close.
+    EXPECT_EQ(std::filesystem::file_size(file.path), 64 + 5001 * sizeof(Tick));
+
+    nstl::mmap_vector<Tick> reopened(file.path, nstl::open_mode::read_only);
+    nstl::span<const Tick> view = reopened.view();
+    ASSERT_EQ(view.size(), 5001);
+    EXPECT_EQ(view[4000].time, 4000u);
+    EXPECT_EQ(view[4000].price, 1100.0);
+    EXPECT_EQ(view.back().time, 9999u);
+    EXPECT_THROW(reopened.push_back({0, 0}), std::logic_error);
+    EXPECT_THROW(reopened.pop_back(), std::logic_error);
+    EXPECT_THROW(reopened.resize(10), std::logic_error);
+    EXPECT_THROW(reopened.resize(6000), std::logic_error);
+    EXPECT_EQ(reopened.size(), 5001);
+}
+
+TEST(MmapVectorTest, ReadOnlyRejectsWritesIntoSpareCapacity) {
+    TempFile file;
+    // While the writer is open the file keeps its spare capacity, so a reader maps
+    // room past size() that it must still not write to.
+    nstl::mmap_vector<int> writer(file.path);
+    for (int i = 0; i < 10; ++i) writer.push_back(i);
+    writer.flush();
+
+    nstl::mmap_vector<int> reader(file.path, nstl::open_mode::read_only);
+    ASSERT_EQ(reader.size(), 10);
+    ASSERT_GT(reader.capacity(), reader.size());
+    EXPECT_THROW(reader.push_back(10), std::logic_error);
+    int more[] = {10, 11};
+    EXPECT_THROW(reader.append(nstl::span<const int>(more, 2)), std::logic_error);
+    EXPECT_EQ(reader.size(), 10);
+    EXPECT_EQ(writer.size(), 10);
+}
+
+TEST(MmapVectorTest, GrowsFromItsOwnElements) {
+    TempFile file;
+    nstl::mmap_vector<uint64_t> v(file.path);
+    v.push_back(7);
+    // Each push_back at full capacity remaps with the argument inside the mapping.
+    while (v.size() < 5000) v.push_back(v[v.size() / 2]);
+    for (size_t i = 0; i < v.size(); ++i) ASSERT_EQ(v[i], 7u);
+
+    // append() of the whole view doubles the size, so it always remaps.
+    nstl::mmap_vector<uint64_t> w(file.path + ".2");
+    for (uint64_t i = 0; i < 64; ++i) w.push_back(i);
+    for (int round = 0; round < 6; ++round) {
+        ASSERT_EQ(w.size(), w.capacity());
+        w.append(w.view());
+    }
+    ASSERT_EQ(w.size(), 64u << 6);
+    for (size_t i = 0; i < w.size(); ++i) ASSERT_EQ(w[i], i % 64);
+    std::filesystem::remove(file.path + ".2");
+}
+
+TEST(MmapVectorTest, ReopenForAppend) {
+    TempFile file;
+    {
+        nstl::mmap_vector<int> v(file.path);
+        for (int i = 0; i < 100; ++i) v.push_back(i);
+    }
+    {
+        nstl::mmap_vector<int> v(file.path);
+        EXPECT_EQ(v.size(), 100);
+        for (int i = 100; i < 300; ++i) v.push_back(i);
+    }
+    nstl::mmap_vector<int> v(file.path, nstl::open_mode::read_only);
+    ASSERT_EQ(v.size(), 300);
+    for (int i = 0; i < 300; ++i) ASSERT_EQ(v[i], i);
+
+    nstl::mmap_vector<int> moved(std::move(v));
+    EXPECT_EQ(moved.size(), 300);
+}
+
+TEST(MmapVectorTest, RejectsForeignFiles) {
+    TempFile file;
+    EXPECT_THROW(nstl::mmap_vector<int>(file.path, nstl::open_mode::read_only), std::system_error);
+    {
+        std::ofstream out(file.path, std::ios::binary);
+        out << std::string(128, 'x');
+    }
+    EXPECT_THROW(nstl::mmap_vector<int>(file.path), std::runtime_error);
+
+    std::filesystem::remove(file.path);
+    {
+        nstl::mmap_vector<int> v(file.path);
+        v.push_back(1);
+    }
+    // Same file, different element size.
+    EXPECT_THROW(nstl::mmap_vector<Tick>(file.path), std::runtime_error);
+    EXPECT_EQ(nstl::mmap_vector<int>(file.path, nstl::open_mode::read_only)[0], 1);
+}
+
+#endif
@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <nstl/mpmc_queue.hpp>
+
+TEST(MpmcQueueTest, TryPushTryPop) {
+    nstl::mpmc_queue<int, 4> q;
+    EXPECT_TRUE(q.empty());
+    for (int i = 0; i < 4; ++i) EXPECT_TRUE(q.try_push(i));
+    EXPECT_FALSE(q.try_push(4));
+    EXPECT_EQ(q.size_approx(), 4);
+
+    int out;
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(q.try_pop(out));
+        EXPECT_EQ(out, i);
+    }
+    EXPECT_FALSE(q.try_pop(out));
+
+    for (int round = 0; round < 10; ++round) {
+        EXPECT_TRUE(q.try_emplace(round));
+        ASSERT_TRUE(q.try_pop(out));
+        EXPECT_EQ(out, round);
+    }
+}
+
+TEST(MpmcQueueTest, NonTrivialElementsAreDestroyed) {
+    auto q = std::make_unique<nstl::mpmc_queue<std::string, 8>>();
+    for (int i = 0; i < 5; ++i) q->push("Long string to defeat Small String Optimization " + std::to_string(i));
+    std::string out;
+    q->pop(out);
+    EXPECT_EQ(out, "Long string to defeat Small String Optimization 0");
+    // The remaining four are destroyed with the queue.
+}
+
+TEST(MpmcQueueTest, ProducersAndConsumersExchangeEverything) {
+    constexpr int producers = 4;
+    constexpr int consumers = 3;
+    constexpr int per_producer = 25000;
+    nstl::mpmc_queue<int, 64> q;
+
+    std::atomic<long long> sum{0};
+    std::atomic<int> received{0};
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&q, p] {
+            for (int i = 0; i < per_producer; ++i) q.push(p * per_producer + i);
+        });
+    }
+    for (int c = 0; c < consumers; ++c) {
+        threads.emplace_back([&] {
+            int value;
+            while (received.fetch_add(1) < producers * per_producer) {
+                q.pop(value);
+                sum += value;
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    long long n = producers * per_producer;
+    EXPECT_EQ(sum.load(), n * (n - 1) / 2);
+    EXPECT_TRUE(q.empty());
+}
+
+TEST(MpmcQueueTest, BlockedPopWakesOnPush) {
+    nstl::mpmc_queue<int, 2> q;
+    std::thread consumer([&] {
+        int value;
+        for (int i = 0; i < 100; ++i) {
+            q.pop(value);
+            EXPECT_EQ(value, i);
+        }
+    });
+    for (int i = 0; i < 100; ++i) {
+        q.push(i);
+        if (i % 10 == 0) std::this_thread::sleep_for(std::chrono::milliseconds(1)); // let the consumer park
+    }
+    consumer.join();
+}
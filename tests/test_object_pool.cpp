@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <unordered_set>
+#include <nstl/object_pool.hpp>
+#include <nstl/vector.hpp>
+
+namespace {
+
+struct Order {
+    uint64_t id;
+    uint64_t price;
+    uint32_t quantity;
+    static inline std::atomic<int> live{0};
+    Order(uint64_t i, uint64_t p, uint32_t q) : id(i), price(p), quantity(q) { ++live; }
+    ~Order() { --live; }
+};
+
+struct alignas(64) Wide {
+    int value;
+};
+
+struct ThrowsOnZero {
+    explicit ThrowsOnZero(int v) {
+        if (v == 0) throw std::invalid_argument("zero");
+    }
+};
+
+}
+
+TEST(ObjectPoolTest, HandlesArePointerSized) {
+    static_assert(sizeof(nstl::pooled_ptr<Order>) == sizeof(Order*));
+    static_assert(sizeof(nstl::pooled_ptr<Wide>) == sizeof(Wide*));
+
+    nstl::object_pool<Order> pool;
+    {
+        auto order = pool.make_pooled(1u, 100u, 5u);
+        EXPECT_EQ(order->price, 100u);
+        EXPECT_EQ(Order::live, 1);
+        EXPECT_EQ(nstl::object_pool<Order>::owner_of(order.get()), &pool);
+        nstl::pooled_ptr<Order> moved = std::move(order);
+        EXPECT_EQ(order, nullptr);
+        EXPECT_EQ(moved->id, 1u);
+    }
+    EXPECT_EQ(Order::live, 0);
+
+    nstl::object_pool<Wide> wide;
+    for (int i = 0; i < 100; ++i) {
+        auto w = wide.make_pooled(Wide{i});
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(w.get()) % 64, 0u);
+        EXPECT_EQ(w->value, i);
+    }
+}
+
+TEST(ObjectPoolTest, ReusesSlotsWithoutNewSlabs) {
+    nstl::object_pool<Order> pool(32);
+    nstl::vector<nstl::pooled_ptr<Order>> live;
+    std::unordered_set<Order*> addresses;
+    for (uint32_t i = 0; i < 10000; ++i) {
+        live.push_back(pool.make_pooled(i, i * 2, i));
+        EXPECT_TRUE(addresses.insert(live[i].get()).second);
+    }
+    size_t slabs = pool.slab_count();
+    EXPECT_GE(slabs * nstl::object_pool<Order>::slots_per_slab, 10000u);
+    EXPECT_EQ(live[9999]->quantity, 9999u);
+
+    // Churn at a steady size recycles slots instead of adding slabs.
+    for (uint32_t round = 0; round < 50000; ++round) live[round % 10000] = pool.make_pooled(round, 0u, 0u);
+    EXPECT_EQ(pool.slab_count(), slabs);
+    live.clear();
+    EXPECT_EQ(Order::live, 0);
+}
+
+TEST(ObjectPoolTest, ConstructorThrowReturnsSlot) {
+    nstl::object_pool<ThrowsOnZero> pool(4);
+    auto kept = pool.make_pooled(1);
+    ThrowsOnZero* freed = nullptr;
+    {
+        auto tmp = pool.make_pooled(2);
+        freed = tmp.get();
+    }
+    EXPECT_THROW(pool.make_pooled(0), std::invalid_argument);
+    // The slot taken by the failed construction went back to the free list.
+    EXPECT_EQ(pool.make_pooled(3).get(), freed);
+}
+
+TEST(ObjectPoolTest, CrossThreadFree) {
+    nstl::object_pool<Order> pool(64);
+    constexpr uint32_t per_thread = 20000;
+    nstl::vector<nstl::pooled_ptr<Order>> made[2];
+    std::thread producers[2];
+    for (int t = 0; t < 2; ++t) {
+        producers[t] = std::thread([&, t] {
+            for (uint32_t i = 0; i < per_thread; ++i) made[t].push_back(pool.make_pooled(i, uint64_t(t), i));
+        });
+    }
+    for (auto& t : producers) t.join();
+    EXPECT_EQ(Order::live, static_cast<int>(2 * per_thread));
+
+    // A consumer frees everything the producers made.
+    std::thread consumer([&] {
+        for (auto& batch : made) {
+            for (size_t i = 0; i < batch.size(); ++i) ASSERT_EQ(batch[i]->quantity, i);
+            batch.clear();
+        }
+    });
+    consumer.join();
+    EXPECT_EQ(Order::live, 0);
+
+    // Those slots reached the shared list, so new objects need no new slab.
+    size_t slabs = pool.slab_count();
+    nstl::vector<nstl::pooled_ptr<Order>> again;
+    for (uint32_t i = 0; i < 2 * per_thread; ++i) again.push_back(pool.make_pooled(i, 0u, 0u));
+    EXPECT_EQ(pool.slab_count(), slabs);
+}
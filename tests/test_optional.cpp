@@ -288,3 +288,10 @@ TEST(OptionalComplex, TrackedLifetime) {
     EXPECT_GE(Tracked::ctor_count, 2);
     EXPECT_GE(Tracked::dtor_count, 2);
 }
+
+// ---- Relocation ----
+
+TEST(OptionalBasic, TriviallyRelocatableFollowsValueType) {
+    EXPECT_TRUE(nstl::is_trivially_relocatable_v<nstl::optional<int>>);
+    EXPECT_FALSE(nstl::is_trivially_relocatable_v<nstl::optional<Tracked>>);
+}
@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <nstl/parallel.hpp>
+#include <nstl/span.hpp>
+#include <nstl/vector.hpp>
+
+namespace par = nstl::parallel;
+
+namespace {
+
+nstl::vector<uint32_t> random_values(size_t n, uint32_t seed) {
+    std::mt19937 rng(seed);
+    nstl::vector<uint32_t> values;
+    for (size_t i = 0; i < n; ++i) values.push_back(rng() % 1000);
+    return values;
+}
+
+}
+
+TEST(ParallelTest, ForEachAndTransformVisitEveryElement) {
+    par::thread_pool pool(4);
+    nstl::vector<int> v;
+    for (int i = 0; i < 100000; ++i) v.push_back(i);
+
+    par::for_each(nstl::span<int>(v), [](int& x) { x *= 2; }, {.grain = 1000, .pool = &pool});
+    for (int i = 0; i < 100000; ++i) ASSERT_EQ(v[i], 2 * i);
+
+    nstl::vector<double> halves;
+    halves.resize(v.size());
+    par::transform(nstl::span<const int>(v), nstl::span<double>(halves), [](int x) { return x / 4.0; }, {.pool = &pool});
+    EXPECT_EQ(halves[99999], 99999 / 2.0);
+
+    nstl::vector<double> short_out;
+    short_out.resize(10);
+    EXPECT_THROW(par::transform(nstl::span<int>(v), nstl::span<double>(short_out), [](int x) { return x * 1.0; }),
+                 std::length_error);
+
+    // Empty input runs nothing.
+    nstl::span<int> none;
+    par::for_each(none, [](int&) { FAIL(); }, {.pool = &pool});
+}
+
+TEST(ParallelTest, ReduceMatchesSerialAndKeepsOrder) {
+    par::thread_pool pool(3);
+    nstl::vector<uint32_t> values = random_values(200001, 1);
+    uint64_t expected = std::accumulate(values.begin(), values.end(), uint64_t{0});
+    EXPECT_EQ(par::reduce(nstl::span<uint32_t>(values), uint64_t{0}, {.grain = 777, .pool = &pool}), expected);
+    EXPECT_EQ(par::reduce(nstl::span<uint32_t>(values), uint64_t{5}, {.pool = &pool}), expected + 5);
+
+    // Concatenation is associative but not commutative: chunks combine in order.
+    nstl::vector<std::string> words;
+    std::string joined;
+    for (int i = 0; i < 5000; ++i) {
+        words.push_back(std::to_string(i % 10));
+        joined += words[words.size() - 1];
+    }
+    auto concat = [](std::string a, const std::string& b) { return a + b; };
+    EXPECT_EQ(par::reduce(nstl::span<std::string>(words), std::string(), concat, {.grain = 64, .pool = &pool}), joined);
+
+    nstl::span<uint32_t> none;
+    EXPECT_EQ(par::reduce(none, uint64_t{9}, {.pool = &pool}), 9u);
+}
+
+TEST(ParallelTest, DeterministicReduceIgnoresPoolSize) {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    nstl::vector<float> values;
+    for (int i = 0; i < 300000; ++i) values.push_back(dist(rng) * 1e4f);
+
+    par::thread_pool one(1), three(3), eight(8);
+    float a = par::reduce(nstl::span<float>(values), 0.0f, {.deterministic = true, .pool = &one});
+    float b = par::reduce(nstl::span<float>(values), 0.0f, {.deterministic = true, .pool = &three});
+    float c = par::reduce(nstl::span<float>(values), 0.0f, {.deterministic = true, .pool = &eight});
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(a, c);
+}
+
+TEST(ParallelTest, InclusiveScan) {
+    par::thread_pool pool(4);
+    nstl::vector<uint32_t> values = random_values(100003, 2);
+    nstl::vector<uint64_t> expected;
+    expected.resize(values.size());
+    std::inclusive_scan(values.begin(), values.end(), expected.begin(), std::plus<>{}, uint64_t{0});
+
+    nstl::vector<uint64_t> out;
+    out.resize(values.size());
+    par::inclusive_scan(nstl::span<uint32_t>(values), nstl::span<uint64_t>(out), {.grain = 1000, .pool = &pool});
+    EXPECT_TRUE(std::equal(out.begin(), out.end(), expected.begin()));
+
+    // In place, with a grain that does not divide the size.
+    par::inclusive_scan(nstl::span<uint32_t>(values), nstl::span<uint32_t>(values), {.grain = 4096, .pool = &pool});
+    for (size_t i = 0; i < values.size(); ++i) ASSERT_EQ(values[i], static_cast<uint32_t>(expected[i]));
+}
+
+TEST(ParallelTest, SortMatchesStdSort) {
+    par::thread_pool pool(4);
+    for (size_t n : {0, 1, 5000, 100000, 123457}) {
+        nstl::vector<uint32_t> values = random_values(n, static_cast<uint32_t>(n));
+        nstl::vector<uint32_t> expected = values;
+        std::sort(expected.begin(), expected.end());
+        par::sort(nstl::span<uint32_t>(values), {.grain = 3000, .pool = &pool});
+        ASSERT_TRUE(std::equal(values.begin(), values.end(), expected.begin())) << n;
+    }
+
+    nstl::vector<uint32_t> values = random_values(50000, 3);
+    par::sort(nstl::span<uint32_t>(values), std::greater<>{}, {.grain = 2048, .pool = &pool});
+    EXPECT_TRUE(std::is_sorted(values.begin(), values.end(), std::greater<>{}));
+
+    nstl::vector<std::string> words;
+    for (int i = 0; i < 20000; ++i) words.push_back(std::to_string((i * 7919) % 20000));
+    par::sort(nstl::span<std::string>(words), {.grain = 2048, .pool = &pool});
+    EXPECT_TRUE(std::is_sorted(words.begin(), words.end()));
+}
+
+TEST(ParallelTest, ExceptionsAndNestedCalls) {
+    par::thread_pool pool(4);
+    std::atomic<int> ran{0};
+    EXPECT_THROW(pool.run(64, [&](size_t chunk) {
+        ran.fetch_add(1);
+        if (chunk == 10) throw std::runtime_error("chunk failed");
+    }), std::runtime_error);
+    EXPECT_LE(ran.load(), 64);
+
+    // Every chunk runs another parallel loop on the same pool.
+    std::atomic<uint64_t> total{0};
+    pool.run(16, [&](size_t) {
+        nstl::vector<uint32_t> values = random_values(10000, 4);
+        total.fetch_add(par::reduce(nstl::span<uint32_t>(values), uint64_t{0}, {.grain = 500, .pool = &pool}));
+    });
+    nstl::vector<uint32_t> values = random_values(10000, 4);
+    EXPECT_EQ(total.load(), 16 * std::accumulate(values.begin(), values.end(), uint64_t{0}));
+}
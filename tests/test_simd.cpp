@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <nstl/simd.hpp>
+#include <nstl/span.hpp>
+#include <nstl/vector.hpp>
+
+namespace simd = nstl::simd;
+
+namespace {
+
+constexpr simd::isa all_isas[] = {simd::isa::scalar, simd::isa::sse2, simd::isa::avx2, simd::isa::avx512};
+
+template<typename T>
+nstl::vector<T> random_values(size_t n, uint32_t seed) {
+    std::mt19937 rng(seed);
+    nstl::vector<T> values;
+    for (size_t i = 0; i < n; ++i) values.push_back(static_cast<T>(static_cast<int>(rng() % 201) - 100));
+    return values;
+}
+
+template<typename T>
+void check_against_scalar() {
+    const simd::kernel_table<T>& reference = simd::kernels<T>(simd::isa::scalar);
+    for (simd::isa level : all_isas) {
+        if (!simd::supported(level)) continue;
+        const simd::kernel_table<T>& k = simd::kernels<T>(level);
+        // Sizes around every vector width and unroll factor, plus a long one.
+        for (size_t n : {1, 3, 7, 8, 15, 16, 17, 31, 33, 63, 64, 65, 127, 200, 1000, 4099}) {
+            nstl::vector<T> a = random_values<T>(n, static_cast<uint32_t>(n));
+            nstl::vector<T> b = random_values<T>(n, static_cast<uint32_t>(n + 1));
+            SCOPED_TRACE(::testing::Message() << "isa " << static_cast<int>(level) << " n " << n);
+
+            for (T needle : {a[n - 1], a[n / 2], T(1000)}) {
+                EXPECT_EQ(k.find(a.data(), n, needle), reference.find(a.data(), n, needle));
+                EXPECT_EQ(k.count(a.data(), n, needle), reference.count(a.data(), n, needle));
+            }
+            simd::indexed<T> lo = k.min(a.data(), n), lo_ref = reference.min(a.data(), n);
+            simd::indexed<T> hi = k.max(a.data(), n), hi_ref = reference.max(a.data(), n);
+            EXPECT_EQ(lo.value, lo_ref.value);
+            EXPECT_EQ(lo.index, lo_ref.index);
+            EXPECT_EQ(hi.value, hi_ref.value);
+            EXPECT_EQ(hi.index, hi_ref.index);
+            // Small integers: every order gives the exact same float sum.
+            EXPECT_EQ(k.sum(a.data(), n), reference.sum(a.data(), n));
+            EXPECT_EQ(k.dot(a.data(), b.data(), n), reference.dot(a.data(), b.data(), n));
+
+            for (simd::cmp op : {simd::cmp::eq, simd::cmp::ne, simd::cmp::lt, simd::cmp::le, simd::cmp::gt, simd::cmp::ge}) {
+                nstl::vector<uint64_t> bits, bits_ref;
+                bits.resize((n + 63) / 64, ~uint64_t{0});
+                bits_ref.resize((n + 63) / 64);
+                size_t set = k.compare_mask(a.data(), n, op, T(7), bits.data());
+                EXPECT_EQ(set, reference.compare_mask(a.data(), n, op, T(7), bits_ref.data()));
+                for (size_t w = 0; w < bits.size(); ++w) ASSERT_EQ(bits[w], bits_ref[w]);
+            }
+        }
+    }
+}
+
+}
+
+TEST(SimdTest, DetectsAnIsa) {
+    simd::isa level = simd::active_isa();
+    EXPECT_TRUE(simd::supported(level));
+    EXPECT_TRUE(simd::supported(simd::isa::scalar));
+#if defined(__x86_64__)
+    EXPECT_GE(level, simd::isa::sse2);
+#endif
+}
+
+TEST(SimdTest, EveryIsaMatchesScalar) {
+    check_against_scalar<int32_t>();
+    check_against_scalar<int64_t>();
+    check_against_scalar<float>();
+    check_against_scalar<double>();
+}
+
+TEST(SimdTest, SpanFrontEnd) {
+    int prices[12] = {5, 3, 9, 3, 7, 9, 1, 8, 1, 6, 9, 2};
+    nstl::span<int, 12> fixed(static_cast<int*>(prices));
+    EXPECT_EQ(simd::find(fixed, 7), 4u);
+    EXPECT_EQ(simd::find(fixed, 4), 12u);
+    EXPECT_EQ(simd::count(fixed, 9), 3u);
+    // Ties resolve to the first occurrence.
+    EXPECT_EQ(simd::min(fixed).index, 6u);
+    EXPECT_EQ(simd::max(fixed).index, 2u);
+    EXPECT_EQ(simd::sum(fixed), 63);
+
+    nstl::vector<double> bids;
+    for (int i = 0; i < 100; ++i) bids.push_back(100.0 - i * 0.25);
+    nstl::span<const double> view(bids);
+    EXPECT_EQ(simd::max(view).value, 100.0);
+    EXPECT_EQ(simd::min(view).index, 99u);
+    EXPECT_EQ(simd::dot(view, view), simd::kernels<double>(simd::isa::scalar).dot(bids.data(), bids.data(), 100));
+
+    uint64_t bits[2];
+    EXPECT_EQ(simd::compare_mask(view, simd::cmp::ge, 90.0, nstl::span<uint64_t>(bits, 2)), 41u);
+    EXPECT_EQ(bits[0], (uint64_t{1} << 41) - 1);
+    EXPECT_EQ(bits[1], 0u);
+}
+
+TEST(SimdTest, IntegerSumsDoNotOverflow) {
+    nstl::vector<int32_t> big;
+    big.resize(1000, INT32_MAX);
+    EXPECT_EQ(simd::sum(nstl::span<const int32_t>(big)), int64_t{INT32_MAX} * 1000);
+    // Products are formed in 64 bits too.
+    nstl::vector<int32_t> wide;
+    wide.resize(1000, 1 << 20);
+    EXPECT_EQ(simd::dot(nstl::span<const int32_t>(wide), nstl::span<int32_t>(wide)), (int64_t{1} << 40) * 1000);
+}
+
+TEST(SimdTest, Errors) {
+    nstl::span<const float> none;
+    EXPECT_THROW(simd::min(none), std::out_of_range);
+    EXPECT_THROW(simd::max(none), std::out_of_range);
+    EXPECT_EQ(simd::sum(none), 0.0f);
+    EXPECT_EQ(simd::find(none, 1.0f), 0u);
+
+    float a[3] = {1, 2, 3};
+    float b[2] = {1, 2};
+    EXPECT_THROW(simd::dot(nstl::span<float>(a, 3), nstl::span<float>(b, 2)), std::length_error);
+    float many[65] = {};
+    uint64_t one_word[1];
+    EXPECT_THROW(simd::compare_mask(nstl::span<float>(many, 65), simd::cmp::eq, 0.0f, nstl::span<uint64_t>(one_word, 1)),
+                 std::length_error);
+}
@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <nstl/small_vector.hpp>
+#include <nstl/span.hpp>
+
+namespace {
+
+// Allocator that counts how many blocks are currently handed out.
+template <typename T>
+struct CountingAlloc {
+    using value_type = T;
+    int* live = nullptr;
+
+    CountingAlloc() = default;
+    explicit CountingAlloc(int* l) : live(l) {}
+    template <typename U>
+    CountingAlloc(const CountingAlloc<U>& o) : live(o.live) {}
+
+    T* allocate(size_t n) {
+        ++*live;
+        return std::allocator<T>{}.allocate(n);
+    }
+    void deallocate(T* p, size_t n) {
+        --*live;
+        std::allocator<T>{}.deallocate(p, n);
+    }
+    template <typename U>
+    bool operator==(const CountingAlloc<U>& o) const { return live == o.live; }
+};
+
+struct Tracked {
+    static int alive;
+    int value;
+    explicit Tracked(int v) : value(v) { ++alive; }
+    Tracked(const Tracked& o) : value(o.value) { ++alive; }
+    Tracked(Tracked&& o) noexcept : value(o.value) { ++alive; }
+    ~Tracked() { --alive; }
+};
+int Tracked::alive = 0;
+
+}
+
+TEST(SmallVectorTest, StaysInlineUpToN) {
+    int live = 0;
+    nstl::small_vector<int, 16, CountingAlloc<int>> v{CountingAlloc<int>(&live)};
+    EXPECT_EQ(v.capacity(), 16);
+    for (int i = 0; i < 16; ++i) v.push_back(i);
+
+    EXPECT_TRUE(v.is_inline());
+    EXPECT_EQ(live, 0);
+    EXPECT_EQ(v[15], 15);
+}
+
+TEST(SmallVectorTest, SpillsToHeapOnOverflow) {
+    int live = 0;
+    {
+        nstl::small_vector<int, 4, CountingAlloc<int>> v{CountingAlloc<int>(&live)};
+        for (int i = 0; i < 5; ++i) v.push_back(i);
+
+        EXPECT_FALSE(v.is_inline());
+        EXPECT_EQ(live, 1);
+        EXPECT_EQ(v.capacity(), 8);
+        for (int i = 0; i < 5; ++i) EXPECT_EQ(v[i], i);
+    }
+    EXPECT_EQ(live, 0);
+}
+
+TEST(SmallVectorTest, ShrinkToFitReturnsInline) {
+    nstl::small_vector<std::string, 4> v;
+    for (int i = 0; i < 10; ++i) v.emplace_back(std::to_string(i));
+    while (v.size() > 3) v.pop_back();
+
+    v.shrink_to_fit();
+    EXPECT_TRUE(v.is_inline());
+    EXPECT_EQ(v.capacity(), 4);
+    EXPECT_EQ(v[2], "2");
+}
+
+TEST(SmallVectorTest, CopyAndMoveInline) {
+    Tracked::alive = 0;
+    {
+        nstl::small_vector<Tracked, 8> a;
+        a.emplace_back(1);
+        a.emplace_back(2);
+
+        nstl::small_vector<Tracked, 8> b = a;
+        EXPECT_TRUE(b.is_inline());
+        EXPECT_EQ(b[1].value, 2);
+
+        nstl::small_vector<Tracked, 8> c = std::move(a);
+        EXPECT_TRUE(c.is_inline());
+        EXPECT_TRUE(a.empty());
+        EXPECT_EQ(c[0].value, 1);
+        EXPECT_EQ(Tracked::alive, 4);
+    }
+    EXPECT_EQ(Tracked::alive, 0);
+}
+
+TEST(SmallVectorTest, MoveStealsHeapBlock) {
+    nstl::small_vector<int, 2> a;
+    for (int i = 0; i < 10; ++i) a.push_back(i);
+    const int* block = a.data();
+
+    nstl::small_vector<int, 2> b = std::move(a);
+    EXPECT_EQ(b.data(), block);
+    EXPECT_TRUE(a.is_inline());
+    EXPECT_EQ(a.capacity(), 2);
+    EXPECT_TRUE(a.empty());
+}
+
+TEST(SmallVectorTest, SwapMixedStorage) {
+    nstl::small_vector<std::string, 2> a;
+    a.push_back("inline");
+    nstl::small_vector<std::string, 2> b;
+    for (int i = 0; i < 5; ++i) b.push_back("heap " + std::to_string(i));
+
+    swap(a, b);
+    ASSERT_EQ(a.size(), 5);
+    ASSERT_EQ(b.size(), 1);
+    EXPECT_EQ(a[4], "heap 4");
+    EXPECT_EQ(b[0], "inline");
+    EXPECT_TRUE(b.is_inline());
+}
+
+TEST(SmallVectorTest, ConvertsToSpan) {
+    nstl::small_vector<int, 4> v;
+    v.push_back(3);
+    v.push_back(4);
+    nstl::span<int> s(v);
+    EXPECT_EQ(s.size(), 2);
+    EXPECT_EQ(s.data(), v.data());
+}
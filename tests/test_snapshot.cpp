@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+
+#if defined(__linux__)
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <nstl/snapshot.hpp>
+#include <nstl/vector.hpp>
+
+namespace {
+
+struct Order {
+    uint64_t id;
+    double price;
+    int32_t quantity;
+};
+
+struct TempFile {
+    std::string path;
+    TempFile() {
+        auto* info = ::testing::UnitTest::GetInstance()->current_test_info();
+        path = (std::filesystem::temp_directory_path() /
+                (std::string("nstl_") + info->name() + "_" + std::to_string(::getpid()) + ".snap")).string();
+    }
+    ~TempFile() { std::filesystem::remove(path); }
+};
+
+nstl::vector<Order> make_orders(size_t n) {
+    nstl::vector<Order> orders;
+    for (size_t i = 0; i < n; ++i) {
+        orders.push_back({i, 10.0 + static_cast<double>(i) / 16, static_cast<int32_t>(i % 7) - 3});
+    }
+    return orders;
+}
+
+}
+
+TEST(SnapshotTest, RoundTripMappedAndRead) {
+    TempFile file;
+    nstl::vector<Order> orders = make_orders(10000);
+    nstl::save_snapshot<Order>(file.path, orders);
+    EXPECT_FALSE(std::filesystem::exists(file.path + ".tmp"));
+    EXPECT_EQ(std::filesystem::file_size(file.path), sizeof(nstl::snapshot_header) + 10000 * sizeof(Order));
+
+    for (auto mode : {nstl::snapshot_load::map, nstl::snapshot_load::read}) {
+        nstl::snapshot<Order> loaded = nstl::load_snapshot<Order>(file.path, mode);
+        ASSERT_EQ(loaded.size(), 10000);
+        EXPECT_EQ(loaded.header().element_size, sizeof(Order));
+        EXPECT_EQ(reinterpret_cast<uintptr_t>(loaded.data()) % 64, 0u);
+        nstl::span<const Order> view = loaded.view();
+        for (size_t i = 0; i < orders.size(); ++i) {
+            ASSERT_EQ(view[i].id, orders[i].id);
+            ASSERT_EQ(view[i].price, orders[i].price);
+            ASSERT_EQ(view[i].quantity, orders[i].quantity);
+        }
+    }
+}
+
+TEST(SnapshotTest, EmptyAndOverwrite) {
+    TempFile file;
+    nstl::vector<int> none;
+    nstl::save_snapshot<int>(file.path, none);
+    EXPECT_TRUE(nstl::load_snapshot<int>(file.path).empty());
+
+    nstl::vector<int> some;
+    for (int i = 0; i < 5; ++i) some.push_back(i * i);
+    nstl::save_snapshot<int>(file.path, some, true);
+    nstl::snapshot<int> loaded = nstl::load_snapshot<int>(file.path, nstl::snapshot_load::read);
+    nstl::snapshot<int> moved = std::move(loaded);
+    ASSERT_EQ(moved.size(), 5);
+    EXPECT_EQ(moved[4], 16);
+}
+
+TEST(SnapshotTest, RejectsMismatchedTypes) {
+    TempFile file;
+    nstl::vector<Order> orders = make_orders(8);
+    nstl::save_snapshot<Order>(file.path, orders);
+
+    EXPECT_THROW(nstl::load_snapshot<int>(file.path), std::runtime_error);
+    struct SameSize {
+        char bytes[sizeof(Order)];
+    };
+    // Same size, weaker alignment.
+    EXPECT_THROW(nstl::load_snapshot<SameSize>(file.path), std::runtime_error);
+    EXPECT_THROW(nstl::load_snapshot<Order>(file.path + ".missing"), std::system_error);
+}
+
+TEST(SnapshotTest, ReportsForeignByteOrder) {
+    TempFile file;
+    nstl::vector<Order> orders = make_orders(4);
+    nstl::save_snapshot<Order>(file.path, orders);
+
+    // Rewrite the header as a machine of the other endianness would have: every
+    // integer field byte-reversed.
+    nstl::snapshot_header h;
+    {
+        std::ifstream in(file.path, std::ios::binary);
+        in.read(reinterpret_cast<char*>(&h), sizeof(h));
+    }
+    auto reverse = [](auto& field) {
+        auto* bytes = reinterpret_cast<unsigned char*>(&field);
+        std::reverse(bytes, bytes + sizeof(field));
+    };
+    reverse(h.magic);
+    reverse(h.version);
+    reverse(h.byte_order);
+    reverse(h.element_size);
+    reverse(h.element_alignment);
+    reverse(h.count);
+    reverse(h.checksum);
+    {
+        std::fstream f(file.path, std::ios::in | std::ios::out | std::ios::binary);
+        f.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    }
+    try {
+        nstl::load_snapshot<Order>(file.path);
+        FAIL() << "a byte-swapped header was accepted";
+    } catch (const std::runtime_error& e) {
+        EXPECT_NE(std::string(e.what()).find("different byte order"), std::string::npos) << e.what();
+    }
+}
+
+TEST(SnapshotTest, DetectsCorruptionAndTruncation) {
+    TempFile file;
+    nstl::vector<Order> orders = make_orders(100);
+    nstl::save_snapshot<Order>(file.path, orders);
+    {
+        std::fstream f(file.path, std::ios::in | std::ios::out | std::ios::binary);
+        f.seekp(sizeof(nstl::snapshot_header) + 50 * sizeof(Order));
+        f.put('\x7f');
+    }
+    EXPECT_THROW(nstl::load_snapshot<Order>(file.path), std::runtime_error);
+    EXPECT_NO_THROW(nstl::load_snapshot<Order>(file.path, nstl::snapshot_load::map, false));
+
+    std::filesystem::resize_file(file.path, sizeof(nstl::snapshot_header) + 99 * sizeof(Order));
+    EXPECT_THROW(nstl::load_snapshot<Order>(file.path, nstl::snapshot_load::read, false), std::runtime_error);
+    std::filesystem::resize_file(file.path, 10);
+    EXPECT_THROW(nstl::load_snapshot<Order>(file.path), std::runtime_error);
+}
+
+#endif
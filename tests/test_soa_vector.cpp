@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <numeric>
+#include <string>
+#include <nstl/soa_vector.hpp>
+
+namespace {
+
+struct ThrowOnCopy {
+    static int copies_left;
+    int value;
+
+    ThrowOnCopy(int v) : value(v) {}
+    ThrowOnCopy(const ThrowOnCopy& other) : value(other.value) {
+        if (copies_left-- == 0) throw std::runtime_error("copy");
+    }
+};
+int ThrowOnCopy::copies_left = 0;
+
+}
+
+TEST(SoaVectorTest, PushBackAndIndex) {
+    nstl::soa_vector<int, double, std::string> v;
+    for (int i = 0; i < 100; ++i) {
+        v.emplace_back(i, i * 0.5, "Long string to defeat Small String Optimization " + std::to_string(i));
+    }
+    v.push_back({100, 50.0, "last"});
+
+    ASSERT_EQ(v.size(), 101);
+    EXPECT_GE(v.capacity(), 101);
+    auto [id, price, tag] = v[42];
+    EXPECT_EQ(id, 42);
+    EXPECT_EQ(price, 21.0);
+    EXPECT_EQ(tag, "Long string to defeat Small String Optimization 42");
+    EXPECT_EQ(std::get<2>(v.at(100)), "last");
+    EXPECT_THROW(v.at(101), std::out_of_range);
+
+    // Rows are proxies: writing through one updates the columns.
+    std::get<0>(v[0]) = -1;
+    EXPECT_EQ(v.column<0>()[0], -1);
+
+    v.pop_back();
+    EXPECT_EQ(v.size(), 100);
+}
+
+TEST(SoaVectorTest, ColumnsAreAlignedSpans) {
+    nstl::soa_vector<char, double, int64_t> v;
+    for (int i = 0; i < 37; ++i) v.emplace_back(char('a' + i % 26), i * 2.0, i);
+
+    auto prices = v.column<1>();
+    static_assert(std::is_same_v<decltype(prices), nstl::aligned_span<double, 64>>);
+    EXPECT_EQ(prices.size(), 37);
+    EXPECT_EQ(std::accumulate(prices.begin(), prices.end(), 0.0), 2.0 * 36 * 37 / 2);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(v.column<0>().data()) % 64, 0u);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(v.column<1>().data()) % 64, 0u);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(v.column<2>().data()) % 64, 0u);
+
+    const auto& cv = v;
+    nstl::span<const int64_t> ids = cv.column<2>();
+    EXPECT_EQ(ids[36], 36);
+}
+
+TEST(SoaVectorTest, IteratorsAndStructuredBindings) {
+    nstl::soa_vector<int, int> v;
+    for (int i = 0; i < 10; ++i) v.emplace_back(i, 10 * i);
+
+    int sum = 0;
+    for (auto [a, b] : v) {
+        sum += b - a;
+        b = 0;
+    }
+    EXPECT_EQ(sum, 9 * 45);
+    EXPECT_EQ(std::get<1>(v[9]), 0);
+    EXPECT_EQ(v.end() - v.begin(), 10);
+    EXPECT_EQ(std::get<0>(*(v.cbegin() + 3)), 3);
+    EXPECT_EQ(std::get<0>(v.begin()[7]), 7);
+}
+
+TEST(SoaVectorTest, EmplaceFromOwnRowWhileGrowing) {
+    nstl::soa_vector<std::string, int> v;
+    for (int i = 0; i < 8; ++i) v.emplace_back("Long string to defeat Small String Optimization", i);
+    ASSERT_EQ(v.size(), v.capacity());
+
+    v.emplace_back(std::get<0>(v[0]), std::get<1>(v[7]));
+    EXPECT_EQ(std::get<0>(v[8]), "Long string to defeat Small String Optimization");
+    EXPECT_EQ(std::get<1>(v[8]), 7);
+    EXPECT_EQ(std::get<0>(v[0]), "Long string to defeat Small String Optimization");
+}
+
+TEST(SoaVectorTest, CopyMoveAndReserve) {
+    nstl::soa_vector<int, std::string> v;
+    v.reserve(50);
+    EXPECT_EQ(v.capacity(), 50);
+    for (int i = 0; i < 20; ++i) v.emplace_back(i, std::to_string(i));
+
+    nstl::soa_vector<int, std::string> copy = v;
+    EXPECT_EQ(copy.size(), 20);
+    EXPECT_EQ(std::get<1>(copy[19]), "19");
+
+    nstl::soa_vector<int, std::string> moved = std::move(v);
+    EXPECT_TRUE(v.empty());
+    EXPECT_EQ(std::get<0>(moved[5]), 5);
+
+    moved.shrink_to_fit();
+    EXPECT_EQ(moved.capacity(), 20);
+    copy = moved;
+    moved.clear();
+    EXPECT_TRUE(moved.empty());
+    EXPECT_EQ(std::get<1>(copy[0]), "0");
+}
+
+TEST(SoaVectorTest, ThrowingCopyDuringGrowthLeavesVectorIntact) {
+    nstl::soa_vector<std::string, ThrowOnCopy> v;
+    ThrowOnCopy::copies_left = 100;
+    for (int i = 0; i < 8; ++i) v.emplace_back(std::to_string(i), i);
+
+    ThrowOnCopy::copies_left = 3; // fails part-way through moving the old rows
+    EXPECT_THROW(v.emplace_back("x", 8), std::runtime_error);
+    ASSERT_EQ(v.size(), 8);
+    EXPECT_EQ(v.capacity(), 8);
+    for (int i = 0; i < 8; ++i) {
+        EXPECT_EQ(std::get<0>(v[i]), std::to_string(i));
+        EXPECT_EQ(std::get<1>(v[i]).value, i);
+    }
+}
@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <nstl/spsc_ring.hpp>
+#include <nstl/vector.hpp>
+
+TEST(SpscRingTest, PushPopUntilFullAndEmpty) {
+    nstl::spsc_ring<int, 4> ring;
+    EXPECT_TRUE(ring.empty());
+    for (int i = 0; i < 4; ++i) EXPECT_TRUE(ring.try_push(i));
+    EXPECT_FALSE(ring.try_push(4));
+    EXPECT_EQ(ring.size_approx(), 4);
+
+    int out = -1;
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(ring.try_pop(out));
+        EXPECT_EQ(out, i);
+    }
+    EXPECT_FALSE(ring.try_pop(out));
+
+    // Indices keep growing past Capacity; slots wrap.
+    for (int round = 0; round < 10; ++round) {
+        EXPECT_TRUE(ring.try_emplace(round));
+        ASSERT_TRUE(ring.try_pop(out));
+        EXPECT_EQ(out, round);
+    }
+}
+
+TEST(SpscRingTest, BatchesWrapAroundTheEnd) {
+    nstl::spsc_ring<int, 8> ring;
+    int scratch[8];
+    int in[6] = {0, 1, 2, 3, 4, 5};
+
+    EXPECT_EQ(ring.try_push(nstl::span<const int>(in, 6)), 6);
+    EXPECT_EQ(ring.try_pop(nstl::span<int>(scratch, 5)), 5);
+    // tail is at 6, so this batch splits 2 + 4 around the end of the buffer.
+    EXPECT_EQ(ring.try_push(nstl::span<const int>(in, 6)), 6);
+    EXPECT_EQ(ring.try_push(nstl::span<const int>(in, 6)), 1); // only one slot left
+
+    EXPECT_EQ(ring.try_pop(nstl::span<int>(scratch, 8)), 8);
+    int expected[8] = {5, 0, 1, 2, 3, 4, 5, 0};
+    for (int i = 0; i < 8; ++i) EXPECT_EQ(scratch[i], expected[i]);
+    EXPECT_EQ(ring.try_pop(nstl::span<int>(scratch, 8)), 0);
+}
+
+TEST(SpscRingTest, NonTrivialElements) {
+    nstl::spsc_ring<std::string, 4> ring;
+    nstl::vector<std::string> in;
+    for (int i = 0; i < 3; ++i) in.push_back("Long string to defeat Small String Optimization " + std::to_string(i));
+
+    EXPECT_EQ(ring.try_push(nstl::span<const std::string>(in.data(), in.size())), 3);
+    std::string out;
+    ASSERT_TRUE(ring.try_pop(out));
+    EXPECT_EQ(out, in[0]);
+
+    std::string batch[4];
+    EXPECT_EQ(ring.try_pop(nstl::span<std::string>(batch, 4)), 2);
+    EXPECT_EQ(batch[1], in[2]);
+
+    ring.try_push("left in the ring for the destructor, long enough to allocate");
+}
+
+TEST(SpscRingTest, CrossThreadStreamKeepsOrder) {
+    constexpr int count = 200000;
+    auto ring = std::make_unique<nstl::spsc_ring<int, 1024>>();
+
+    std::thread producer([&] {
+        int batch[16];
+        for (int next = 0; next < count;) {
+            int n = std::min(16, count - next);
+            for (int i = 0; i < n; ++i) batch[i] = next + i;
+            size_t pushed = ring->try_push(nstl::span<const int>(batch, n));
+            next += static_cast<int>(pushed);
+            if (pushed == 0) std::this_thread::yield();
+        }
+    });
+
+    int expected = 0;
+    int value;
+    while (expected < count) {
+        if (ring->try_pop(value)) {
+            ASSERT_EQ(value, expected);
+            expected++;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    EXPECT_TRUE(ring->empty());
+}
@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <nstl/stable_vector.hpp>
+
+TEST(StableVectorTest, AppendKeepsPointersValid) {
+    nstl::stable_vector<int, 8> v;
+    v.push_back(0);
+    int* first = &v[0];
+    for (int i = 1; i < 1000; ++i) {
+        v.push_back(i);
+        ASSERT_EQ(&v[0], first);
+    }
+    EXPECT_EQ(*first, 0);
+    EXPECT_EQ(v.capacity(), 1000 / 8 * 8);
+    for (int i = 0; i < 1000; ++i) ASSERT_EQ(v[i], i);
+    EXPECT_THROW(v.at(1000), std::out_of_range);
+}
+
+TEST(StableVectorTest, ChunksAsSpans) {
+    nstl::stable_vector<int, 16> v;
+    for (int i = 0; i < 40; ++i) v.push_back(i);
+
+    ASSERT_EQ(v.chunk_count(), 3);
+    EXPECT_EQ(v.chunk(0).size(), 16);
+    EXPECT_EQ(v.chunk(2).size(), 8);
+    EXPECT_EQ(v.chunk(2)[0], 32);
+
+    int sum = 0;
+    for (size_t c = 0; c < v.chunk_count(); ++c) {
+        nstl::span<const int> chunk = std::as_const(v).chunk(c);
+        sum = std::accumulate(chunk.begin(), chunk.end(), sum);
+    }
+    EXPECT_EQ(sum, 39 * 40 / 2);
+}
+
+TEST(StableVectorTest, NonTrivialElementsAndSelfReference) {
+    nstl::stable_vector<std::string, 4> v;
+    for (int i = 0; i < 4; ++i) v.emplace_back("Long string to defeat Small String Optimization");
+    v.emplace_back(v[0]); // the new chunk leaves v[0] where it is
+    EXPECT_EQ(v[4], v[0]);
+
+    v.pop_back();
+    v.pop_back();
+    EXPECT_EQ(v.size(), 3);
+    EXPECT_EQ(v.chunk_count(), 1);
+    v.shrink_to_fit();
+    EXPECT_EQ(v.capacity(), 4);
+}
+
+TEST(StableVectorTest, CopyMoveAndReserve) {
+    nstl::stable_vector<int, 4> v;
+    v.reserve(10);
+    EXPECT_EQ(v.capacity(), 12);
+    for (int i = 0; i < 10; ++i) v.push_back(i);
+
+    nstl::stable_vector<int, 4> copy = v;
+    EXPECT_TRUE(std::equal(v.begin(), v.end(), copy.begin(), copy.end()));
+
+    nstl::stable_vector<int, 4> moved = std::move(v);
+    EXPECT_TRUE(v.empty());
+    EXPECT_EQ(moved[9], 9);
+
+    copy.clear();
+    EXPECT_EQ(copy.capacity(), 12);
+    copy = moved;
+    EXPECT_EQ(*std::max_element(copy.begin(), copy.end()), 9);
+}
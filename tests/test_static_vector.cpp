@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <numeric>
+#include <string>
+#include <type_traits>
+#include <nstl/static_vector.hpp>
+#include <nstl/span.hpp>
+
+static_assert(std::is_trivially_copyable_v<nstl::static_vector<int, 16>>);
+static_assert(std::is_trivially_destructible_v<nstl::static_vector<int, 16>>);
+static_assert(!std::is_trivially_copyable_v<nstl::static_vector<std::string, 4>>);
+static_assert(sizeof(nstl::static_vector<int, 16>) == sizeof(size_t) + 16 * sizeof(int));
+
+// Trivially copyable but not trivial: the default member initializer makes the
+// default constructor non-trivial.
+struct Level {
+    int price = 0;
+    int quantity = 0;
+};
+static_assert(std::is_trivially_copyable_v<Level> && !std::is_trivial_v<Level>);
+static_assert(std::is_trivially_copyable_v<nstl::static_vector<Level, 8>>);
+static_assert(std::is_trivially_destructible_v<nstl::static_vector<Level, 8>>);
+
+constexpr int constexpr_sum() {
+    nstl::static_vector<int, 8> v;
+    for (int i = 1; i <= 5; ++i) v.push_back(i);
+    v.pop_back();
+    nstl::static_vector<int, 8> copy = v;
+    int sum = 0;
+    for (int x : copy) sum += x;
+    return sum + static_cast<int>(v.try_push_back(0)) + v.at(4);
+}
+static_assert(constexpr_sum() == 11);
+
+TEST(StaticVectorTest, PushPopAndAccess) {
+    nstl::static_vector<int, 4> v;
+    EXPECT_TRUE(v.empty());
+    EXPECT_EQ(v.capacity(), 4);
+
+    v.push_back(1);
+    v.emplace_back(2);
+    v.push_back(3);
+    EXPECT_EQ(v.size(), 3);
+    EXPECT_EQ(v[1], 2);
+    EXPECT_EQ(v.at(2), 3);
+    EXPECT_THROW(v.at(3), std::out_of_range);
+
+    v.pop_back();
+    EXPECT_EQ(v.size(), 2);
+    v.clear();
+    EXPECT_THROW(v.pop_back(), std::out_of_range);
+}
+
+TEST(StaticVectorTest, OverflowPolicies) {
+    nstl::static_vector<int, 2> v;
+    v.push_back(1);
+    v.push_back(2);
+    EXPECT_TRUE(v.full());
+    EXPECT_THROW(v.push_back(3), std::length_error);
+    EXPECT_EQ(v.size(), 2);
+
+    EXPECT_FALSE(v.try_push_back(3));
+    EXPECT_EQ(v.try_emplace_back(3), nullptr);
+    v.pop_back();
+    int* slot = v.try_emplace_back(7);
+    ASSERT_NE(slot, nullptr);
+    EXPECT_EQ(*slot, 7);
+
+    nstl::static_vector<int, 2, nstl::overflow::assert_in_debug> unchecked;
+    EXPECT_TRUE(unchecked.try_push_back(1));
+#ifndef NDEBUG
+    unchecked.push_back(2);
+    EXPECT_DEATH(unchecked.push_back(3), "capacity exceeded");
+#endif
+}
+
+TEST(StaticVectorTest, NonTrivialElements) {
+    nstl::static_vector<std::string, 8> v;
+    for (int i = 0; i < 8; ++i) {
+        v.emplace_back("Long string to defeat Small String Optimization " + std::to_string(i));
+    }
+    nstl::static_vector<std::string, 8> copy = v;
+    nstl::static_vector<std::string, 8> moved = std::move(v);
+    EXPECT_EQ(copy[7], "Long string to defeat Small String Optimization 7");
+    EXPECT_EQ(moved[0], "Long string to defeat Small String Optimization 0");
+
+    copy.pop_back();
+    moved = copy;
+    EXPECT_EQ(moved.size(), 7);
+    copy = std::move(moved);
+    EXPECT_EQ(copy.size(), 7);
+}
+
+TEST(StaticVectorTest, IteratorsAndSpan) {
+    nstl::static_vector<int, 16> v;
+    for (int i = 0; i < 10; ++i) v.push_back(i);
+    EXPECT_EQ(std::accumulate(v.begin(), v.end(), 0), 45);
+
+    nstl::span<int> s = v;
+    EXPECT_EQ(s.size(), 10);
+    s[0] = 100;
+    EXPECT_EQ(v[0], 100);
+}
+
+TEST(StaticVectorTest, TriviallyCopyableNonTrivialElements) {
+    nstl::static_vector<Level, 8> book;
+    book.push_back({100, 5});
+    book.emplace_back();
+    nstl::static_vector<Level, 8> copy;
+    std::memcpy(static_cast<void*>(&copy), &book, sizeof(book));
+    ASSERT_EQ(copy.size(), 2u);
+    EXPECT_EQ(copy[0].price, 100);
+    EXPECT_EQ(copy[1].quantity, 0);
+}
@@ -87,6 +87,11 @@ TEST(UniquePtrBasic, SizeIsReasonable) {
     EXPECT_LE(sizeof(UP), 2 * sizeof(void*));
 }
 
+TEST(UniquePtrBasic, TriviallyRelocatable) {
+    EXPECT_TRUE(nstl::is_trivially_relocatable_v<nstl::unique_ptr<Tracked>>);
+    EXPECT_TRUE(nstl::is_trivially_relocatable_v<nstl::unique_ptr<int[]>>);
+}
+
 TEST(UniquePtrArray, BasicUsage) {
     nstl::unique_ptr<int[]> arr(new int[3]);
     arr[0] = 1;
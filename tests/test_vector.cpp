@@ -1,5 +1,9 @@
 #include <gtest/gtest.h>
 #include <nstl/vector.hpp>
+#include <list>
+#include <sstream>
+#include <iterator>
+#include <cstring>
 
 // Test 1: Does it behave like a vector?
 TEST(VectorTest, PushBackAndAccess) {
@@ -98,4 +102,439 @@ TEST(EmplaceTest, SelfReferenceResize) {
     for (size_t i = 0; i < v.size(); ++i) {
         ASSERT_EQ(v[i], "Initial String") << "Failed at index " << i;
     }
-}
\ No newline at end of file
+}
+
+// Stateful allocator that counts the blocks it hands out. Each instance has its
+// own id so the propagation rules can be observed.
+template <typename T, bool Propagate>
+struct CountingAlloc {
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::bool_constant<Propagate>;
+    using propagate_on_container_move_assignment = std::bool_constant<Propagate>;
+    using propagate_on_container_swap = std::bool_constant<Propagate>;
+
+    int id = 0;
+    int* live = nullptr;
+
+    CountingAlloc() = default;
+    CountingAlloc(int i, int* l) : id(i), live(l) {}
+    template <typename U>
+    CountingAlloc(const CountingAlloc<U, Propagate>& o) : id(o.id), live(o.live) {}
+
+    T* allocate(size_t n) {
+        ++*live;
+        return std::allocator<T>{}.allocate(n);
+    }
+    void deallocate(T* p, size_t n) {
+        --*live;
+        std::allocator<T>{}.deallocate(p, n);
+    }
+    CountingAlloc select_on_container_copy_construction() const { return CountingAlloc(id + 100, live); }
+
+    template <typename U>
+    bool operator==(const CountingAlloc<U, Propagate>& o) const { return id == o.id; }
+};
+
+// Test 8: Storage comes from the supplied allocator and is returned to it
+TEST(AllocatorTest, UsesSuppliedAllocator) {
+    int live = 0;
+    {
+        nstl::vector<int, CountingAlloc<int, false>> v(CountingAlloc<int, false>(1, &live));
+        for (int i = 0; i < 100; ++i) v.push_back(i);
+        EXPECT_EQ(live, 1);
+        EXPECT_EQ(v[99], 99);
+    }
+    EXPECT_EQ(live, 0);
+}
+
+// Test 9: Copy construction asks the allocator which instance to use
+TEST(AllocatorTest, CopySelectsAllocator) {
+    int live = 0;
+    nstl::vector<int, CountingAlloc<int, false>> v1(CountingAlloc<int, false>(1, &live));
+    v1.push_back(5);
+    auto v2 = v1;
+    EXPECT_EQ(v2.get_allocator().id, 101);
+    EXPECT_EQ(v2[0], 5);
+}
+
+// Test 10: Move assignment between unequal, non-propagating allocators moves the elements
+TEST(AllocatorTest, MoveAssignUnequalMovesElements) {
+    int live = 0;
+    using Alloc = CountingAlloc<std::string, false>;
+    nstl::vector<std::string, Alloc> a(Alloc(1, &live));
+    nstl::vector<std::string, Alloc> b(Alloc(2, &live));
+    b.push_back("Long string to defeat Small String Optimization");
+
+    a = std::move(b);
+    EXPECT_EQ(a.get_allocator().id, 1);
+    EXPECT_EQ(b.get_allocator().id, 2);
+    ASSERT_EQ(a.size(), 1);
+    EXPECT_EQ(a[0], "Long string to defeat Small String Optimization");
+    EXPECT_TRUE(b.empty());
+}
+
+// Test 11: Propagating allocators follow the storage on move assignment and swap
+TEST(AllocatorTest, PropagatingAllocatorFollowsStorage) {
+    int live = 0;
+    using Alloc = CountingAlloc<int, true>;
+    nstl::vector<int, Alloc> a(Alloc(1, &live));
+    nstl::vector<int, Alloc> b(Alloc(2, &live));
+    b.push_back(7);
+
+    a = std::move(b);
+    EXPECT_EQ(a.get_allocator().id, 2);
+    EXPECT_EQ(a[0], 7);
+
+    nstl::vector<int, Alloc> c(Alloc(3, &live));
+    swap(a, c);
+    EXPECT_EQ(a.get_allocator().id, 3);
+    EXPECT_EQ(c.get_allocator().id, 2);
+    EXPECT_EQ(c[0], 7);
+    EXPECT_EQ(live, 1);
+}
+
+// Test 12: A pmr vector backed by an arena never falls back to the upstream resource
+TEST(AllocatorTest, PmrVectorStaysInArena) {
+    std::byte buffer[4096];
+    std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+
+    nstl::pmr::vector<int> v(&arena);
+    for (int i = 0; i < 200; ++i) v.push_back(i);
+    EXPECT_EQ(v.size(), 200);
+    EXPECT_EQ(v[199], 199);
+    EXPECT_EQ(v.get_allocator().resource(), &arena);
+
+    nstl::pmr::vector<int> copy = v;
+    EXPECT_EQ(copy.get_allocator().resource(), std::pmr::get_default_resource());
+    EXPECT_EQ(copy[199], 199);
+}
+
+// Record that opts into trivial relocation; its move constructor must not run on growth.
+struct Relocatable {
+    static int moves;
+    std::unique_ptr<int> p;
+    explicit Relocatable(int v) : p(std::make_unique<int>(v)) {}
+    Relocatable(Relocatable&& o) noexcept : p(std::move(o.p)) { ++moves; }
+};
+int Relocatable::moves = 0;
+
+template <>
+struct nstl::is_trivially_relocatable<Relocatable> : std::true_type {};
+
+// Test 13: Growth relocates opted-in types with memcpy instead of moving them
+TEST(RelocationTest, GrowthSkipsMoveConstructor) {
+    Relocatable::moves = 0;
+    nstl::vector<Relocatable> v;
+    for (int i = 0; i < 100; ++i) v.emplace_back(i);
+
+    EXPECT_EQ(Relocatable::moves, 0);
+    for (int i = 0; i < 100; ++i) ASSERT_EQ(*v[i].p, i);
+}
+
+// Test 14: Vectors of vectors and unique_ptrs are relocatable themselves
+TEST(RelocationTest, NestedContainersRelocate) {
+    static_assert(nstl::is_trivially_relocatable_v<nstl::vector<std::string>>);
+
+    nstl::vector<nstl::vector<std::string>> outer;
+    for (int i = 0; i < 20; ++i) {
+        outer.emplace_back();
+        outer[i].push_back("Long string to defeat Small String Optimization " + std::to_string(i));
+    }
+    for (int i = 0; i < 20; ++i) {
+        ASSERT_EQ(outer[i][0], "Long string to defeat Small String Optimization " + std::to_string(i));
+    }
+}
+
+// Test 15: reserve_hot keeps the elements and leaves the requested capacity behind
+TEST(ReserveHotTest, PrefaultsWithoutTouchingElements) {
+    nstl::vector<int> v;
+    for (int i = 0; i < 10; ++i) v.push_back(i);
+
+    EXPECT_TRUE(v.reserve_hot(1 << 18));
+    EXPECT_GE(v.capacity(), 1u << 18);
+    ASSERT_EQ(v.size(), 10);
+    for (int i = 0; i < 10; ++i) EXPECT_EQ(v[i], i);
+
+    // Locking depends on RLIMIT_MEMLOCK, so only the vector's state is checked here.
+    v.reserve_hot(1 << 19, nstl::reserve_flags::prefault | nstl::reserve_flags::lock | nstl::reserve_flags::huge_pages);
+    EXPECT_GE(v.capacity(), 1u << 19);
+    EXPECT_EQ(v[9], 9);
+    for (int i = 10; i < (1 << 19); ++i) v.push_back(i);
+    EXPECT_EQ(v[(1 << 19) - 1], (1 << 19) - 1);
+}
+
+// Test 16: Growth policies pick the next capacity
+TEST(GrowthPolicyTest, PolicySequences) {
+    static_assert(nstl::growth::doubling::next_capacity(0, 4) == 8);
+    static_assert(nstl::growth::doubling::next_capacity(8, 4) == 16);
+    static_assert(nstl::growth::one_and_half::next_capacity(8, 4) == 12);
+    static_assert(nstl::growth::page_rounded<>::next_capacity(0, 4) == 1024);
+    static_assert(nstl::growth::page_rounded<>::next_capacity(1024, 4) == 2048);
+    static_assert(nstl::growth::page_rounded<>::next_capacity(0, 3000) == 8);
+    static_assert(nstl::growth::page_rounded<>::next_capacity(8, 3000) == 16);
+    static_assert(nstl::growth::huge_page_rounded<>::next_capacity(0, 8) == (2 << 20) / 8);
+    static_assert(nstl::growth::size_class<>::round_bytes(129) == 160);
+    static_assert(nstl::growth::size_class<>::round_bytes(257) == 320);
+    static_assert(nstl::growth::size_class<>::next_capacity(8, 36) == 17);
+
+    // 8 -> 12 -> 18 -> 27 -> 40
+    nstl::vector<int, std::allocator<int>, nstl::growth::one_and_half> v;
+    for (int i = 0; i < 40; ++i) v.push_back(i);
+    EXPECT_EQ(v.capacity(), 40);
+    EXPECT_EQ(v[39], 39);
+}
+
+// Test 17: Growth policies apply to emplace_back as well as push_back
+TEST(GrowthPolicyTest, PageRoundedVector) {
+    nstl::vector<char, std::allocator<char>, nstl::growth::page_rounded<>> v;
+    v.emplace_back('a');
+    EXPECT_EQ(v.capacity(), 4096);
+    for (int i = 0; i < 4096; ++i) v.push_back('b');
+    EXPECT_EQ(v.capacity(), 2 * 4096);
+}
+
+// Test 18: append copies a whole block with a single growth
+TEST(BulkInsertTest, AppendSpanAndRange) {
+    int raw[100];
+    for (int i = 0; i < 100; ++i) raw[i] = i;
+
+    nstl::vector<int> v;
+    v.push_back(-1);
+    v.append(nstl::span<const int>(raw, 100));
+    EXPECT_EQ(v.size(), 101);
+    EXPECT_EQ(v.capacity(), 101);
+    EXPECT_EQ(v[100], 99);
+
+    std::list<std::string> words = {"a", "b", "c"};
+    nstl::vector<std::string> s;
+    s.append_range(words);
+    ASSERT_EQ(s.size(), 3);
+    EXPECT_EQ(s[2], "c");
+}
+
+// Test 19: appending a vector to itself survives the reallocation
+TEST(BulkInsertTest, SelfAppend) {
+    nstl::vector<std::string> v;
+    for (int i = 0; i < 8; ++i) v.push_back("Long string to defeat Small String Optimization " + std::to_string(i));
+    v.append(v);
+    ASSERT_EQ(v.size(), 16);
+    for (int i = 0; i < 16; ++i) {
+        ASSERT_EQ(v[i], "Long string to defeat Small String Optimization " + std::to_string(i % 8));
+    }
+}
+
+// Test 20: push_back of an element of the vector itself, at full capacity
+TEST(BulkInsertTest, SelfPushBack) {
+    nstl::vector<std::string> v;
+    v.push_back("Long string to defeat Small String Optimization");
+    for (int i = 0; i < 20; ++i) {
+        const std::string& first = v[0];
+        v.push_back(first);
+    }
+    for (size_t i = 0; i < v.size(); ++i) ASSERT_EQ(v[i], v[0]) << i;
+    v.shrink_to_fit();
+    v.push_back(std::move(v[v.size() - 1]));
+    EXPECT_EQ(v[v.size() - 1], "Long string to defeat Small String Optimization");
+
+    // realloc may move the block out from under the argument.
+    nstl::vector<long, nstl::malloc_allocator<long>> grown;
+    grown.push_back(7);
+    for (int i = 0; i < 5000; ++i) grown.push_back(grown[grown.size() / 2]);
+    for (size_t i = 0; i < grown.size(); ++i) ASSERT_EQ(grown[i], 7) << i;
+}
+
+// Test 21: insert a range in the middle, with and without growth
+TEST(BulkInsertTest, InsertRange) {
+    nstl::vector<std::string> v;
+    for (int i = 0; i < 4; ++i) v.push_back(std::to_string(i));
+    std::string extra[] = {"x", "y"};
+
+    auto it = v.insert(v.begin() + 1, std::begin(extra), std::end(extra));
+    EXPECT_EQ(*it, "x");
+    std::vector<std::string> expected = {"0", "x", "y", "1", "2", "3"};
+    ASSERT_EQ(v.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) EXPECT_EQ(v[i], expected[i]);
+
+    nstl::vector<int> ints;
+    for (int i = 0; i < 8; ++i) ints.push_back(i);
+    int more[] = {100, 101, 102};
+    ints.insert(ints.begin(), more, more + 3);
+    EXPECT_EQ(ints.size(), 11);
+    EXPECT_EQ(ints[0], 100);
+    EXPECT_EQ(ints[3], 0);
+    EXPECT_EQ(ints[10], 7);
+
+    std::istringstream input("7 8 9");
+    ints.insert(ints.begin() + 1, std::istream_iterator<int>(input), std::istream_iterator<int>());
+    EXPECT_EQ(ints.size(), 14);
+    EXPECT_EQ(ints[1], 7);
+    EXPECT_EQ(ints[3], 9);
+    EXPECT_EQ(ints[4], 101);
+}
+
+// Test 22: assign replaces the contents
+TEST(BulkInsertTest, Assign) {
+    nstl::vector<int> v;
+    for (int i = 0; i < 10; ++i) v.push_back(i);
+    std::vector<int> src = {5, 6, 7};
+    v.assign(src.begin(), src.end());
+    ASSERT_EQ(v.size(), 3);
+    EXPECT_EQ(v[0], 5);
+
+    v.assign_range(std::vector<int>{1, 2});
+    ASSERT_EQ(v.size(), 2);
+    EXPECT_EQ(v[1], 2);
+}
+
+// Test 23: public resize and resize_for_overwrite
+TEST(BulkInsertTest, Resize) {
+    nstl::vector<int> v;
+    v.resize(5);
+    ASSERT_EQ(v.size(), 5);
+    for (int x : v) EXPECT_EQ(x, 0);
+
+    v.resize(7, 42);
+    EXPECT_EQ(v[6], 42);
+    v.resize(2);
+    EXPECT_EQ(v.size(), 2);
+
+    v.resize_for_overwrite(1000);
+    ASSERT_EQ(v.size(), 1000);
+    std::memset(v.data() + 2, 0xff, 998 * sizeof(int));
+    EXPECT_EQ(v[999], -1);
+
+    nstl::vector<std::string> s;
+    s.resize_for_overwrite(3);
+    EXPECT_EQ(s[2], "");
+    s.resize(5, s[0] = "self");
+    EXPECT_EQ(s[4], "self");
+}
+
+// Test 24: erase single elements and ranges, keeping order
+TEST(EraseTest, EraseKeepsOrder) {
+    nstl::vector<std::string> v;
+    for (int i = 0; i < 6; ++i) v.push_back("Long string to defeat Small String Optimization " + std::to_string(i));
+
+    auto it = v.erase(v.begin() + 1);
+    EXPECT_EQ(*it, "Long string to defeat Small String Optimization 2");
+    it = v.erase(v.begin() + 1, v.begin() + 3);
+    EXPECT_EQ(*it, "Long string to defeat Small String Optimization 4");
+    ASSERT_EQ(v.size(), 3);
+    EXPECT_EQ(v[0], "Long string to defeat Small String Optimization 0");
+    EXPECT_EQ(v[2], "Long string to defeat Small String Optimization 5");
+
+    it = v.erase(v.end() - 1);
+    EXPECT_EQ(it, v.end());
+    v.clear();
+    EXPECT_TRUE(v.empty());
+}
+
+// Test 25: unordered_erase swaps the last element into the hole
+TEST(EraseTest, UnorderedErase) {
+    nstl::vector<int> v;
+    for (int i = 0; i < 5; ++i) v.push_back(i);
+    v.unordered_erase(v.begin() + 1);
+    ASSERT_EQ(v.size(), 4);
+    EXPECT_EQ(v[1], 4);
+    v.unordered_erase(v.end() - 1);
+    EXPECT_EQ(v.size(), 3);
+    EXPECT_EQ(v[2], 2);
+}
+
+// Test 26: erase_if compacts in one pass, for trivial and relocatable types alike
+TEST(EraseTest, EraseIf) {
+    nstl::vector<int> v;
+    for (int i = 0; i < 100; ++i) v.push_back(i);
+    EXPECT_EQ(nstl::erase_if(v, [](int x) { return x % 3 == 0; }), 34);
+    ASSERT_EQ(v.size(), 66);
+    EXPECT_EQ(v[0], 1);
+    EXPECT_EQ(v[65], 98);
+    EXPECT_EQ(nstl::erase(v, 98), 1);
+
+    nstl::vector<Relocatable> r;
+    for (int i = 0; i < 10; ++i) r.emplace_back(i);
+    Relocatable::moves = 0;
+    EXPECT_EQ(nstl::erase_if(r, [](const Relocatable& x) { return *x.p < 5; }), 5);
+    EXPECT_EQ(Relocatable::moves, 0);
+    for (int i = 0; i < 5; ++i) EXPECT_EQ(*r[i].p, i + 5);
+
+    nstl::vector<std::string> s;
+    for (int i = 0; i < 10; ++i) s.push_back(std::to_string(i));
+    EXPECT_EQ(nstl::erase_if(s, [](const std::string& x) { return x < "5"; }), 5);
+    EXPECT_EQ(s[0], "5");
+}
+
+// Test 27: single-element insert and emplace, including from an element of the vector
+TEST(EraseTest, InsertSingle) {
+    nstl::vector<std::string> v;
+    for (int i = 0; i < 8; ++i) v.push_back("Long string to defeat Small String Optimization " + std::to_string(i));
+
+    v.insert(v.begin(), v[7]); // grows while the argument lives in the old block
+    ASSERT_EQ(v.size(), 9);
+    EXPECT_EQ(v[0], "Long string to defeat Small String Optimization 7");
+    EXPECT_EQ(v[1], "Long string to defeat Small String Optimization 0");
+
+    auto it = v.emplace(v.begin() + 2, 3, 'z');
+    EXPECT_EQ(*it, "zzz");
+    EXPECT_EQ(v[3], "Long string to defeat Small String Optimization 1");
+    v.insert(v.end(), std::string("end"));
+    EXPECT_EQ(v[10], "end");
+}
+
+namespace {
+// Copies and moves throw once the shared budget runs out.
+struct Fragile {
+    static inline int budget = -1;
+    static inline int live = 0;
+    int value;
+    explicit Fragile(int v) : value(v) { ++live; }
+    Fragile(const Fragile& other) : value(other.value) { spend(); ++live; }
+    Fragile(Fragile&& other) : value(other.value) { spend(); ++live; }
+    Fragile& operator=(const Fragile&) = default;
+    ~Fragile() { --live; }
+    static void spend() {
+        if (budget == 0) throw std::runtime_error("copy failed");
+        if (budget > 0) --budget;
+    }
+};
+}
+
+// Test 28: a throwing allocation or element copy leaves the vector as it was
+TEST(ExceptionSafetyTest, GrowthAndRangeInsert) {
+    {
+        nstl::vector<Fragile> v;
+        for (int i = 0; i < 4; ++i) v.emplace_back(i);
+        v.shrink_to_fit();
+        Fragile::budget = 2;
+        EXPECT_THROW(v.emplace_back(4), std::runtime_error); // fails while growing
+        Fragile::budget = -1;
+        ASSERT_EQ(v.size(), 4);
+        for (int i = 0; i < 4; ++i) EXPECT_EQ(v[i].value, i);
+        EXPECT_EQ(Fragile::live, 4);
+
+        v.reserve(16);
+        Fragile extra[] = {Fragile(10), Fragile(11), Fragile(12)};
+        Fragile::budget = 1;
+        EXPECT_THROW(v.insert(v.begin() + 1, std::begin(extra), std::end(extra)), std::runtime_error);
+        Fragile::budget = -1;
+        ASSERT_EQ(v.size(), 4);
+        for (int i = 0; i < 4; ++i) EXPECT_EQ(v[i].value, i);
+        EXPECT_EQ(Fragile::live, 7);
+    }
+    EXPECT_EQ(Fragile::live, 0);
+
+    // bad_alloc propagates out of the public growth paths instead of terminating.
+    nstl::pmr::vector<int> empty{std::pmr::polymorphic_allocator<int>(std::pmr::null_memory_resource())};
+    EXPECT_THROW(empty.push_back(1), std::bad_alloc);
+    EXPECT_THROW(empty.resize(10), std::bad_alloc);
+    int values[] = {1, 2, 3};
+    EXPECT_THROW(empty.insert(empty.begin(), values, values + 3), std::bad_alloc);
+    EXPECT_TRUE(empty.empty());
+
+    // Contiguous trivially copyable ranges take the memcpy path.
+    nstl::vector<int> ints;
+    ints.push_back(0);
+    ints.push_back(4);
+    ints.insert(ints.begin() + 1, values, values + 3);
+    for (int i = 0; i < 5; ++i) EXPECT_EQ(ints[i], i);
+}